@@ -3,12 +3,31 @@
 
 #include "chip.h"
 #include "util.h"
+#include "can_timing.h"
 #include <string.h>
 
 
 // -------------------------------------------------------------
 // Configuration Macros
 
+#define BOARD_FLASH_SECTOR_SIZE 4096
+#define BOARD_FLASH_PAGE_SIZE 256 				// IAP copies to flash in multiples of this
+
+// Flash as the core reads it, mapped from address 0. The host simulation's
+// chip.h points this at its flash image instead.
+#ifndef BOARD_FLASH_ADDRESS
+#define BOARD_FLASH_ADDRESS(addr) ((const uint8_t *)(addr))
+#endif
+
+// C_CAN transmission requests, bit n set while message object n waits for
+// the bus. The ROM API does not report these, so they are read straight from
+// CANTXREQ1 and CANTXREQ2. The host simulation's chip.h supplies its own.
+#ifndef BOARD_CCAN_TXREQ
+#define BOARD_CCAN_TXREQ1 0x40050100
+#define BOARD_CCAN_TXREQ2 0x40050104
+#define BOARD_CCAN_TXREQ() ((*(__I uint32_t *)BOARD_CCAN_TXREQ1 & 0xFFFF) | \
+	(*(__I uint32_t *)BOARD_CCAN_TXREQ2 << 16))
+#endif
 
 // -------------------------------------------------------------
 // Pin Descriptions
@@ -27,6 +46,15 @@
 #define UART_TX_PIN 7
 #define UART_TX_IOCON IOCON_PIO1_7
 
+#define LTC6804_CS_PORT 2
+#define LTC6804_CS_PIN 0
+
+#define MCP2515_CS_PORT 0
+#define MCP2515_CS_PIN 7
+
+#define MCP2515_INT_PORT 2
+#define MCP2515_INT_PIN 6
+
 // -------------------------------------------------------------
 // Computed Macros
 
@@ -36,6 +64,10 @@
 #define UART_RX UART_RX_PORT, UART_RX_PIN
 #define UART_TX UART_TX_PORT, UART_TX_PIN
 
+#define LTC6804_CS LTC6804_CS_PORT, LTC6804_CS_PIN
+#define MCP2515_CS MCP2515_CS_PORT, MCP2515_CS_PIN
+#define MCP2515_INT MCP2515_INT_PORT, MCP2515_INT_PIN
+
 #define Board_LED_On(led) {Chip_GPIO_SetPinState(LPC_GPIO, led, true);}
 #define Board_LED_Off(led) {Chip_GPIO_SetPinState(LPC_GPIO, led, false);}
 
@@ -75,6 +107,40 @@ static uint8_t SSP_Rx_Buf[SSP_BUFFER_SIZE];
  */
 int8_t Board_SysTick_Init(void);
 
+/**
+ * Core clock cycles since the SysTick timer started, wraps every 2^32 cycles
+ * (89 s at 48 MHz)
+ */
+uint32_t Board_CycleCount(void);
+
+/**
+ * Microseconds since the SysTick timer started, wraps every 71 minutes.
+ * Safe in handlers that hold off the SysTick interrupt.
+ */
+uint32_t Board_Micros(void);
+
+/**
+ * Reset cause bits of SYSRSTSTAT, cleared so the next boot reports its own
+ */
+uint32_t Board_ResetCause(void);
+
+/**
+ * Erase one 4 KB flash sector through IAP. Interrupts are held off for the
+ * whole erase, around 100 ms.
+ *
+ * @return true if the IAP calls succeeded
+ */
+bool Board_Flash_Erase(uint8_t sector);
+
+/**
+ * Program one 256 byte flash page through IAP, the sector must be erased
+ *
+ * @param addr page aligned flash address
+ * @param page word aligned source in RAM
+ * @return true if the IAP calls succeeded
+ */
+bool Board_Flash_Program(uint32_t addr, const uint32_t *page);
+
 void Board_LEDs_Init(void);
 
 void Board_UART_Init(uint32_t baudrate);
@@ -132,7 +198,15 @@ void Board_UART_SendBlocking(const void *data, uint8_t num_bytes);
  */
 int8_t Board_UART_Read(void *data, uint8_t num_bytes);
 
-void Board_CAN_Init(uint32_t baudrate, void (*rx_callback)(uint8_t), void (*tx_callback)(uint8_t), void (*error_callback)(uint32_t));
+/**
+ * Initialize the C_CAN peripheral through the ROM API
+ *
+ * @param baudrate bit rate (bit/s)
+ * @param timing filled with the bit timing chosen by CANTiming_Solve
+ * @return true if error, no timing reaches the bit rate and CAN is left off
+ */
+int8_t Board_CAN_Init(uint32_t baudrate, void (*rx_callback)(uint8_t), void (*tx_callback)(uint8_t), void (*error_callback)(uint32_t),
+	CAN_TIMING_T *timing);
 
 
 #endif
@@ -0,0 +1,106 @@
+#ifndef __CAN_CAPTURE_H_
+#define __CAN_CAPTURE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//--------------------------------------------
+// Pre/post-trigger capture of raw car bus frames. The receive ISR copies
+// every frame into a ring of the last CAN_CAPTURE_DEPTH frames; a trigger
+// lets CAN_CAPTURE_POST more frames in and then freezes the ring. While
+// frozen the ISR drops frames on a single compare instead of waiting. The
+// main loop then takes the capture one CANCapture_Pack() record at a time,
+// a few per pass so the receive ring keeps draining, and the last record
+// re-arms the ring. On the UART each record is introduced by a zero byte,
+// which never starts a text line, so other output may land between records.
+//
+// Only the ISR writes the ring and its head, only the main loop reads them
+// while frozen, and the state is handed over with single stores, so no
+// interrupt masking is needed. Trigger from either context.
+//
+// Stream format, little endian:
+//   header: 'C' 'P' version reason count pre
+//   frame:  uint32_t us, uint16_t id | dlc << 11, dlc data bytes
+// pre is the number of frames before the trigger.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Configuration Macros
+
+#define CAN_CAPTURE_DEPTH 32 					// Frames kept, power of 2, 16 bytes each
+#define CAN_CAPTURE_POST 8 						// Frames after the trigger, less than the depth
+
+// -------------------------------------------------------------
+// Computed Macros
+
+#define CAN_CAPTURE_VERSION 1
+#define CAN_CAPTURE_HEADER_SIZE 6
+#define CAN_CAPTURE_RECORD_MAX 14 				// Largest header or frame record
+
+// -------------------------------------------------------------
+// Types
+
+typedef enum {
+	CAN_CAPTURE_ARMED,
+	CAN_CAPTURE_TRIGGERED,
+	CAN_CAPTURE_FROZEN
+} CAN_CAPTURE_STATE_T;
+
+typedef enum {
+	CAN_CAPTURE_NONE,
+	CAN_CAPTURE_FAULT,
+	CAN_CAPTURE_CAN_ERROR,
+	CAN_CAPTURE_COMMAND
+} CAN_CAPTURE_REASON_T;
+
+typedef struct _CAN_CAPTURE_FRAME_T_ {
+	uint32_t us;
+	uint16_t id;
+	uint8_t dlc;
+	uint8_t data[8];
+} CAN_CAPTURE_FRAME_T;
+
+// -------------------------------------------------------------
+// Public Functions
+
+/**
+ * Empty the ring and start recording
+ */
+void CANCapture_Arm(void);
+
+/**
+ * Record a received frame. Call from the receive ISR.
+ *
+ * @param us receive time (us)
+ */
+void CANCapture_Record(uint16_t id, const uint8_t *data, uint8_t dlc, uint32_t us);
+
+/**
+ * Freeze the ring after CAN_CAPTURE_POST more frames. Ignored unless armed,
+ * so the first trigger of a burst owns the capture.
+ *
+ * @param reason CAN_CAPTURE_REASON_T stored in the header
+ */
+void CANCapture_Trigger(uint8_t reason);
+
+CAN_CAPTURE_STATE_T CANCapture_GetState(void);
+
+/**
+ * Encode the next record of a frozen capture. The header comes first, the
+ * frames follow oldest first, and the ring re-arms after the last one.
+ *
+ * @param buf at least CAN_CAPTURE_RECORD_MAX bytes
+ * @return bytes written, 0 when there is no frozen capture
+ */
+uint8_t CANCapture_Pack(uint8_t *buf);
+
+/**
+ * Encode one frame record in the stream format, for other streams of
+ * frames to share it
+ *
+ * @param buf at least CAN_CAPTURE_RECORD_MAX bytes
+ * @return bytes written
+ */
+uint8_t CANCapture_PackFrame(uint8_t *buf, uint16_t id, const uint8_t *data, uint8_t dlc, uint32_t us);
+
+#endif
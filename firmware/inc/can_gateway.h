@@ -0,0 +1,132 @@
+#ifndef __CAN_GATEWAY_H_
+#define __CAN_GATEWAY_H_
+
+#include "chip.h"
+#include "can_timing.h"
+
+//--------------------------------------------
+// Bridges the on-chip C_CAN and an MCP2515 on SSP0 through a const routing
+// table. Frames are forwarded from interrupt context: C_CAN frames from the
+// CAN receive callback, MCP2515 frames from the INT pin interrupt using the
+// mcp2515_fast instructions. Both interrupts run at the same priority so SPI
+// and ROM calls never nest.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Configuration Macros
+
+#define GATEWAY_MAX_ROUTES 16
+#define GATEWAY_CCAN_TX_MSGOBJ 28 				// First of the C_CAN message objects used to forward
+#define GATEWAY_CCAN_TX_COUNT 4
+#define GATEWAY_IRQ_PRIORITY 1
+#define GATEWAY_MCP_RESERVED_MIN 0x200 			// A123 module responses, MBB_STD to MBB_EXT3
+#define GATEWAY_MCP_RESERVED_MAX 0x5FF
+
+// Route directions
+#define GATEWAY_CCAN_TO_MCP 0x1
+#define GATEWAY_MCP_TO_CCAN 0x2
+#define GATEWAY_BOTH (GATEWAY_CCAN_TO_MCP | GATEWAY_MCP_TO_CCAN)
+
+// Gateway_Init errors
+#define GATEWAY_ERR_TIMING 1 					// No MCP2515 bit timing reaches the bit rate
+#define GATEWAY_ERR_VERIFY 2 					// CNF1 read back wrong, MCP2515 not answering
+#define GATEWAY_ERR_ROUTE 3 					// A route transmits into the second bus's reserved IDs
+
+// -------------------------------------------------------------
+// Types
+
+/**
+ * One routing table entry. The first entry whose range and direction match
+ * a frame decides its fate, frames matching no entry are not forwarded.
+ */
+typedef struct _GATEWAY_ROUTE_T_ {
+	uint16_t id_min;
+	uint16_t id_max;
+	uint8_t dir; 								// GATEWAY_CCAN_TO_MCP, GATEWAY_MCP_TO_CCAN or GATEWAY_BOTH
+	uint16_t min_interval_ms; 					// Rate limit, 0 forwards every frame
+	int16_t id_offset; 							// Added to the ID on the far bus, 0 keeps it
+} GATEWAY_ROUTE_T;
+
+typedef struct _GATEWAY_STATS_T_ {
+	uint32_t forwarded;
+	uint32_t rate_dropped; 						// Inside the route's min_interval_ms
+	uint32_t busy_dropped; 						// No free transmit buffer or message object on the far bus
+	uint32_t latency_max; 						// Core clock cycles from receive to transmit request
+	uint32_t latency_sum;
+} GATEWAY_STATS_T;
+
+// -------------------------------------------------------------
+// Public Functions
+
+/**
+ * Bring up the MCP2515 and its INT pin interrupt. SSP0 must already be
+ * configured. A C_CAN to MCP2515 route that can put an ID between
+ * GATEWAY_MCP_RESERVED_MIN and GATEWAY_MCP_RESERVED_MAX on the second bus
+ * rejects the whole table, such frames would pass for module responses.
+ *
+ * @param routes routing table, must stay valid
+ * @param num_routes entries in routes, clamped to GATEWAY_MAX_ROUTES
+ * @param baud_kHz second bus bit rate
+ * @param osc_MHz MCP2515 oscillator
+ * @param cs_gpio, cs_pin MCP2515 chip select
+ * @param int_gpio, int_pin MCP2515 INT output
+ * @return 0 on success, GATEWAY_ERR_* otherwise
+ */
+uint8_t Gateway_Init(const GATEWAY_ROUTE_T *routes, uint8_t num_routes, uint32_t baud_kHz, uint32_t osc_MHz,
+	uint8_t cs_gpio, uint8_t cs_pin, uint8_t int_gpio, uint8_t int_pin);
+
+/**
+ * Route a frame received on C_CAN. Call from the C_CAN receive callback.
+ */
+void Gateway_FromCCAN(const CCAN_MSG_OBJ_T *msg, uint32_t msTicks);
+
+/**
+ * Drain and route the MCP2515 receive buffers. Call from the INT pin's
+ * port interrupt handler.
+ */
+void Gateway_MCP2515_IRQHandler(uint32_t msTicks);
+
+/**
+ * Transmit a locally generated frame on the second bus. Call from thread
+ * context only, the gateway interrupts are held off for the transfer.
+ *
+ * @return false if all MCP2515 transmit buffers are pending
+ */
+bool Gateway_SendMCP2515(const CCAN_MSG_OBJ_T *msg);
+
+/**
+ * Transmit a locally generated frame on the C_CAN. Call from thread context
+ * only, the gateway interrupts also transmit through the ROM driver. Works
+ * whether or not Gateway_Init brought the MCP2515 up.
+ *
+ * @param msg frame, msgobj must be outside the gateway's forwarding objects
+ * @return false if msgobj is still waiting to send its previous frame
+ */
+bool Gateway_SendCCAN(CCAN_MSG_OBJ_T *msg);
+
+/**
+ * Hand MCP2515 frames that match no route to the application, e.g. module
+ * responses on the second bus. Called from the INT pin interrupt.
+ *
+ * @param local receiver, NULL to drop them
+ */
+void Gateway_SetLocal(void (*local)(const CCAN_MSG_OBJ_T *msg));
+
+/**
+ * @return MCP2515 bit timing chosen by Gateway_Init
+ */
+const CAN_TIMING_T *Gateway_GetTiming(void);
+
+/**
+ * @return statistics for one route, NULL if out of range
+ */
+const GATEWAY_STATS_T *Gateway_GetStats(uint8_t route);
+
+/**
+ * @return frames that matched no route, per source bus
+ */
+uint32_t Gateway_GetUnrouted(uint8_t dir);
+
+void Gateway_ResetStats(void);
+
+#endif
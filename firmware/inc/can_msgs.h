@@ -0,0 +1,511 @@
+// Generated by tools/dbcgen.py from can/bcm.dbc, do not edit.
+// Run make codegen after changing the description.
+
+#ifndef __CAN_MSGS_H_
+#define __CAN_MSGS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//--------------------------------------------
+// Decoders and encoders for the messages in bcm.dbc. Structs hold raw signal
+// values; the descriptor tables give names, units and the factor and offset
+// to scale them for telemetry.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Message IDs and lengths
+
+#define CAN_THROTTLE 0x301
+#define CAN_THROTTLE_DLC 2
+#define CAN_POWER_STATUS 0x305
+#define CAN_POWER_STATUS_DLC 1
+#define CAN_DRIVER_INPUT 0x505
+#define CAN_DRIVER_INPUT_DLC 4
+#define CAN_CONTACTORS 0x6F7
+#define CAN_CONTACTORS_DLC 2
+#define CAN_CELL_VOLTAGES 0x6F8
+#define CAN_CELL_VOLTAGES_DLC 8
+#define CAN_CELL_TEMPS 0x6F9
+#define CAN_CELL_TEMPS_DLC 6
+#define CAN_BATTERY 0x6FA
+#define CAN_BATTERY_DLC 4
+#define CAN_VELOCITY1 0x703
+#define CAN_VELOCITY1_DLC 2
+#define CAN_VELOCITY2 0x704
+#define CAN_VELOCITY2_DLC 2
+#define CAN_MOTOR_STATUS 0x705
+#define CAN_MOTOR_STATUS_DLC 8
+#define CAN_NLG5_STATUS 0x610
+#define CAN_NLG5_STATUS_DLC 4
+#define CAN_NLG5_ACT_I 0x611
+#define CAN_NLG5_ACT_I_DLC 8
+#define CAN_NLG5_ACT_II 0x612
+#define CAN_NLG5_ACT_II_DLC 8
+#define CAN_NLG5_TEMP 0x613
+#define CAN_NLG5_TEMP_DLC 8
+#define CAN_NLG5_ERR 0x614
+#define CAN_NLG5_ERR_DLC 5
+#define CAN_NLG5_CTL 0x618
+#define CAN_NLG5_CTL_DLC 7
+
+#define CAN_MSGS_COUNT 16
+
+// Signal descriptor flags
+#define CAN_SIGNAL_SIGNED 0x01
+#define CAN_SIGNAL_MOTOROLA 0x02 					// Big endian, start is the MSB
+
+// -------------------------------------------------------------
+// Types
+
+typedef struct _CAN_SIGNAL_DESC_T_ {
+	const char *name;
+	const char *unit;
+	uint8_t start; 								// DBC start bit
+	uint8_t length;
+	uint8_t flags;
+	int32_t factor_num; 						// physical = raw * factor_num / factor_den + offset
+	uint32_t factor_den;
+	int32_t offset;
+} CAN_SIGNAL_DESC_T;
+
+typedef struct _CAN_MSG_DESC_T_ {
+	const char *name;
+	uint16_t id;
+	uint8_t dlc;
+	uint8_t num_signals;
+	uint16_t period_ms; 						// GenMsgCycleTime, 0 if sent on events
+	const CAN_SIGNAL_DESC_T *signals;
+} CAN_MSG_DESC_T;
+
+typedef struct _CAN_THROTTLE_T_ {
+	uint8_t accel_pct;
+	uint8_t brake_pct;
+} CAN_THROTTLE_T;
+
+typedef struct _CAN_POWER_STATUS_T_ {
+	bool lv_battery_flag;
+	bool lv_dcdc_status;
+	bool critical_battery_flag;
+	bool critical_dcdc_status;
+	bool pdm_status;
+} CAN_POWER_STATUS_T;
+
+typedef struct _CAN_DRIVER_INPUT_T_ {
+	uint16_t key_state;
+	uint16_t drive_status;
+} CAN_DRIVER_INPUT_T;
+
+typedef struct _CAN_CONTACTORS_T_ {
+	bool contactor_1_error;
+	bool contactor_2_error;
+	bool contactor_1_status;
+	bool contactor_2_status;
+	bool lv_contactor_status;
+	bool contactor_3_error;
+	bool contactor_3_status;
+	uint16_t precharge_state;
+} CAN_CONTACTORS_T;
+
+typedef struct _CAN_CELL_VOLTAGES_T_ {
+	uint16_t min_cell_mV;
+	uint16_t max_cell_mV;
+	uint8_t min_cell_cmu;
+	uint8_t min_cell_index;
+	uint8_t max_cell_cmu;
+	uint8_t max_cell_index;
+} CAN_CELL_VOLTAGES_T;
+
+typedef struct _CAN_CELL_TEMPS_T_ {
+	int16_t min_temp_dC;
+	int16_t max_temp_dC;
+	uint8_t min_temp_cmu;
+	uint8_t max_temp_cmu;
+} CAN_CELL_TEMPS_T;
+
+typedef struct _CAN_BATTERY_T_ {
+	uint16_t voltage_dV;
+	int16_t current_dA;
+} CAN_BATTERY_T;
+
+typedef struct _CAN_VELOCITY1_T_ {
+	uint16_t speed_rpm;
+} CAN_VELOCITY1_T;
+
+typedef struct _CAN_VELOCITY2_T_ {
+	uint16_t speed_rpm;
+} CAN_VELOCITY2_T;
+
+typedef struct _CAN_MOTOR_STATUS_T_ {
+	uint16_t shutdown_ok;
+	int16_t current_dA;
+	int16_t speed_rpm;
+	uint16_t voltage_dV;
+} CAN_MOTOR_STATUS_T;
+
+typedef struct _CAN_NLG5_STATUS_T_ {
+	bool power_enabled;
+	bool error_latch;
+	bool limit_warning;
+	bool fan_active;
+	uint8_t mains_type;
+	bool pilot_detected;
+	uint8_t bypass_detection;
+	uint16_t limitation;
+} CAN_NLG5_STATUS_T;
+
+typedef struct _CAN_NLG5_ACT_I_T_ {
+	uint16_t mains_cA;
+	uint16_t mains_dV;
+	uint16_t output_dV;
+	uint16_t output_cA;
+} CAN_NLG5_ACT_I_T;
+
+typedef struct _CAN_NLG5_ACT_II_T_ {
+	uint16_t mains_max_pilot_dA;
+	uint8_t mains_max_power_ind_dA;
+	uint8_t aux_battery_dV;
+	int16_t ext_shunt_cAh;
+	uint16_t booster_output_cA;
+} CAN_NLG5_ACT_II_T;
+
+typedef struct _CAN_NLG5_TEMP_T_ {
+	int16_t power_temp_dC;
+	int16_t temp_1_dC;
+	int16_t temp_2_dC;
+	int16_t temp_3_dC;
+} CAN_NLG5_TEMP_T;
+
+typedef struct _CAN_NLG5_ERR_T_ {
+	uint32_t errors;
+	uint8_t warnings;
+} CAN_NLG5_ERR_T;
+
+typedef struct _CAN_NLG5_CTL_T_ {
+	bool enable;
+	bool clear_error;
+	bool ventilation_request;
+	uint16_t max_mains_dA;
+	uint16_t output_dV;
+	uint16_t output_dA;
+} CAN_NLG5_CTL_T;
+
+// -------------------------------------------------------------
+// Public Functions
+
+/**
+ * Message descriptors in description file order
+ */
+extern const CAN_MSG_DESC_T CANMsgs_Messages[CAN_MSGS_COUNT];
+
+/**
+ * @param id standard CAN ID
+ * @return the message's descriptor, NULL if it is not described
+ */
+const CAN_MSG_DESC_T *CANMsgs_Find(uint16_t id);
+
+/**
+ * @return 0 on success, -1 if dlc is not CAN_THROTTLE_DLC
+ */
+int8_t CANMsgs_DecodeThrottle(CAN_THROTTLE_T *msg, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @return CAN_THROTTLE_DLC, the bytes written to data
+ */
+uint8_t CANMsgs_EncodeThrottle(const CAN_THROTTLE_T *msg, uint8_t *data);
+
+/**
+ * @return 0 on success, -1 if dlc is not CAN_POWER_STATUS_DLC
+ */
+int8_t CANMsgs_DecodePowerStatus(CAN_POWER_STATUS_T *msg, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @return CAN_POWER_STATUS_DLC, the bytes written to data
+ */
+uint8_t CANMsgs_EncodePowerStatus(const CAN_POWER_STATUS_T *msg, uint8_t *data);
+
+/**
+ * @return 0 on success, -1 if dlc is not CAN_DRIVER_INPUT_DLC
+ */
+int8_t CANMsgs_DecodeDriverInput(CAN_DRIVER_INPUT_T *msg, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @return CAN_DRIVER_INPUT_DLC, the bytes written to data
+ */
+uint8_t CANMsgs_EncodeDriverInput(const CAN_DRIVER_INPUT_T *msg, uint8_t *data);
+
+/**
+ * @return 0 on success, -1 if dlc is not CAN_CONTACTORS_DLC
+ */
+int8_t CANMsgs_DecodeContactors(CAN_CONTACTORS_T *msg, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @return CAN_CONTACTORS_DLC, the bytes written to data
+ */
+uint8_t CANMsgs_EncodeContactors(const CAN_CONTACTORS_T *msg, uint8_t *data);
+
+/**
+ * @return 0 on success, -1 if dlc is not CAN_CELL_VOLTAGES_DLC
+ */
+int8_t CANMsgs_DecodeCellVoltages(CAN_CELL_VOLTAGES_T *msg, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @return CAN_CELL_VOLTAGES_DLC, the bytes written to data
+ */
+uint8_t CANMsgs_EncodeCellVoltages(const CAN_CELL_VOLTAGES_T *msg, uint8_t *data);
+
+/**
+ * @return 0 on success, -1 if dlc is not CAN_CELL_TEMPS_DLC
+ */
+int8_t CANMsgs_DecodeCellTemps(CAN_CELL_TEMPS_T *msg, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @return CAN_CELL_TEMPS_DLC, the bytes written to data
+ */
+uint8_t CANMsgs_EncodeCellTemps(const CAN_CELL_TEMPS_T *msg, uint8_t *data);
+
+/**
+ * @return 0 on success, -1 if dlc is not CAN_BATTERY_DLC
+ */
+int8_t CANMsgs_DecodeBattery(CAN_BATTERY_T *msg, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @return CAN_BATTERY_DLC, the bytes written to data
+ */
+uint8_t CANMsgs_EncodeBattery(const CAN_BATTERY_T *msg, uint8_t *data);
+
+/**
+ * @return 0 on success, -1 if dlc is not CAN_VELOCITY1_DLC
+ */
+int8_t CANMsgs_DecodeVelocity1(CAN_VELOCITY1_T *msg, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @return CAN_VELOCITY1_DLC, the bytes written to data
+ */
+uint8_t CANMsgs_EncodeVelocity1(const CAN_VELOCITY1_T *msg, uint8_t *data);
+
+/**
+ * @return 0 on success, -1 if dlc is not CAN_VELOCITY2_DLC
+ */
+int8_t CANMsgs_DecodeVelocity2(CAN_VELOCITY2_T *msg, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @return CAN_VELOCITY2_DLC, the bytes written to data
+ */
+uint8_t CANMsgs_EncodeVelocity2(const CAN_VELOCITY2_T *msg, uint8_t *data);
+
+/**
+ * @return 0 on success, -1 if dlc is not CAN_MOTOR_STATUS_DLC
+ */
+int8_t CANMsgs_DecodeMotorStatus(CAN_MOTOR_STATUS_T *msg, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @return CAN_MOTOR_STATUS_DLC, the bytes written to data
+ */
+uint8_t CANMsgs_EncodeMotorStatus(const CAN_MOTOR_STATUS_T *msg, uint8_t *data);
+
+/**
+ * @return 0 on success, -1 if dlc is not CAN_NLG5_STATUS_DLC
+ */
+int8_t CANMsgs_DecodeNLG5Status(CAN_NLG5_STATUS_T *msg, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @return CAN_NLG5_STATUS_DLC, the bytes written to data
+ */
+uint8_t CANMsgs_EncodeNLG5Status(const CAN_NLG5_STATUS_T *msg, uint8_t *data);
+
+/**
+ * @return 0 on success, -1 if dlc is not CAN_NLG5_ACT_I_DLC
+ */
+int8_t CANMsgs_DecodeNLG5ActI(CAN_NLG5_ACT_I_T *msg, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @return CAN_NLG5_ACT_I_DLC, the bytes written to data
+ */
+uint8_t CANMsgs_EncodeNLG5ActI(const CAN_NLG5_ACT_I_T *msg, uint8_t *data);
+
+/**
+ * @return 0 on success, -1 if dlc is not CAN_NLG5_ACT_II_DLC
+ */
+int8_t CANMsgs_DecodeNLG5ActII(CAN_NLG5_ACT_II_T *msg, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @return CAN_NLG5_ACT_II_DLC, the bytes written to data
+ */
+uint8_t CANMsgs_EncodeNLG5ActII(const CAN_NLG5_ACT_II_T *msg, uint8_t *data);
+
+/**
+ * @return 0 on success, -1 if dlc is not CAN_NLG5_TEMP_DLC
+ */
+int8_t CANMsgs_DecodeNLG5Temp(CAN_NLG5_TEMP_T *msg, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @return CAN_NLG5_TEMP_DLC, the bytes written to data
+ */
+uint8_t CANMsgs_EncodeNLG5Temp(const CAN_NLG5_TEMP_T *msg, uint8_t *data);
+
+/**
+ * @return 0 on success, -1 if dlc is not CAN_NLG5_ERR_DLC
+ */
+int8_t CANMsgs_DecodeNLG5Err(CAN_NLG5_ERR_T *msg, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @return CAN_NLG5_ERR_DLC, the bytes written to data
+ */
+uint8_t CANMsgs_EncodeNLG5Err(const CAN_NLG5_ERR_T *msg, uint8_t *data);
+
+/**
+ * @return 0 on success, -1 if dlc is not CAN_NLG5_CTL_DLC
+ */
+int8_t CANMsgs_DecodeNLG5Ctl(CAN_NLG5_CTL_T *msg, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @return CAN_NLG5_CTL_DLC, the bytes written to data
+ */
+uint8_t CANMsgs_EncodeNLG5Ctl(const CAN_NLG5_CTL_T *msg, uint8_t *data);
+
+// -------------------------------------------------------------
+// Signal store
+
+// Store widths, the top byte of a CAN_SIG_ constant
+#define CAN_STORE_BIT 0
+#define CAN_STORE_U8 1
+#define CAN_STORE_U16 2
+#define CAN_STORE_U32 3
+
+#define CAN_SIG(store, slot) (((store) << 8) | (slot))
+#define CAN_SIG_STORE(sig) ((sig) >> 8)
+#define CAN_SIG_SLOT(sig) ((sig) & 0xFF)
+
+#define CAN_STORE_BITS 20
+#define CAN_STORE_U8S 13
+#define CAN_STORE_U16S 30
+#define CAN_STORE_U32S 1
+#define CAN_SIGNALS_COUNT 64
+
+// Message indices into CANMsgs_Messages
+#define CAN_MSG_THROTTLE 0
+#define CAN_MSG_POWER_STATUS 1
+#define CAN_MSG_DRIVER_INPUT 2
+#define CAN_MSG_CONTACTORS 3
+#define CAN_MSG_CELL_VOLTAGES 4
+#define CAN_MSG_CELL_TEMPS 5
+#define CAN_MSG_BATTERY 6
+#define CAN_MSG_VELOCITY1 7
+#define CAN_MSG_VELOCITY2 8
+#define CAN_MSG_MOTOR_STATUS 9
+#define CAN_MSG_NLG5_STATUS 10
+#define CAN_MSG_NLG5_ACT_I 11
+#define CAN_MSG_NLG5_ACT_II 12
+#define CAN_MSG_NLG5_TEMP 13
+#define CAN_MSG_NLG5_ERR 14
+#define CAN_MSG_NLG5_CTL 15
+
+#define CAN_SIG_THROTTLE_ACCEL_PCT CAN_SIG(CAN_STORE_U8, 0)
+#define CAN_SIG_THROTTLE_BRAKE_PCT CAN_SIG(CAN_STORE_U8, 1)
+#define CAN_SIG_POWER_STATUS_LV_BATTERY_FLAG CAN_SIG(CAN_STORE_BIT, 0)
+#define CAN_SIG_POWER_STATUS_LV_DCDC_STATUS CAN_SIG(CAN_STORE_BIT, 1)
+#define CAN_SIG_POWER_STATUS_CRITICAL_BATTERY_FLAG CAN_SIG(CAN_STORE_BIT, 2)
+#define CAN_SIG_POWER_STATUS_CRITICAL_DCDC_STATUS CAN_SIG(CAN_STORE_BIT, 3)
+#define CAN_SIG_POWER_STATUS_PDM_STATUS CAN_SIG(CAN_STORE_BIT, 4)
+#define CAN_SIG_DRIVER_INPUT_KEY_STATE CAN_SIG(CAN_STORE_U16, 0)
+#define CAN_SIG_DRIVER_INPUT_DRIVE_STATUS CAN_SIG(CAN_STORE_U16, 1)
+#define CAN_SIG_CONTACTORS_CONTACTOR_1_ERROR CAN_SIG(CAN_STORE_BIT, 5)
+#define CAN_SIG_CONTACTORS_CONTACTOR_2_ERROR CAN_SIG(CAN_STORE_BIT, 6)
+#define CAN_SIG_CONTACTORS_CONTACTOR_1_STATUS CAN_SIG(CAN_STORE_BIT, 7)
+#define CAN_SIG_CONTACTORS_CONTACTOR_2_STATUS CAN_SIG(CAN_STORE_BIT, 8)
+#define CAN_SIG_CONTACTORS_LV_CONTACTOR_STATUS CAN_SIG(CAN_STORE_BIT, 9)
+#define CAN_SIG_CONTACTORS_CONTACTOR_3_ERROR CAN_SIG(CAN_STORE_BIT, 10)
+#define CAN_SIG_CONTACTORS_CONTACTOR_3_STATUS CAN_SIG(CAN_STORE_BIT, 11)
+#define CAN_SIG_CONTACTORS_PRECHARGE_STATE CAN_SIG(CAN_STORE_U16, 2)
+#define CAN_SIG_CELL_VOLTAGES_MIN_CELL_MV CAN_SIG(CAN_STORE_U16, 3)
+#define CAN_SIG_CELL_VOLTAGES_MAX_CELL_MV CAN_SIG(CAN_STORE_U16, 4)
+#define CAN_SIG_CELL_VOLTAGES_MIN_CELL_CMU CAN_SIG(CAN_STORE_U8, 2)
+#define CAN_SIG_CELL_VOLTAGES_MIN_CELL_INDEX CAN_SIG(CAN_STORE_U8, 3)
+#define CAN_SIG_CELL_VOLTAGES_MAX_CELL_CMU CAN_SIG(CAN_STORE_U8, 4)
+#define CAN_SIG_CELL_VOLTAGES_MAX_CELL_INDEX CAN_SIG(CAN_STORE_U8, 5)
+#define CAN_SIG_CELL_TEMPS_MIN_TEMP_DC CAN_SIG(CAN_STORE_U16, 5)
+#define CAN_SIG_CELL_TEMPS_MAX_TEMP_DC CAN_SIG(CAN_STORE_U16, 6)
+#define CAN_SIG_CELL_TEMPS_MIN_TEMP_CMU CAN_SIG(CAN_STORE_U8, 6)
+#define CAN_SIG_CELL_TEMPS_MAX_TEMP_CMU CAN_SIG(CAN_STORE_U8, 7)
+#define CAN_SIG_BATTERY_VOLTAGE_DV CAN_SIG(CAN_STORE_U16, 7)
+#define CAN_SIG_BATTERY_CURRENT_DA CAN_SIG(CAN_STORE_U16, 8)
+#define CAN_SIG_VELOCITY1_SPEED_RPM CAN_SIG(CAN_STORE_U16, 9)
+#define CAN_SIG_VELOCITY2_SPEED_RPM CAN_SIG(CAN_STORE_U16, 10)
+#define CAN_SIG_MOTOR_STATUS_SHUTDOWN_OK CAN_SIG(CAN_STORE_U16, 11)
+#define CAN_SIG_MOTOR_STATUS_CURRENT_DA CAN_SIG(CAN_STORE_U16, 12)
+#define CAN_SIG_MOTOR_STATUS_SPEED_RPM CAN_SIG(CAN_STORE_U16, 13)
+#define CAN_SIG_MOTOR_STATUS_VOLTAGE_DV CAN_SIG(CAN_STORE_U16, 14)
+#define CAN_SIG_NLG5_STATUS_POWER_ENABLED CAN_SIG(CAN_STORE_BIT, 12)
+#define CAN_SIG_NLG5_STATUS_ERROR_LATCH CAN_SIG(CAN_STORE_BIT, 13)
+#define CAN_SIG_NLG5_STATUS_LIMIT_WARNING CAN_SIG(CAN_STORE_BIT, 14)
+#define CAN_SIG_NLG5_STATUS_FAN_ACTIVE CAN_SIG(CAN_STORE_BIT, 15)
+#define CAN_SIG_NLG5_STATUS_MAINS_TYPE CAN_SIG(CAN_STORE_U8, 8)
+#define CAN_SIG_NLG5_STATUS_PILOT_DETECTED CAN_SIG(CAN_STORE_BIT, 16)
+#define CAN_SIG_NLG5_STATUS_BYPASS_DETECTION CAN_SIG(CAN_STORE_U8, 9)
+#define CAN_SIG_NLG5_STATUS_LIMITATION CAN_SIG(CAN_STORE_U16, 15)
+#define CAN_SIG_NLG5_ACT_I_MAINS_CA CAN_SIG(CAN_STORE_U16, 16)
+#define CAN_SIG_NLG5_ACT_I_MAINS_DV CAN_SIG(CAN_STORE_U16, 17)
+#define CAN_SIG_NLG5_ACT_I_OUTPUT_DV CAN_SIG(CAN_STORE_U16, 18)
+#define CAN_SIG_NLG5_ACT_I_OUTPUT_CA CAN_SIG(CAN_STORE_U16, 19)
+#define CAN_SIG_NLG5_ACT_II_MAINS_MAX_PILOT_DA CAN_SIG(CAN_STORE_U16, 20)
+#define CAN_SIG_NLG5_ACT_II_MAINS_MAX_POWER_IND_DA CAN_SIG(CAN_STORE_U8, 10)
+#define CAN_SIG_NLG5_ACT_II_AUX_BATTERY_DV CAN_SIG(CAN_STORE_U8, 11)
+#define CAN_SIG_NLG5_ACT_II_EXT_SHUNT_CAH CAN_SIG(CAN_STORE_U16, 21)
+#define CAN_SIG_NLG5_ACT_II_BOOSTER_OUTPUT_CA CAN_SIG(CAN_STORE_U16, 22)
+#define CAN_SIG_NLG5_TEMP_POWER_TEMP_DC CAN_SIG(CAN_STORE_U16, 23)
+#define CAN_SIG_NLG5_TEMP_TEMP_1_DC CAN_SIG(CAN_STORE_U16, 24)
+#define CAN_SIG_NLG5_TEMP_TEMP_2_DC CAN_SIG(CAN_STORE_U16, 25)
+#define CAN_SIG_NLG5_TEMP_TEMP_3_DC CAN_SIG(CAN_STORE_U16, 26)
+#define CAN_SIG_NLG5_ERR_ERRORS CAN_SIG(CAN_STORE_U32, 0)
+#define CAN_SIG_NLG5_ERR_WARNINGS CAN_SIG(CAN_STORE_U8, 12)
+#define CAN_SIG_NLG5_CTL_ENABLE CAN_SIG(CAN_STORE_BIT, 17)
+#define CAN_SIG_NLG5_CTL_CLEAR_ERROR CAN_SIG(CAN_STORE_BIT, 18)
+#define CAN_SIG_NLG5_CTL_VENTILATION_REQUEST CAN_SIG(CAN_STORE_BIT, 19)
+#define CAN_SIG_NLG5_CTL_MAX_MAINS_DA CAN_SIG(CAN_STORE_U16, 27)
+#define CAN_SIG_NLG5_CTL_OUTPUT_DV CAN_SIG(CAN_STORE_U16, 28)
+#define CAN_SIG_NLG5_CTL_OUTPUT_DA CAN_SIG(CAN_STORE_U16, 29)
+
+/**
+ * Where a signal lives: its message and signal descriptors and its slot
+ */
+typedef struct _P_SIGNAL_META_T_ {
+	uint8_t msg; 								// Index into CANMsgs_Messages
+	uint8_t signal; 							// Index into the message's signals
+	uint16_t sig; 								// CAN_SIG_ constant
+} CAN_SIGNAL_META_T;
+
+// Widths without signals keep one unused slot, C has no empty arrays
+typedef struct _P_STORE_T_ {
+	uint32_t u32[1];
+	uint16_t u16[30];
+	uint8_t u8[13];
+	uint8_t bits[3];
+} CAN_STORE_T;
+
+/**
+ * Every signal in description file order
+ */
+extern const CAN_SIGNAL_META_T CANMsgs_Signals[CAN_SIGNALS_COUNT];
+
+/**
+ * Write every signal of a described message into the store
+ *
+ * @return 0 on success, -1 on a wrong DLC, 1 if the ID is not described
+ */
+int8_t CANMsgs_Store(CAN_STORE_T *store, uint16_t id, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @param sig CAN_SIG_ constant
+ * @return the signal's raw value, zero extended
+ */
+static inline uint32_t CANMsgs_Get(const CAN_STORE_T *store, uint16_t sig) {
+	switch (CAN_SIG_STORE(sig)) {
+		case CAN_STORE_BIT: return (store->bits[CAN_SIG_SLOT(sig) >> 3] >> (CAN_SIG_SLOT(sig) & 7)) & 1;
+		case CAN_STORE_U8: return store->u8[CAN_SIG_SLOT(sig)];
+		case CAN_STORE_U16: return store->u16[CAN_SIG_SLOT(sig)];
+		default: return store->u32[CAN_SIG_SLOT(sig)];
+	}
+}
+
+#endif
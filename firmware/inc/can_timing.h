@@ -0,0 +1,117 @@
+#ifndef __CAN_TIMING_H_
+#define __CAN_TIMING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//--------------------------------------------
+// Integer-only CAN bit timing. A bit is split into time quanta: one sync
+// quantum, TSEG1 (propagation and phase 1) and TSEG2 (phase 2), sampled at the
+// end of TSEG1. The solver tries every quanta count the controller allows and
+// keeps the one closest to the requested bit rate, then to the requested
+// sample point. Controller limits are described by CAN_TIMING_LIMITS_T so the
+// on-chip C_CAN and the MCP2515 share the same search.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Configuration Macros
+
+#define CAN_TIMING_SAMPLE_POINT 875 			// CiA 301 recommendation, permille of the bit
+#define CAN_TIMING_MAX_RATE_ERR_PPM 5000 		// Bit rates further off than this are rejected
+
+// -------------------------------------------------------------
+// Computed Macros
+
+/**
+ * Constant expression forms for a fixed clock, bit rate and quanta count.
+ * CAN_TIMING_INIT refuses to compile unless the bit rate is exact.
+ */
+#define CAN_TIMING_BRP(clock, baud, tq) ((clock) / ((baud) * (tq)))
+#define CAN_TIMING_TSEG2(tq, sp) ((tq) - ((sp) * (tq) + 500) / 1000)
+#define CAN_TIMING_TSEG1(tq, sp) ((tq) - 1 - CAN_TIMING_TSEG2(tq, sp))
+#define CAN_TIMING_SP(tq, sp) ((1000 * (1 + CAN_TIMING_TSEG1(tq, sp)) + (tq) / 2) / (tq))
+#define CAN_TIMING_CHECK(clock, baud, tq) \
+	(0 * sizeof(char[((clock) % ((baud) * (tq)) == 0) ? 1 : -1]))
+
+/**
+ * Initializer for a CAN_TIMING_T
+ *
+ * @param clock controller clock before the prescaler (Hz)
+ * @param baud bit rate (bit/s)
+ * @param tq quanta per bit
+ * @param sp sample point, permille
+ * @param sjw synchronisation jump width, quanta
+ */
+#define CAN_TIMING_INIT(clock, baud, tq, sp, sjw) { \
+	CAN_TIMING_BRP(clock, baud, tq) + CAN_TIMING_CHECK(clock, baud, tq), \
+	CAN_TIMING_TSEG1(tq, sp), \
+	CAN_TIMING_TSEG2(tq, sp), \
+	(sjw), \
+	CAN_TIMING_SP(tq, sp), \
+	CAN_TIMING_SP(tq, sp) - (sp), \
+	0 }
+
+// C_CAN BTR: BRP[5:0], SJW[7:6], TSEG1[11:8], TSEG2[14:12], each stored minus one
+#define CAN_TIMING_CCAN_BTR(t) \
+	((((t)->brp - 1) & 0x3F) | (((t)->sjw - 1) & 0x03) << 6 | \
+	(((t)->tseg1 - 1) & 0x0F) << 8 | (((t)->tseg2 - 1) & 0x07) << 12)
+
+// MCP2515 CNF1-3. TSEG1 is split into PRSEG and PHSEG1, BTLMODE set so
+// PHSEG2 comes from CNF3.
+#define CAN_TIMING_MCP2515_PRSEG(t) (((t)->tseg1 + 1) / 2)
+#define CAN_TIMING_MCP2515_CNF1(t) ((((t)->sjw - 1) & 0x03) << 6 | (((t)->brp - 1) & 0x3F))
+#define CAN_TIMING_MCP2515_CNF2(t) \
+	(0x80 | (((t)->tseg1 - CAN_TIMING_MCP2515_PRSEG(t) - 1) & 0x07) << 3 | ((CAN_TIMING_MCP2515_PRSEG(t) - 1) & 0x07))
+#define CAN_TIMING_MCP2515_CNF3(t) (((t)->tseg2 - 1) & 0x07)
+
+// -------------------------------------------------------------
+// Types
+
+typedef struct _CAN_TIMING_LIMITS_T_ {
+	uint16_t brp_max; 							// Prescaler range is 1 to brp_max
+	uint8_t tseg1_min;
+	uint8_t tseg1_max;
+	uint8_t tseg2_min;
+	uint8_t tseg2_max;
+	uint8_t sjw_max;
+	uint8_t sjw_margin; 						// Quanta SJW must stay below TSEG2
+} CAN_TIMING_LIMITS_T;
+
+typedef struct _CAN_TIMING_T_ {
+	uint16_t brp; 								// Prescaler, clocks per quantum
+	uint8_t tseg1; 								// Quanta, propagation and phase 1
+	uint8_t tseg2; 								// Quanta, phase 2
+	uint8_t sjw;
+	uint16_t sample_point; 						// Achieved, permille
+	int16_t sp_error; 							// Achieved minus requested, permille
+	uint16_t rate_err_ppm;
+} CAN_TIMING_T;
+
+// -------------------------------------------------------------
+// Controller Limits
+
+extern const CAN_TIMING_LIMITS_T CANTiming_CCAN;
+extern const CAN_TIMING_LIMITS_T CANTiming_MCP2515; 	// Clock is the oscillator over two
+
+// -------------------------------------------------------------
+// Public Functions
+
+/**
+ * Find the bit timing closest to a bit rate and sample point
+ *
+ * @param clock controller clock before the prescaler (Hz)
+ * @param baud bit rate (bit/s)
+ * @param sample_point requested sample point, permille
+ * @param limits controller limits
+ * @param timing filled with the best configuration
+ * @return false if no configuration is within CAN_TIMING_MAX_RATE_ERR_PPM
+ */
+bool CANTiming_Solve(uint32_t clock, uint32_t baud, uint16_t sample_point,
+	const CAN_TIMING_LIMITS_T *limits, CAN_TIMING_T *timing);
+
+/**
+ * @return quanta per bit
+ */
+uint8_t CANTiming_Quanta(const CAN_TIMING_T *timing);
+
+#endif
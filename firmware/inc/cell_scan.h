@@ -0,0 +1,68 @@
+#ifndef __CELL_SCAN_H_
+#define __CELL_SCAN_H_
+
+#include "ltc6804_async.h"
+
+//--------------------------------------------
+// Continuous full-pack cell voltage scan. Each pass starts ADCV, polls PLADC
+// until the chain has converted, reads groups A-D back to back and publishes
+// the decoded pack into the idle half of a double buffer. The next conversion
+// is started before the previous one is decoded, so the two overlap.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Configuration Macros
+
+#define CELL_SCAN_POLL_MS 1 					// Minimum time between PLADC polls
+#define CELL_SCAN_TIMEOUT_MS 500 				// Conversion restarted if PLADC never reports done
+#define CELL_SCAN_RATE_WINDOW_MS 1000 			// Window over which the scan rate is measured
+
+#define CELL_SCAN_NUM_GROUPS 4
+
+// -------------------------------------------------------------
+// Types
+
+/**
+ * One published pack reading
+ */
+typedef struct _CELL_SCAN_T_ {
+	CELL_INFO_T cells[LTC6804_ASYNC_MAX_DEVICES];
+	uint16_t pec_errors; 						// Devices holding stale data from a failed PEC
+	uint32_t seq; 								// Increments with every published scan
+	uint32_t timestamp; 						// msTicks when the conversion was started
+} CELL_SCAN_T;
+
+typedef struct _CELL_SCAN_STATS_T_ {
+	uint32_t scans;
+	uint32_t timeouts;
+	uint32_t rate_mHz; 							// Scans per 1000 s over the last window
+	uint32_t period_ms; 						// Time between the last two scans
+	uint32_t convert_ms; 						// Time the last conversion took to report done
+} CELL_SCAN_STATS_T;
+
+// -------------------------------------------------------------
+// Public Functions
+
+/**
+ * Reset the scan engine. LTC6804Async_Init must have been called.
+ *
+ * @param adcv_cmd conversion command, e.g. LTC6804_ADCV
+ */
+void CellScan_Init(uint16_t adcv_cmd);
+
+/**
+ * Advance the scan state machine. Call every main loop pass.
+ *
+ * @param msTicks current time
+ * @return true if a new scan was published
+ */
+bool CellScan_Update(uint32_t msTicks);
+
+/**
+ * @return most recently published scan. Valid until the next CellScan_Update.
+ */
+const CELL_SCAN_T *CellScan_GetLatest(void);
+
+void CellScan_GetStats(CELL_SCAN_STATS_T *stats);
+
+#endif
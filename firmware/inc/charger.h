@@ -0,0 +1,106 @@
+#ifndef __CHARGER_H_
+#define __CHARGER_H_
+
+#include "chip.h"
+#include "brusa.h"
+
+//--------------------------------------------
+// Onboard charging with a Brusa NLG5. Status, ACT_I, ACT_II, TEMP and ERR
+// frames are decoded into the signal store with the rest of the car bus, see
+// can/bcm.dbc, and the charger reads the NLG5 from there. Every
+// CHARGER_PERIOD_MS a control step runs the CC/CV profile on the pack's
+// highest cell and sends NLG5_CTL built by Brusa_MakeCTL.
+//
+// CC requests the full charge current until the highest cell comes within
+// CHARGER_CV_BAND_MV of CHARGER_CELL_CV_MV. CV then integrates the error on
+// that cell into the current setpoint, so the highest cell is held at the
+// CV voltage while the current tapers to CHARGER_TERM_CAMPS.
+//
+// Steps are scheduled on fixed deadlines so the rate does not drift. The
+// period between steps is measured in core clock cycles.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Configuration Macros
+
+#define CHARGER_PERIOD_MS 100 					// Control step and NLG5_CTL rate
+#define CHARGER_CELL_CV_MV 3600 				// Highest cell is held here
+#define CHARGER_CELL_ABS_MAX_MV 3700 			// Charging stops with a fault above this
+#define CHARGER_CV_BAND_MV 50 					// CV starts this far below CHARGER_CELL_CV_MV
+#define CHARGER_CV_GAIN 2 						// cA per mV of error per step
+#define CHARGER_TERM_CAMPS 100 					// Charge is done once the setpoint stays below this
+#define CHARGER_TERM_STEPS 50 					// for this many steps
+#define CHARGER_STALE_MS 1000 					// NLG5 gets this long after a start to clear its latch and report
+
+// -------------------------------------------------------------
+// Types
+
+typedef enum {
+	CHARGER_IDLE,
+	CHARGER_CC,
+	CHARGER_CV,
+	CHARGER_DONE,
+	CHARGER_FAULT
+} CHARGER_MODE_T;
+
+// Reasons for CHARGER_FAULT
+#define CHARGER_FAULT_NLG5 0x01 				// Error latch or ERR frame bits set
+#define CHARGER_FAULT_OVERVOLT 0x02 			// Highest cell above CHARGER_CELL_ABS_MAX_MV
+#define CHARGER_FAULT_NO_CELLS 0x04 			// Pack voltage not available or stale
+#define CHARGER_FAULT_STALE 0x08 				// NLG5 status gone stale in the signal store
+
+typedef struct _CHARGER_STATE_T_ {
+	CHARGER_MODE_T mode;
+	uint8_t faults;
+	uint16_t current_cAmps; 					// Present output current setpoint
+	uint32_t voltage_mVolts; 					// Output voltage ceiling
+	uint16_t max_cell_mV; 						// Highest cell at the last step
+} CHARGER_STATE_T;
+
+typedef struct _CHARGER_STATS_T_ {
+	uint32_t steps;
+	uint32_t overruns; 							// Steps skipped because the loop fell a full period behind
+	uint32_t period_min; 						// Cycles between consecutive steps
+	uint32_t period_max;
+	uint32_t send_failed; 						// NLG5_CTL refused, the previous one still pending
+} CHARGER_STATS_T;
+
+// -------------------------------------------------------------
+// Public Functions
+
+/**
+ * @param num_cells cells in series, sets the output voltage ceiling
+ * @param cc_cAmps constant current phase output current
+ * @param mains_cAmps mains current limit
+ * @param send transmits NLG5_CTL, returns false if it could not be queued,
+ * counted in send_failed
+ * @param max_cell returns the highest cell in mV, 0 if not every cell is known and fresh
+ */
+void Charger_Init(uint16_t num_cells, uint16_t cc_cAmps, uint16_t mains_cAmps,
+	bool (*send)(const CCAN_MSG_OBJ_T *msg), uint16_t (*max_cell)(void));
+
+/**
+ * Start a charge, clearing any latched NLG5 error
+ */
+void Charger_Start(uint32_t msTicks);
+
+/**
+ * Stop charging, the NLG5 keeps receiving disabled control frames
+ */
+void Charger_Stop(void);
+
+/**
+ * Run the control step when it is due. Call every main loop pass.
+ *
+ * @param msTicks current time
+ * @param cycles Board_CycleCount(), for period measurement
+ */
+void Charger_Update(uint32_t msTicks, uint32_t cycles);
+
+const CHARGER_STATE_T *Charger_GetState(void);
+
+const CHARGER_STATS_T *Charger_GetStats(void);
+
+void Charger_ResetStats(void);
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef __EVENT_LOG_H_
+#define __EVENT_LOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//--------------------------------------------
+// Persistent event log in the last EVENT_LOG_SECTORS flash sectors. Records
+// are 16 bytes with a CRC, staged in a RAM page and programmed a whole page
+// at a time, so appending costs a copy until a page fills. The sectors are
+// used in rotation: writing the first page of a sector erases it, which
+// drops the oldest sector's records and spreads erases evenly. With a single
+// sector the whole log starts over each time it wraps.
+//
+// Pages are written in order and an unwritten page reads erased, so at boot
+// the sector holding the newest sequence number is found from the first
+// record of each sector, and the write position within it by a binary
+// search over its pages.
+//
+// Flash is reached through the erase and program callbacks passed to
+// EventLog_Init(), and read in place through the base pointer.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Configuration Macros
+
+#define EVENT_LOG_SECTORS 1 					// Sectors in rotation, 256 records each
+#define EVENT_LOG_FIRST_SECTOR 7 				// Last 4 KB of the 32 KB flash, see gcc.ld
+#define EVENT_LOG_SECTOR_SIZE 4096
+#define EVENT_LOG_PAGE_SIZE 256 				// Smallest IAP copy to flash
+
+// -------------------------------------------------------------
+// Computed Macros
+
+#define EVENT_LOG_BASE (EVENT_LOG_FIRST_SECTOR * EVENT_LOG_SECTOR_SIZE)
+#define EVENT_LOG_PAGES (EVENT_LOG_SECTOR_SIZE / EVENT_LOG_PAGE_SIZE) 	// Pages per sector
+#define EVENT_LOG_RECORDS (EVENT_LOG_PAGE_SIZE / sizeof(EVENT_LOG_RECORD_T)) // Records per page
+
+// -------------------------------------------------------------
+// Types
+
+typedef enum {
+	EVENT_LOG_BOOT, 							// data: reset cause
+	EVENT_LOG_FAULT, 							// code: FAULT_T, data: 1 set, 0 clear
+	EVENT_LOG_WARNING, 							// code: WARNING_T, data: raw value
+	EVENT_LOG_CAN_ERROR 						// data: CAN error info
+} EVENT_LOG_TYPE_T;
+
+typedef struct _EVENT_LOG_RECORD_T_ {
+	uint32_t seq; 								// Increases by one per record, never erased value
+	uint32_t timestamp; 						// msTicks
+	uint32_t data;
+	uint8_t type; 								// EVENT_LOG_TYPE_T
+	uint8_t code;
+	uint16_t crc; 								// CRC-16/CCITT of the bytes before it
+} EVENT_LOG_RECORD_T;
+
+typedef struct _EVENT_LOG_STATS_T_ {
+	uint32_t records; 							// Records appended since boot
+	uint32_t pages; 							// Pages programmed
+	uint32_t erases;
+	uint32_t failed; 							// Erase or program calls that failed
+} EVENT_LOG_STATS_T;
+
+// -------------------------------------------------------------
+// Public Functions
+
+/**
+ * Find the write position left by the last boot
+ *
+ * @param base the log's first byte, readable in place
+ * @param erase erase one sector, numbered from the log's first
+ * @param program program one page at a byte offset from base
+ */
+void EventLog_Init(const uint8_t *base, bool (*erase)(uint8_t sector),
+	bool (*program)(uint32_t offset, const uint32_t *page));
+
+/**
+ * Stage one record, programming the page once it is full
+ */
+void EventLog_Write(uint8_t type, uint8_t code, uint32_t data, uint32_t msTicks);
+
+/**
+ * Program the staged records now, leaving the rest of the page unused. For
+ * events that must survive an imminent reset.
+ */
+void EventLog_Flush(void);
+
+/**
+ * Hand every valid record to emit, oldest first, the staged ones last
+ *
+ * @return records skipped for a bad CRC
+ */
+uint32_t EventLog_Dump(void (*emit)(const EVENT_LOG_RECORD_T *record));
+
+const EVENT_LOG_STATS_T *EventLog_GetStats(void);
+
+#endif
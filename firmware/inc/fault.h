@@ -0,0 +1,90 @@
+#ifndef __FAULT_H_
+#define __FAULT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//--------------------------------------------
+// Debounced fault registry. Each fault is one bit of one byte of a car
+// frame, described by a const FAULT_SOURCE_T in flash. A received frame is
+// tested against its sources with a mask, and a fault only changes state
+// once the frame has disagreed with it debounce times in a row. State is
+// kept as bitsets indexed by FAULT_T: active follows the bus, latched holds
+// latching faults until they are cleared, and changed collects edges of
+// their union until the main loop takes them, so only transitions are ever
+// reported.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Types
+
+typedef enum {
+	FAULT_CONTACTOR_1,
+	FAULT_CONTACTOR_2,
+	FAULT_CONTACTOR_3,
+	FAULT_LV_BATTERY,
+	FAULT_CRITICAL_BATTERY,
+	FAULT_MOTOR_SHUTDOWN,
+	FAULT_COUNT
+} FAULT_T;
+
+typedef uint32_t FAULT_SET_T; 					// One bit per FAULT_T
+
+typedef enum {
+	FAULT_WARNING,
+	FAULT_CRITICAL
+} FAULT_SEVERITY_T;
+
+#define FAULT_LATCH 0x01 						// Stays latched after the bus clears it
+#define FAULT_ACTIVE_LOW 0x02 					// Faulted while the bits are clear
+
+typedef struct _FAULT_SOURCE_T_ {
+	const char *name;
+	uint16_t id; 								// CAN ID carrying the fault
+	uint8_t byte; 								// Data byte holding the bits
+	uint8_t mask; 								// Bits within that byte
+	uint8_t severity; 							// FAULT_SEVERITY_T
+	uint8_t debounce; 							// Consecutive frames to set or clear
+	uint8_t flags; 								// FAULT_LATCH, FAULT_ACTIVE_LOW
+} FAULT_SOURCE_T;
+
+#define FAULT_BIT(fault) ((FAULT_SET_T)1 << (fault))
+
+// -------------------------------------------------------------
+// Public Functions
+
+extern const FAULT_SOURCE_T Fault_Sources[FAULT_COUNT];
+
+/**
+ * Clear every fault, latch and debounce count
+ */
+void Fault_Init(void);
+
+/**
+ * Test a received frame against the sources on its ID
+ *
+ * @return faults whose state (see Fault_GetState) changed on this frame
+ */
+FAULT_SET_T Fault_Receive(uint16_t id, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @return faults that changed state since the last call
+ */
+FAULT_SET_T Fault_TakeChanged(void);
+
+FAULT_SET_T Fault_GetActive(void);
+
+FAULT_SET_T Fault_GetLatched(void);
+
+/**
+ * @return faults active on the bus or still latched, the state reported on
+ * the UART
+ */
+FAULT_SET_T Fault_GetState(void);
+
+/**
+ * Release latched faults that are no longer active
+ */
+void Fault_ClearLatched(void);
+
+#endif
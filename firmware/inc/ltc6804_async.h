@@ -0,0 +1,180 @@
+#ifndef __LTC6804_ASYNC_H_
+#define __LTC6804_ASYNC_H_
+
+#include "chip.h"
+#include "ltc6804.h"
+#include "ssp_async.h"
+
+//--------------------------------------------
+// Non-blocking LTC6804 commands on SSP1 for a daisy chain of devices. Each
+// call builds the command in a free slot and queues it on the SSP transaction
+// layer. A read clocks back every device's register group in one chip select
+// window; each group is PEC checked in the SSP interrupt and the result is
+// handed to the callback.
+//
+// Every device's sleep and isoSPI idle timers are modelled from the time of
+// the last window that reached it. Wake pulses are only queued when a device
+// may actually have timed out: a long one per device from sleep, a single
+// byte per device from isoSPI idle.
+//
+// Device 0 is the one wired to the microcontroller. Reads return device 0
+// first, writes are shifted out top of stack first.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Configuration Macros
+
+#define LTC6804_ASYNC_MAX_DEVICES 8 			// Longest supported chain, at most 16
+#define LTC6804_ASYNC_SLOTS 4 					// Commands that may be in flight at once
+
+// Timers from the LTC6804 datasheet, taken at their safe end
+#define LTC6804_ASYNC_SLEEP_MS 1800 			// Watchdog puts the core to sleep, tSLEEP min
+#define LTC6804_ASYNC_IDLE_MS 4 				// isoSPI port goes idle, tIDLE min 4.3ms less a tick
+#define LTC6804_ASYNC_TWAKE_US 300 				// Core wake up from sleep, tWAKE max
+
+// -------------------------------------------------------------
+// Computed Macros
+
+#define LTC6804_ASYNC_CMD_LEN 4 				// Command word and its PEC
+#define LTC6804_ASYNC_REG_LEN 6 				// One register group
+#define LTC6804_ASYNC_GROUP_LEN (LTC6804_ASYNC_REG_LEN + 2) 	// Register group and its PEC
+
+// Bytes in a read or write window for a chain of n devices
+#define LTC6804_ASYNC_FRAME_LEN(n) (LTC6804_ASYNC_CMD_LEN + (n) * LTC6804_ASYNC_GROUP_LEN)
+
+// ADCV, all cells, MD = 0b10 normal mode (7kHz, about 2.3ms for all cells with
+// ADCOPT = 0), discharge not permitted. Same word evt_lib's LTC6804_StartADC sends.
+#define LTC6804_ADCV 0x360
+
+// -------------------------------------------------------------
+// Types
+
+typedef enum {
+	LTC6804_DEVICE_SLEEP, 						// Core may be asleep, needs a tWAKE pulse
+	LTC6804_DEVICE_STANDBY, 					// Core awake, isoSPI port may be idle
+	LTC6804_DEVICE_READY 						// Accepts commands without waking
+} LTC6804_DEVICE_STATE_T;
+
+typedef struct _LTC6804_WAKE_STATS_T_ {
+	uint32_t commands; 							// Commands queued
+	uint32_t sleep_wakes; 						// Commands that needed a wake from sleep
+	uint32_t idle_wakes; 						// Commands that needed an isoSPI wake only
+	uint32_t windows; 							// Wake chip select windows sent
+	uint32_t bytes; 							// SPI bytes spent on waking
+} LTC6804_WAKE_STATS_T;
+
+/**
+ * Command completion, runs in interrupt context
+ *
+ * @param context caller context given with the command
+ * @param data device 0's register group, device n starts n * LTC6804_ASYNC_GROUP_LEN
+ * 			bytes later. NULL for write only commands.
+ * @param pec_errors bit n set if device n's group failed its PEC check
+ */
+typedef void (*LTC6804_ASYNC_CALLBACK_T)(void *context, const uint8_t *data, uint16_t pec_errors);
+
+// -------------------------------------------------------------
+// Public Functions
+
+/**
+ * Set up SSP1, the chip select pin and the transaction layer. Every device
+ * starts with the evt_lib default configuration (REFON, GPIO pulldowns off).
+ *
+ * @param baud SPI bit rate
+ * @param cs_gpio chip select port
+ * @param cs_pin chip select pin
+ * @param num_devices devices in the chain, clamped to LTC6804_ASYNC_MAX_DEVICES
+ */
+void LTC6804Async_Init(uint32_t baud, uint8_t cs_gpio, uint8_t cs_pin, uint8_t num_devices);
+
+/**
+ * @return devices in the chain
+ */
+uint8_t LTC6804Async_NumDevices(void);
+
+/**
+ * Queue a command with no data, e.g. LTC6804_ADCV or CLRCELL. Broadcast to
+ * the whole chain.
+ *
+ * @param cmd 11-bit command code
+ * @param msTicks current time
+ * @param callback completion callback, may be NULL
+ * @param context passed to the callback
+ * @return false if no slot or queue entry was free
+ */
+bool LTC6804Async_Command(uint16_t cmd, uint32_t msTicks, LTC6804_ASYNC_CALLBACK_T callback, void *context);
+
+/**
+ * Change one device's configuration register group. Takes effect on the next
+ * LTC6804Async_WriteCFG.
+ *
+ * @param device index in the chain
+ * @param cfg 6 configuration bytes
+ */
+void LTC6804Async_SetCFG(uint8_t device, const uint8_t *cfg);
+
+/**
+ * @return one device's configuration register group (6 bytes)
+ */
+const uint8_t *LTC6804Async_GetCFG(uint8_t device);
+
+/**
+ * Queue a WRCFG carrying every device's configuration in one window
+ *
+ * @return false if a previous WRCFG is still pending or the queue is full
+ */
+bool LTC6804Async_WriteCFG(uint32_t msTicks, LTC6804_ASYNC_CALLBACK_T callback, void *context);
+
+/**
+ * Queue a register group read from every device, e.g. RDCFG or RDCVA
+ *
+ * @param cmd 11-bit read command
+ * @param rx_buf LTC6804_ASYNC_FRAME_LEN(LTC6804Async_NumDevices()) bytes. Must stay
+ * 			valid until the callback has run.
+ * @return false if no slot or queue entry was free
+ */
+bool LTC6804Async_Read(uint16_t cmd, uint8_t *rx_buf, uint32_t msTicks, LTC6804_ASYNC_CALLBACK_T callback, void *context);
+
+/**
+ * Queue a PLADC poll. The callback's data points at a single status byte,
+ * 0xFF once every device has finished its conversion.
+ *
+ * @return false if no slot or queue entry was free
+ */
+bool LTC6804Async_PollADC(uint32_t msTicks, LTC6804_ASYNC_CALLBACK_T callback, void *context);
+
+/**
+ * Queue a read of one cell voltage group (RDCVA..RDCVD) from every device
+ */
+bool LTC6804Async_ReadVoltageGroup(CELL_GROUPS_T cg, uint8_t *rx_buf, uint32_t msTicks,
+	LTC6804_ASYNC_CALLBACK_T callback, void *context);
+
+/**
+ * Unpack a cell voltage group read into one CELL_INFO_T per device. Devices
+ * whose group failed its PEC check are left untouched.
+ *
+ * @param data as passed to the read callback
+ * @param pec_errors as passed to the read callback
+ * @param cg group that was read
+ * @param readings array of LTC6804Async_NumDevices() entries
+ */
+void LTC6804Async_DecodeVoltageGroup(const uint8_t *data, uint16_t pec_errors, CELL_GROUPS_T cg, CELL_INFO_T *readings);
+
+/**
+ * @return PEC failures seen on one device since init
+ */
+uint32_t LTC6804Async_GetPECErrors(uint8_t device);
+
+/**
+ * @return modelled state of one device right now
+ */
+LTC6804_DEVICE_STATE_T LTC6804Async_GetDeviceState(uint8_t device, uint32_t msTicks);
+
+void LTC6804Async_GetWakeStats(LTC6804_WAKE_STATS_T *stats);
+
+/**
+ * @return true if commands are still queued or on the wire
+ */
+bool LTC6804Async_IsBusy(void);
+
+#endif
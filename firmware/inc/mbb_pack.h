@@ -0,0 +1,103 @@
+#ifndef __MBB_PACK_H_
+#define __MBB_PACK_H_
+
+#include "chip.h"
+#include "a123mbb.h"
+#include "pack_stats.h"
+
+//--------------------------------------------
+// Pack model assembled from A123 MBB responses. Standard frames carry a
+// module's min/max, temperature and flags; the three extended frames carry
+// four cells each with their balance bits. Every frame is routed by module
+// ID into a fixed record, and the cell and temperature statistics are
+// updated incrementally as values change.
+//
+// Cell voltages of all modules are one module-major array at the front of
+// MBB_PACK_T so telemetry can copy the whole pack, and gauges index it
+// directly as module * MBB_PACK_CELLS + cell.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Configuration Macros
+
+#define MBB_PACK_MAX_MODULES 8
+#define MBB_PACK_CELLS 12 						// Cells per module, 4 in each extended range
+#define MBB_PACK_EXT_RANGES 3
+#define MBB_PACK_TEMP_OFFSET 40 				// Temperature channels hold degC + 40, the MBB's floor
+
+// Module flags
+#define MBB_PACK_OVERVOLT 0x01
+#define MBB_PACK_UNDERVOLT 0x02
+#define MBB_PACK_MISMATCH 0x04
+
+#define MBB_PACK_NEVER 0xFFFFFFFF 				// Age of a module never heard from
+
+// -------------------------------------------------------------
+// Types
+
+typedef struct _MBB_MODULE_T_ {
+	uint32_t std_ms; 							// msTicks of the last standard frame
+	uint32_t ext_ms[MBB_PACK_EXT_RANGES]; 		// msTicks of the last frame of each extended range
+	uint16_t min_mV; 							// Module's own min/max, from the standard frame
+	uint16_t max_mV;
+	int8_t temp_degC;
+	uint8_t temp_chn;
+	uint8_t flags; 								// MBB_PACK_OVERVOLT | MBB_PACK_UNDERVOLT | MBB_PACK_MISMATCH
+	uint8_t balance_count; 						// Cells the module reports balancing
+	uint16_t bal; 								// Balance bit per cell, from the extended frames
+	uint8_t response_id;
+} MBB_MODULE_T;
+
+typedef struct _MBB_PACK_T_ {
+	uint16_t cell_mV[MBB_PACK_MAX_MODULES * MBB_PACK_CELLS]; 	// PACK_STATS_INVALID until read
+	uint16_t temp[MBB_PACK_MAX_MODULES]; 		// degC + MBB_PACK_TEMP_OFFSET
+	MBB_MODULE_T modules[MBB_PACK_MAX_MODULES];
+	PACK_STATS_T cells;
+	PACK_STATS_T temps;
+	uint16_t balancing; 						// Balance bits set across the pack
+	uint16_t overvolt; 							// Modules flagging overvoltage, one bit each
+	uint16_t undervolt;
+	uint8_t first_id; 							// MBB ID of modules[0]
+	uint8_t num_modules;
+	uint32_t frames;
+	uint32_t rejected; 							// Unknown module, range or DLC
+} MBB_PACK_T;
+
+// -------------------------------------------------------------
+// Public Functions
+
+/**
+ * Reset the pack model
+ *
+ * @param first_id MBB ID of the first module, the rest are consecutive
+ * @param num_modules modules in the pack, clamped to MBB_PACK_MAX_MODULES
+ */
+void MBBPack_Init(uint8_t first_id, uint8_t num_modules);
+
+/**
+ * Route one received frame into the pack model
+ *
+ * @param msg received frame
+ * @param msTicks current time
+ * @return true if the frame was an MBB response for a module in the pack
+ */
+bool MBBPack_Receive(CCAN_MSG_OBJ_T *msg, uint32_t msTicks);
+
+/**
+ * @return the whole pack, read only
+ */
+const MBB_PACK_T *MBBPack_Get(void);
+
+/**
+ * @param module index in the pack, not the MBB ID
+ * @return ms since the oldest of the module's standard and extended frames,
+ * MBB_PACK_NEVER if one of them has never arrived
+ */
+uint32_t MBBPack_ModuleAge(uint8_t module, uint32_t msTicks);
+
+/**
+ * Summaries of the cell voltages (mV) and temperatures (degC + MBB_PACK_TEMP_OFFSET)
+ */
+void MBBPack_GetSummary(PACK_SUMMARY_T *cells, PACK_SUMMARY_T *temps);
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef __MBB_POLL_H_
+#define __MBB_POLL_H_
+
+#include "chip.h"
+#include "a123mbb.h"
+
+//--------------------------------------------
+// BCM_CMD polling of the A123 MBBs. A command is broadcast, so one request
+// is complete once every module has answered it. Several requests are kept
+// in flight, each under its own 4-bit request ID; standard responses are
+// matched by response_id and clear that module's bit. Extended responses
+// carry no ID, so only one extended request is outstanding at a time.
+//
+// Requests alternate standard and extended so one pair refreshes the whole
+// pack. The gap between sends follows the measured response latency spread
+// over the pipeline depth, and backs off when requests time out.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Configuration Macros
+
+#define MBB_POLL_DEPTH 3 						// Requests in flight
+#define MBB_POLL_MIN_INTERVAL_MS 5 				// Never send faster than this
+#define MBB_POLL_MAX_INTERVAL_MS 500
+#define MBB_POLL_MIN_TIMEOUT_MS 50
+#define MBB_POLL_TIMEOUT_FACTOR 4 				// Timeout is this many average latencies
+#define MBB_POLL_MEASURE_EVERY 4 				// Every 4th extended request goes out with balancing off
+
+#define MBB_POLL_MAX_MODULES 8
+#define MBB_POLL_EXT_RANGES 3
+
+// -------------------------------------------------------------
+// Types
+
+typedef struct _MBB_POLL_STATS_T_ {
+	uint32_t sent;
+	uint32_t completed;
+	uint32_t timeouts;
+	uint32_t missing; 							// Module responses absent from timed out requests
+	uint32_t send_failed; 						// Transmit refused, retried on the next update
+	uint32_t unmatched; 						// Responses to no request in flight
+	uint16_t latency_avg; 						// ms, send to last response
+	uint16_t latency_max;
+	uint16_t interval; 							// ms, current gap between sends
+	uint16_t refresh_ms; 						// Time between the last two full pack refreshes
+} MBB_POLL_STATS_T;
+
+// -------------------------------------------------------------
+// Public Functions
+
+/**
+ * @param first_id MBB ID of the first module, the rest are consecutive
+ * @param num_modules modules expected to answer, clamped to MBB_POLL_MAX_MODULES
+ * @param send transmits a BCM_CMD frame, returns false if it could not be queued
+ */
+void MBBPoll_Init(uint8_t first_id, uint8_t num_modules, bool (*send)(const CCAN_MSG_OBJ_T *msg));
+
+/**
+ * @param target_mV cells above this are balanced down to it, 0 disables balancing
+ */
+void MBBPoll_SetBalance(uint16_t target_mV);
+
+/**
+ * Expire late requests and send the next one when due. Call every main loop pass.
+ */
+void MBBPoll_Update(uint32_t msTicks);
+
+/**
+ * Match one received frame against the requests in flight
+ *
+ * @return true if it answered one of them
+ */
+bool MBBPoll_Receive(CCAN_MSG_OBJ_T *msg, uint32_t msTicks);
+
+const MBB_POLL_STATS_T *MBBPoll_GetStats(void);
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef __MCP2515_FAST_H_
+#define __MCP2515_FAST_H_
+
+#include "chip.h"
+
+//--------------------------------------------
+// Per-frame MCP2515 traffic on SSP0 using the dedicated SPI instructions.
+// READ STATUS reports every buffer flag in one 2 byte window, READ RX BUFFER
+// skips the address byte and clears RXnIF when CS rises, LOAD TX BUFFER and
+// RTS do the same for transmit. Reset and bit timing still go through the
+// evt_lib driver.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Configuration Macros
+
+#define MCP2515_FAST_FRAME_LEN 14 				// Instruction, 4 ID bytes, DLC, 8 data bytes
+
+// READ STATUS bits
+#define MCP2515_STATUS_RX0IF 0x01
+#define MCP2515_STATUS_RX1IF 0x02
+#define MCP2515_STATUS_TXREQ(buf) (0x04 << ((buf) << 1))
+
+// -------------------------------------------------------------
+// Types
+
+typedef struct _MCP2515_FAST_STATS_T_ {
+	uint32_t frames_rx;
+	uint32_t frames_tx;
+	uint32_t bytes_rx; 							// SPI bytes spent receiving, status polls included
+	uint32_t bytes_tx; 							// SPI bytes spent transmitting
+	uint32_t windows; 							// Chip select windows
+	uint32_t tx_full; 							// Sends refused, all three buffers pending
+} MCP2515_FAST_STATS_T;
+
+// -------------------------------------------------------------
+// Public Functions
+
+/**
+ * @param cs_gpio chip select port
+ * @param cs_pin chip select pin
+ */
+void MCP2515Fast_Init(uint8_t cs_gpio, uint8_t cs_pin);
+
+/**
+ * @return READ STATUS byte, see MCP2515_STATUS_*
+ */
+uint8_t MCP2515Fast_ReadStatus(void);
+
+/**
+ * Read one receive buffer with READ RX BUFFER. Its RXnIF is cleared by the
+ * same window.
+ *
+ * @param buf receive buffer, 0 or 1
+ * @param msg filled with the standard ID, DLC and data
+ */
+void MCP2515Fast_ReadRx(uint8_t buf, CCAN_MSG_OBJ_T *msg);
+
+/**
+ * Read every full receive buffer
+ *
+ * @param msgs room for two frames
+ * @return frames read
+ */
+uint8_t MCP2515Fast_Receive(CCAN_MSG_OBJ_T *msgs);
+
+/**
+ * Load a free transmit buffer and request transmission
+ *
+ * @param msg standard ID frame to send
+ * @return false if all three transmit buffers are pending
+ */
+bool MCP2515Fast_Send(const CCAN_MSG_OBJ_T *msg);
+
+void MCP2515Fast_GetStats(MCP2515_FAST_STATS_T *stats);
+
+void MCP2515Fast_ResetStats(void);
+
+#endif
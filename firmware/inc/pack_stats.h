@@ -0,0 +1,87 @@
+#ifndef __PACK_STATS_H_
+#define __PACK_STATS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//--------------------------------------------
+// Incremental statistics over a set of pack channels (cell voltages or
+// temperatures). Each update adjusts the sum and histogram by the change in
+// one channel. Min/max only need a rescan when the channel holding them moves
+// away from the extreme, and that rescan is deferred until they are asked for.
+//
+// Channels are plain uint16_t in the source's units. Feed LTC6804 groups as
+// PackStats_UpdateGroup(&s, device * 12 + group * 3, cells.groupX, 3) and
+// A123 MBB cell_mVolts the same way with 12 channels per module.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Configuration Macros
+
+#define PACK_STATS_HIST_BINS 8
+#define PACK_STATS_INVALID 0xFFFF 				// Channel not read yet (LTC6804 cleared register value)
+
+// -------------------------------------------------------------
+// Types
+
+typedef struct _PACK_STATS_T_ {
+	uint16_t *values; 							// One entry per channel, owned by the caller
+	uint16_t num_channels;
+	uint16_t count; 							// Channels holding a valid value
+	uint32_t sum;
+	uint16_t min;
+	uint16_t max;
+	uint16_t argmin;
+	uint16_t argmax;
+	bool min_dirty; 							// Extreme moved away, rescan on next read
+	bool max_dirty;
+	uint16_t hist_base; 						// Lower edge of bin 0
+	uint8_t hist_shift; 						// Bin width is 1 << hist_shift
+	uint16_t hist[PACK_STATS_HIST_BINS]; 		// Ends are open, out of range values land in the first/last bin
+	uint32_t rescans; 							// Deferred min/max rescans performed
+} PACK_STATS_T;
+
+/**
+ * Compact snapshot suitable for one UART line or CAN frame
+ */
+typedef struct _PACK_SUMMARY_T_ {
+	uint16_t count;
+	uint16_t min;
+	uint16_t argmin;
+	uint16_t max;
+	uint16_t argmax;
+	uint16_t mean;
+	uint16_t spread; 							// max - min
+} PACK_SUMMARY_T;
+
+// -------------------------------------------------------------
+// Public Functions
+
+/**
+ * Reset the statistics and mark every channel invalid
+ *
+ * @param stats statistics to initialize
+ * @param values backing array of num_channels entries
+ * @param num_channels channels in the set
+ * @param hist_base lower edge of the first histogram bin
+ * @param hist_shift log2 of the histogram bin width
+ */
+void PackStats_Init(PACK_STATS_T *stats, uint16_t *values, uint16_t num_channels, uint16_t hist_base, uint8_t hist_shift);
+
+/**
+ * Set one channel. PACK_STATS_INVALID removes it from the statistics.
+ */
+void PackStats_Update(PACK_STATS_T *stats, uint16_t channel, uint16_t value);
+
+/**
+ * Set a run of consecutive channels, e.g. one LTC6804 voltage group
+ */
+void PackStats_UpdateGroup(PACK_STATS_T *stats, uint16_t first, const uint16_t *values, uint8_t n);
+
+/**
+ * Fill a summary, rescanning min/max first if they are stale. All fields are
+ * zero while no channel is valid.
+ */
+void PackStats_GetSummary(PACK_STATS_T *stats, PACK_SUMMARY_T *summary);
+
+#endif
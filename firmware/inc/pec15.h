@@ -0,0 +1,67 @@
+#ifndef __PEC15_H_
+#define __PEC15_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//--------------------------------------------
+// Table driven PEC15 (CRC-15, polynomial 0x4599, seed 16) used on every
+// LTC6804 command and register group. Replaces the bit-by-bit loop in
+// LTC6804_CalculatePEC.
+//
+// The byte version walks a 512 byte table, one lookup per byte. Define
+// PEC15_NIBBLE_TABLE to use the 32 byte table instead, at two lookups per
+// byte. The unused table is dropped by --gc-sections.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Configuration Macros
+
+#define PEC15_SEED 0x0010
+#define PEC15_LENGTH 2 							// PEC bytes following each command or register group
+
+#ifdef PEC15_NIBBLE_TABLE
+#define PEC15_Calculate PEC15_CalculateNibble
+#else
+#define PEC15_Calculate PEC15_CalculateByte
+#endif
+
+// -------------------------------------------------------------
+// Public Functions
+
+/**
+ * Calculate the PEC of a byte array using the 256 entry table
+ *
+ * @param data bytes to protect
+ * @param len number of bytes
+ * @return PEC, transmitted most significant byte first
+ */
+uint16_t PEC15_CalculateByte(const uint8_t *data, uint8_t len);
+
+/**
+ * Calculate the PEC of a byte array using the 16 entry table
+ *
+ * @param data bytes to protect
+ * @param len number of bytes
+ * @return PEC, transmitted most significant byte first
+ */
+uint16_t PEC15_CalculateNibble(const uint8_t *data, uint8_t len);
+
+/**
+ * Append the PEC of a byte array to the array
+ *
+ * @param data bytes to protect, must have room for PEC15_LENGTH more bytes
+ * @param len number of bytes to protect
+ */
+void PEC15_Append(uint8_t *data, uint8_t len);
+
+/**
+ * Verify received data against the PEC that follows it
+ *
+ * @param data received bytes followed by their PEC (e.g. a 6 byte register group and 2 PEC bytes)
+ * @param len number of bytes before the PEC
+ * @return true if the PEC matches
+ */
+bool PEC15_Check(const uint8_t *data, uint8_t len);
+
+#endif
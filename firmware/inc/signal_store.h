@@ -0,0 +1,84 @@
+#ifndef __SIGNAL_STORE_H_
+#define __SIGNAL_STORE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "can_msgs.h"
+
+//--------------------------------------------
+// Latest value of every signal in can/bcm.dbc. Where a signal lives and how
+// it scales is const data in flash (CANMsgs_Signals and the descriptor
+// tables), only the raw values sit in RAM, packed by width into one
+// CAN_STORE_T. Signals are named by CAN_SIG_ constants that carry the width
+// and slot, so SignalStore_Get(CAN_SIG_MOTOR_STATUS_SPEED_RPM) compiles to a
+// single halfword load from the store.
+//
+// Each message's signals are fresh for SIGNAL_STORE_TIMEOUT_PERIODS of its
+// GenMsgCycleTime after it arrives. Messages sharing a timeout are kept on
+// one list ordered by arrival: a frame moves its message to the tail, and
+// expiry only looks at the heads, so the per-pass check costs one compare
+// per distinct timeout plus one per message that actually expires.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Configuration Macros
+
+#define SIGNAL_STORE_TIMEOUT_PERIODS 3 			// Missed frames before a message goes stale
+
+// -------------------------------------------------------------
+// Types
+
+typedef struct _SIGNAL_STORE_STATS_T_ {
+	uint32_t stored; 							// Frames written into the store
+	uint32_t bad_dlc; 							// Described ID with the wrong length
+	uint32_t unknown; 							// ID not in the description
+	uint32_t expired; 							// Fresh messages that timed out
+} SIGNAL_STORE_STATS_T;
+
+// -------------------------------------------------------------
+// Public Functions
+
+/**
+ * Zero every signal and the statistics, every message starts stale
+ */
+void SignalStore_Init(void);
+
+/**
+ * Store the signals of one received frame and mark its message fresh
+ *
+ * @return true if the frame was described and stored
+ */
+bool SignalStore_Receive(uint16_t id, const uint8_t *data, uint8_t dlc, uint32_t msTicks);
+
+/**
+ * Mark messages stale whose timeout has passed. Call every main loop pass.
+ */
+void SignalStore_Update(uint32_t msTicks);
+
+/**
+ * @param msg CAN_MSG_ index into CANMsgs_Messages
+ * @return true if the message arrived within its timeout. Messages without
+ * a cycle time stay fresh once received.
+ */
+bool SignalStore_IsFresh(uint8_t msg);
+
+/**
+ * @param sig CAN_SIG_ constant
+ * @return the signal's raw value, zero extended
+ */
+#define SignalStore_Get(sig) CANMsgs_Get(SignalStore_Values(), (sig))
+
+/**
+ * @return the packed values, read only
+ */
+const CAN_STORE_T *SignalStore_Values(void);
+
+/**
+ * Raw value of the index'th signal of CANMsgs_Signals, sign extended for
+ * signed signals, for telemetry walking the whole store
+ */
+int32_t SignalStore_GetIndex(uint8_t index);
+
+const SIGNAL_STORE_STATS_T *SignalStore_GetStats(void);
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef __SSP_ASYNC_H_
+#define __SSP_ASYNC_H_
+
+#include "chip.h"
+
+//--------------------------------------------
+// Interrupt driven SSP transactions. Callers queue transfer descriptors and
+// return immediately. The SSP interrupt keeps the FIFOs topped up, drives
+// chip select and runs the completion callback, then starts the next
+// descriptor in the queue.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Configuration Macros
+
+#define SSP_ASYNC_QUEUE_SIZE 8 					// Descriptors that may be queued at once
+#define SSP_ASYNC_FIFO_DEPTH 8 					// SSP TX/RX FIFO depth in frames
+#define SSP_ASYNC_FILL 0xFF 					// Clocked out once tx_data is exhausted
+
+// -------------------------------------------------------------
+// Types
+
+struct _SSP_ASYNC_XFER_T_;
+
+/**
+ * Completion callback, runs in interrupt context
+ */
+typedef void (*SSP_ASYNC_CALLBACK_T)(struct _SSP_ASYNC_XFER_T_ *xfer);
+
+/**
+ * One chip select window. The descriptor is owned by the caller and must stay
+ * valid until its callback has run.
+ */
+typedef struct _SSP_ASYNC_XFER_T_ {
+	const uint8_t *tx_data; 					// Bytes to send, may be NULL
+	uint16_t tx_length; 						// Bytes in tx_data, the rest of the window clocks SSP_ASYNC_FILL
+	uint8_t *rx_data; 							// Receives all length bytes, may be NULL to discard
+	uint16_t length; 							// Total bytes clocked in the window
+	uint8_t cs_port;
+	uint8_t cs_pin;
+	uint8_t repeat; 							// Extra back to back runs of the window, CS released in between
+	SSP_ASYNC_CALLBACK_T callback; 				// May be NULL
+	void *context; 								// Free for the caller
+	volatile bool done; 						// Set when the window has closed
+
+	// Owned by the driver
+	uint16_t tx_cnt;
+	uint16_t rx_cnt;
+	uint8_t repeat_left;
+} SSP_ASYNC_XFER_T;
+
+// -------------------------------------------------------------
+// Public Functions
+
+/**
+ * Attach the transaction layer to an SSP peripheral that has already been
+ * configured (bit rate, format, master mode, enabled)
+ *
+ * @param ssp SSP peripheral
+ * @param irq interrupt of that peripheral
+ */
+void SSP_Async_Init(LPC_SSP_T *ssp, IRQn_Type irq);
+
+/**
+ * Queue a transfer. Starts immediately if the bus is idle.
+ *
+ * @param xfer transfer descriptor
+ * @return false if the queue is full or xfer is already queued, xfer is
+ * then left untouched
+ */
+bool SSP_Async_Submit(SSP_ASYNC_XFER_T *xfer);
+
+/**
+ * @return true if no transfer is active or queued
+ */
+bool SSP_Async_IsIdle(void);
+
+/**
+ * Service the SSP FIFOs. Call from the SSP interrupt handler.
+ */
+void SSP_Async_IRQHandler(void);
+
+#endif
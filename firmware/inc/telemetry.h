@@ -0,0 +1,38 @@
+#ifndef __TELEMETRY_H_
+#define __TELEMETRY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "signal_store.h"
+#include "fault.h"
+#include "warning.h"
+
+//--------------------------------------------
+// Text lines the firmware sends about the car bus. Output goes through the
+// print callback given to Telemetry_Init(), the UART on the board and
+// stdout in tools/replay.c, so a recorded drive replayed on a PC produces
+// exactly the lines the car did.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Public Functions
+
+void Telemetry_Init(void (*print)(const char *str));
+
+/**
+ * One line per signal in the store: CAN ID (hex), signal index within the
+ * frame, raw value, timestamp, 1 if the value is fresh
+ */
+void Telemetry_Signals(uint32_t timestamp);
+
+/**
+ * One line per fault that changed: F, name, 1 if set, severity, timestamp
+ */
+void Telemetry_Faults(FAULT_SET_T changed, uint32_t timestamp);
+
+/**
+ * One line per warning that changed: W, name, 1 if set, raw value, timestamp
+ */
+void Telemetry_Warnings(WARNING_SET_T changed, uint32_t timestamp);
+
+#endif
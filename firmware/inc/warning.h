@@ -0,0 +1,72 @@
+#ifndef __WARNING_H_
+#define __WARNING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "signal_store.h"
+
+//--------------------------------------------
+// Threshold warnings on signals in the signal store. Each rule is const
+// data naming a CAN_SIG_ signal, the raw value the warning sets at and the
+// raw value it clears at, the gap between them being the hysteresis. A rule
+// whose set value is above its clear value is a high limit, otherwise a low
+// limit. Warning_Init() threads the rules into one list per message, so a
+// received frame only evaluates the rules on the signals it just updated.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Types
+
+typedef enum {
+	WARNING_PRECHARGE,
+	WARNING_CELL_LOW,
+	WARNING_CELL_HOT,
+	WARNING_COUNT
+} WARNING_T;
+
+typedef uint8_t WARNING_SET_T; 					// One bit per WARNING_T
+
+#define WARNING_LED0 0x01
+#define WARNING_LED1 0x02
+
+typedef struct _WARNING_RULE_T_ {
+	const char *name;
+	uint16_t sig; 								// CAN_SIG_ constant
+	int32_t set; 								// Raw value the warning sets at
+	int32_t clear; 								// Raw value the warning clears at
+	uint8_t leds; 								// WARNING_LED0, WARNING_LED1
+} WARNING_RULE_T;
+
+#define WARNING_BIT(warning) ((WARNING_SET_T)1 << (warning))
+
+// -------------------------------------------------------------
+// Public Functions
+
+extern const WARNING_RULE_T Warning_Rules[WARNING_COUNT];
+
+/**
+ * Index the rules by message and clear every warning
+ */
+void Warning_Init(void);
+
+/**
+ * Evaluate the rules on a frame's signals, after SignalStore_Receive()
+ * stored it
+ *
+ * @return warnings that changed on this frame
+ */
+WARNING_SET_T Warning_Receive(uint16_t id);
+
+WARNING_SET_T Warning_GetActive(void);
+
+/**
+ * @return WARNING_LED0 and WARNING_LED1 bits of the active warnings
+ */
+uint8_t Warning_GetLeds(void);
+
+/**
+ * @return the value the warning was last evaluated on
+ */
+int32_t Warning_GetValue(WARNING_T warning);
+
+#endif
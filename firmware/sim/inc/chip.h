@@ -0,0 +1,322 @@
+#ifndef __CHIP_H_
+#define __CHIP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+//--------------------------------------------
+// Host stand-in for the parts of the LPCOpen chip layer, CMSIS core and
+// C_CAN ROM API the firmware and evt_lib use. Types and names follow
+// lpc_chip_11cxx_lib so the firmware sources compile unchanged, the bodies
+// live in sim/src/chip_sim.c. Registers are plain memory: what the firmware
+// writes stays there, and only SysTick, SCB->ICSR and SYSRSTSTAT are kept up
+// to date by the simulation.
+//--------------------------------------------
+
+#define TRUE 1
+#define FALSE 0
+
+#define __IO volatile
+#define __I volatile const
+#define __O volatile
+
+// Flash reads go to the simulated flash image, see board.h
+extern uint8_t Sim_Flash[];
+#define BOARD_FLASH_ADDRESS(addr) ((const uint8_t *)Sim_Flash + (addr))
+
+// C_CAN transmission requests come from the ROM API stand-in, see board.h
+uint32_t Sim_CAN_TxRequests(void);
+#define BOARD_CCAN_TXREQ() Sim_CAN_TxRequests()
+
+// -------------------------------------------------------------
+// Core
+
+typedef enum {
+	CAN_IRQn = 13,
+	SSP1_IRQn = 14,
+	SSP0_IRQn = 20,
+	EINT3_IRQn = 28,
+	EINT2_IRQn = 29,
+	EINT1_IRQn = 30,
+	EINT0_IRQn = 31,
+} IRQn_Type;
+
+typedef struct {
+	__IO uint32_t CTRL;
+	__IO uint32_t LOAD;
+	__IO uint32_t VAL;
+	__I uint32_t CALIB;
+} SysTick_Type;
+
+typedef struct {
+	__I uint32_t CPUID;
+	__IO uint32_t ICSR;
+} SCB_Type;
+
+#define SCB_ICSR_PENDSTSET_Msk (1UL << 26)
+
+extern SysTick_Type *SysTick;
+extern SCB_Type *SCB;
+extern uint32_t SystemCoreClock;
+
+void SystemCoreClockUpdate(void);
+uint32_t SysTick_Config(uint32_t ticks);
+void NVIC_EnableIRQ(IRQn_Type irq);
+void NVIC_DisableIRQ(IRQn_Type irq);
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority);
+void __disable_irq(void);
+void __enable_irq(void);
+
+// -------------------------------------------------------------
+// System control and clocks
+
+typedef struct {
+	__IO uint32_t SYSRSTSTAT;
+} LPC_SYSCTL_T;
+
+extern LPC_SYSCTL_T *LPC_SYSCTL;
+
+#define SYSCTL_CLOCK_CAN 17
+
+void Chip_Clock_EnablePeriphClock(uint32_t clk);
+uint32_t Chip_Clock_GetMainClockRate(void);
+uint32_t Chip_Clock_GetSystemClockRate(void);
+
+// -------------------------------------------------------------
+// IOCON
+
+typedef enum {
+	IOCON_PIO2_6, IOCON_PIO2_0, IOCON_PIO0_1, IOCON_PIO1_8, IOCON_PIO0_2, IOCON_PIO2_7,
+	IOCON_PIO2_8, IOCON_PIO2_1, IOCON_PIO0_3, IOCON_PIO0_4, IOCON_PIO0_5, IOCON_PIO1_9,
+	IOCON_PIO3_4, IOCON_PIO2_4, IOCON_PIO2_5, IOCON_PIO3_5, IOCON_PIO0_6, IOCON_PIO0_7,
+	IOCON_PIO2_9, IOCON_PIO2_10, IOCON_PIO2_2, IOCON_PIO0_8, IOCON_PIO0_9, IOCON_PIO0_10,
+	IOCON_PIO1_10, IOCON_PIO2_11, IOCON_PIO0_11, IOCON_PIO1_0, IOCON_PIO1_1, IOCON_PIO1_2,
+	IOCON_PIO3_0, IOCON_PIO3_1, IOCON_PIO2_3, IOCON_PIO1_3, IOCON_PIO1_4, IOCON_PIO1_11,
+	IOCON_PIO3_2, IOCON_PIO1_5, IOCON_PIO1_6, IOCON_PIO1_7, IOCON_PIO3_3,
+	IOCON_NUM_PINS
+} CHIP_IOCON_PIO_T;
+
+typedef enum {
+	IOCON_SCKLOC_PIO0_10, IOCON_SCKLOC_PIO2_11, IOCON_SCKLOC_PIO0_6
+} CHIP_IOCON_PIN_LOC_T;
+
+#define IOCON_FUNC0 0x0
+#define IOCON_FUNC1 0x1
+#define IOCON_FUNC2 0x2
+#define IOCON_FUNC3 0x3
+#define IOCON_MODE_INACT (0x0 << 3)
+#define IOCON_MODE_PULLDOWN (0x1 << 3)
+#define IOCON_MODE_PULLUP (0x2 << 3)
+#define IOCON_DIGMODE_EN (0x1 << 7)
+
+typedef struct {
+	__IO uint32_t PIO[IOCON_NUM_PINS];
+	__IO uint32_t LOC;
+} LPC_IOCON_T;
+
+extern LPC_IOCON_T LPC_IOCON[1];
+
+void Chip_IOCON_PinMuxSet(LPC_IOCON_T *iocon, CHIP_IOCON_PIO_T pin, uint32_t mode);
+void Chip_IOCON_PinLocSel(LPC_IOCON_T *iocon, CHIP_IOCON_PIN_LOC_T sel);
+
+// -------------------------------------------------------------
+// GPIO, one entry per port
+
+typedef struct {
+	__IO uint32_t DATA;
+	__IO uint32_t DIR;
+	__IO uint32_t IS;
+	__IO uint32_t IBE;
+	__IO uint32_t IEV;
+	__IO uint32_t IE;
+	__I uint32_t RIS;
+	__I uint32_t MIS;
+	__O uint32_t IC;
+} LPC_GPIO_T;
+
+typedef enum {
+	GPIO_INT_ACTIVE_LOW_LEVEL,
+	GPIO_INT_ACTIVE_HIGH_LEVEL,
+	GPIO_INT_FALLING_EDGE,
+	GPIO_INT_RISING_EDGE,
+	GPIO_INT_BOTH_EDGES
+} GPIO_INT_MODE_T;
+
+extern LPC_GPIO_T LPC_GPIO[4];
+
+void Chip_GPIO_Init(LPC_GPIO_T *gpio);
+void Chip_GPIO_WriteDirBit(LPC_GPIO_T *gpio, uint32_t port, uint8_t bit, bool output);
+void Chip_GPIO_SetPinState(LPC_GPIO_T *gpio, uint8_t port, uint8_t pin, bool high);
+bool Chip_GPIO_GetPinState(LPC_GPIO_T *gpio, uint8_t port, uint8_t pin);
+void Chip_GPIO_SetupPinInt(LPC_GPIO_T *gpio, uint8_t port, uint8_t pin, GPIO_INT_MODE_T mode);
+void Chip_GPIO_EnableInt(LPC_GPIO_T *gpio, uint8_t port, uint32_t pinmask);
+void Chip_GPIO_ClearInts(LPC_GPIO_T *gpio, uint8_t port, uint32_t pinmask);
+uint32_t Chip_GPIO_GetMaskedInts(LPC_GPIO_T *gpio, uint8_t port);
+
+// -------------------------------------------------------------
+// SSP. Nothing is attached: MISO idles high, so every frame reads 0xFF.
+
+typedef struct {
+	__IO uint32_t CR0;
+	__IO uint32_t CR1;
+	__IO uint32_t DR;
+	__I uint32_t SR;
+	__IO uint32_t CPSR;
+	__IO uint32_t IMSC;
+	__I uint32_t RIS;
+	__I uint32_t MIS;
+	__O uint32_t ICR;
+} LPC_SSP_T;
+
+typedef struct {
+	void *tx_data;
+	uint32_t tx_cnt;
+	void *rx_data;
+	uint32_t rx_cnt;
+	uint32_t length;
+} Chip_SSP_DATA_SETUP_T;
+
+typedef enum {
+	SSP_BITS_4 = 3, SSP_BITS_5, SSP_BITS_6, SSP_BITS_7, SSP_BITS_8,
+	SSP_BITS_9, SSP_BITS_10, SSP_BITS_11, SSP_BITS_12, SSP_BITS_13,
+	SSP_BITS_14, SSP_BITS_15, SSP_BITS_16
+} CHIP_SSP_BITS_T;
+
+typedef enum {
+	SSP_FRAMEFORMAT_SPI = 0 << 4,
+	SSP_FRAMEFORMAT_TI = 1 << 4,
+	SSP_FRAMEFORMAT_MICROWIRE = 2 << 4
+} CHIP_SSP_FRAME_FORMAT_T;
+
+typedef enum {
+	SSP_CLOCK_CPHA0_CPOL0 = 0 << 6,
+	SSP_CLOCK_CPHA0_CPOL1 = 1 << 6,
+	SSP_CLOCK_CPHA1_CPOL0 = 2 << 6,
+	SSP_CLOCK_CPHA1_CPOL1 = 3 << 6,
+	SSP_CLOCK_MODE0 = SSP_CLOCK_CPHA0_CPOL0,
+	SSP_CLOCK_MODE1 = SSP_CLOCK_CPHA1_CPOL0,
+	SSP_CLOCK_MODE2 = SSP_CLOCK_CPHA0_CPOL1,
+	SSP_CLOCK_MODE3 = SSP_CLOCK_CPHA1_CPOL1
+} CHIP_SSP_CLOCK_MODE_T;
+
+#define SSP_STAT_TFE (1 << 0)
+#define SSP_STAT_TNF (1 << 1)
+#define SSP_STAT_RNE (1 << 2)
+#define SSP_STAT_RFF (1 << 3)
+#define SSP_STAT_BSY (1 << 4)
+
+#define SSP_RORIM (1 << 0)
+#define SSP_RTIM (1 << 1)
+#define SSP_RXIM (1 << 2)
+#define SSP_TXIM (1 << 3)
+#define SSP_ICR_BITMASK 0x03
+
+extern LPC_SSP_T LPC_SSP0[1];
+extern LPC_SSP_T LPC_SSP1[1];
+#define LPC_SSP LPC_SSP0 						// evt_lib's MCP2515 driver
+
+void Chip_SSP_Init(LPC_SSP_T *ssp);
+void Chip_SSP_SetBitRate(LPC_SSP_T *ssp, uint32_t bitrate);
+void Chip_SSP_SetFormat(LPC_SSP_T *ssp, uint32_t bits, uint32_t frame_format, uint32_t clock_mode);
+void Chip_SSP_SetMaster(LPC_SSP_T *ssp, bool master);
+void Chip_SSP_Enable(LPC_SSP_T *ssp);
+uint32_t Chip_SSP_WriteFrames_Blocking(LPC_SSP_T *ssp, uint8_t *buffer, uint32_t buffer_len);
+uint32_t Chip_SSP_RWFrames_Blocking(LPC_SSP_T *ssp, Chip_SSP_DATA_SETUP_T *setup);
+
+// -------------------------------------------------------------
+// UART. Output goes to stdout, input comes from stdin.
+
+typedef struct {
+	__IO uint32_t LCR;
+} LPC_USART_T;
+
+extern LPC_USART_T LPC_USART[1];
+
+#define UART_LCR_WLEN8 (3 << 0)
+#define UART_LCR_SBS_1BIT (0 << 2)
+#define UART_LCR_PARITY_DIS (0 << 3)
+#define UART_FCR_FIFO_EN (1 << 0)
+#define UART_FCR_TRG_LEV2 (2 << 6)
+
+void Chip_UART_Init(LPC_USART_T *uart);
+uint32_t Chip_UART_SetBaud(LPC_USART_T *uart, uint32_t baudrate);
+void Chip_UART_ConfigData(LPC_USART_T *uart, uint32_t config);
+void Chip_UART_SetupFIFOS(LPC_USART_T *uart, uint32_t fcr);
+void Chip_UART_TXEnable(LPC_USART_T *uart);
+int Chip_UART_SendBlocking(LPC_USART_T *uart, const void *data, int num_bytes);
+int Chip_UART_Read(LPC_USART_T *uart, void *data, int num_bytes);
+
+// -------------------------------------------------------------
+// Ring buffer, as in LPCOpen's ring_buffer.h
+
+typedef struct {
+	void *data;
+	int count; 									// Power of two
+	int itemSz;
+	uint32_t head;
+	uint32_t tail;
+} RINGBUFF_T;
+
+int RingBuffer_Init(RINGBUFF_T *rb, void *buffer, int itemSize, int count);
+int RingBuffer_Insert(RINGBUFF_T *rb, const void *data);
+int RingBuffer_Pop(RINGBUFF_T *rb, void *data);
+
+static inline void RingBuffer_Flush(RINGBUFF_T *rb) {
+	rb->head = rb->tail = 0;
+}
+
+static inline int RingBuffer_GetCount(RINGBUFF_T *rb) {
+	return (int)(rb->head - rb->tail);
+}
+
+static inline int RingBuffer_IsFull(RINGBUFF_T *rb) {
+	return RingBuffer_GetCount(rb) >= rb->count;
+}
+
+static inline int RingBuffer_IsEmpty(RINGBUFF_T *rb) {
+	return rb->head == rb->tail;
+}
+
+// -------------------------------------------------------------
+// C_CAN ROM API
+
+typedef struct CCAN_MSG_OBJ {
+	uint32_t mode_id;
+	uint32_t mask;
+	union {
+		uint8_t data[8];
+		uint16_t data_16[4];
+		uint32_t data_32[2];
+	};
+	uint8_t dlc;
+	uint8_t msgobj;
+} CCAN_MSG_OBJ_T;
+
+typedef struct CCAN_CALLBACKS {
+	void (*CAN_rx)(uint8_t msg_obj_num);
+	void (*CAN_tx)(uint8_t msg_obj_num);
+	void (*CAN_error)(uint32_t error_info);
+	uint32_t (*CANOPEN_sdo_read)(uint16_t index, uint8_t subindex);
+	uint32_t (*CANOPEN_sdo_write)(uint16_t index, uint8_t subindex, uint8_t *dat_ptr);
+	uint32_t (*CANOPEN_sdo_seg_read)(uint16_t index, uint8_t subindex, uint8_t openclose, uint8_t *length,
+		uint8_t *data, uint8_t *last);
+	uint32_t (*CANOPEN_sdo_seg_write)(uint16_t index, uint8_t subindex, uint8_t openclose, uint8_t length,
+		uint8_t *data, uint8_t *fast_resp);
+	uint8_t (*CANOPEN_sdo_req)(uint8_t length_req, uint8_t *req_ptr, uint8_t *length_resp, uint8_t *resp_ptr);
+} CCAN_CALLBACKS_T;
+
+typedef struct CCAN_API {
+	void (*init_can)(uint32_t *can_cfg, uint8_t isr_ena);
+	void (*isr)(void);
+	void (*config_rxmsgobj)(CCAN_MSG_OBJ_T *msg_obj);
+	uint8_t (*can_receive)(CCAN_MSG_OBJ_T *msg_obj);
+	void (*can_transmit)(CCAN_MSG_OBJ_T *msg_obj);
+	void (*config_canopen)(void *canopen_cfg);
+	void (*canopen_handler)(void);
+	void (*config_calb)(CCAN_CALLBACKS_T *callback_cfg);
+} CCAN_API_T;
+
+extern const CCAN_API_T *LPC_CCAN_API;
+
+#endif
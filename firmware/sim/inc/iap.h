@@ -0,0 +1,22 @@
+#ifndef __IAP_H_
+#define __IAP_H_
+
+#include "chip.h"
+
+//--------------------------------------------
+// Host stand-in for LPCOpen's IAP calls, backed by the Sim_Flash image.
+// Programming can only clear bits, as on the part.
+//--------------------------------------------
+
+#define IAP_CMD_SUCCESS 0
+#define IAP_SRC_ADDR_ERROR 2
+#define IAP_DST_ADDR_ERROR 3
+#define IAP_COUNT_ERROR 6
+#define IAP_INVALID_SECTOR 7
+#define IAP_SECTOR_NOT_PREPARED_FOR_WRITE_OPERATION 9
+
+uint8_t Chip_IAP_PreSectorForReadWrite(uint32_t strSector, uint32_t endSector);
+uint8_t Chip_IAP_CopyRamToFlash(uint32_t dstAdd, uint32_t *srcAdd, uint32_t byteswrt);
+uint8_t Chip_IAP_EraseSector(uint32_t strSector, uint32_t endSector);
+
+#endif
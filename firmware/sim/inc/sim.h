@@ -0,0 +1,112 @@
+#ifndef __SIM_H_
+#define __SIM_H_
+
+#include "chip.h"
+
+//--------------------------------------------
+// Host simulation of the BCM. The firmware runs unchanged on top of the
+// stand-in chip layer in sim/src/chip_sim.c. Time is virtual: it only moves
+// when the firmware polls the UART, waits on a blocking transfer or
+// programs flash, so a run is repeatable and as fast as the PC allows.
+// Interrupts are delivered between those points, never in the middle of
+// firmware code, and a tick that falls while interrupts are masked stays
+// pending like SysTick's PENDSTSET, later ones are lost.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Configuration Macros
+
+#define SIM_CLOCK_HZ 48000000 					// Core clock, as set up by sysinit.c
+#define SIM_FLASH_SIZE 0x8000
+#define SIM_FLASH_SECTOR_SIZE 4096
+#define SIM_ERASE_US 100000 					// IAP sector erase
+#define SIM_PROGRAM_US 1000 					// IAP page program
+#define SIM_STEP_US 50 							// Default time per main loop pass
+#define SIM_DRAIN_MS 1000 						// Run on after the last input frame
+#define SIM_RESET_POR 0x01 						// SYSRSTSTAT after power on
+
+#define SIM_CYCLES_PER_US (SIM_CLOCK_HZ / 1000000)
+
+// -------------------------------------------------------------
+// Firmware entry points, from main.c and board.c
+
+int Firmware_Main(void);
+void SysTick_Handler(void);
+void CAN_IRQHandler(void);
+void SSP1_IRQHandler(void);
+
+// -------------------------------------------------------------
+// Virtual time, sim.c
+
+/**
+ * @return core clock cycles since the simulation started
+ */
+uint64_t Sim_Now(void);
+
+/**
+ * Move time on, then deliver the interrupts that came due unless they are
+ * masked
+ */
+void Sim_Advance(uint64_t cycles);
+
+/**
+ * Deliver due interrupts now, called when interrupts are unmasked
+ */
+void Sim_Dispatch(void);
+
+/**
+ * One main loop pass: advance by the step, end the run once its time is up
+ *
+ * @return next UART byte typed or scripted, -1 if none
+ */
+int Sim_Poll(void);
+
+/**
+ * Hand a frame the firmware sent on the C_CAN to the output recording
+ */
+void Sim_CAN_Transmit(const CCAN_MSG_OBJ_T *msg);
+
+// -------------------------------------------------------------
+// Chip stand-ins, chip_sim.c
+
+extern uint8_t Sim_Flash[SIM_FLASH_SIZE];
+
+/**
+ * @return true if the interrupt is enabled in the NVIC and not masked
+ */
+bool Sim_IRQ_Enabled(IRQn_Type irq);
+
+/**
+ * @return true while __disable_irq is in effect
+ */
+bool Sim_IRQ_Masked(void);
+
+/**
+ * Put a received frame into the first message object whose filter accepts
+ * it, for the next CAN interrupt
+ *
+ * @return false if no receive object accepts the ID
+ */
+bool Sim_CAN_Receive(const CCAN_MSG_OBJ_T *msg);
+
+/**
+ * @return true if received frames or transmit completions await the CAN
+ * interrupt
+ */
+bool Sim_CAN_Pending(void);
+
+/**
+ * @return bit rate set on the SSP, 0 before Chip_SSP_SetBitRate
+ */
+uint32_t Sim_SSP_BitRate(LPC_SSP_T *ssp);
+
+// -------------------------------------------------------------
+// SSP transaction stand-in, ssp_async_sim.c
+
+/**
+ * @return true if the active window has been clocked out and awaits its
+ * interrupt
+ */
+bool Sim_SSP_Async_Due(void);
+
+#endif
@@ -0,0 +1,432 @@
+#include "sim.h"
+#include "iap.h"
+#include <stdio.h>
+#include <string.h>
+
+#define CCAN_MSG_OBJS 32
+#define SSP_FILL 0xFF 							// MISO idles high with nothing attached
+#define UART_BITS_PER_BYTE 10 					// Start, 8 data, stop
+
+static SysTick_Type _systick;
+static SCB_Type _scb;
+static LPC_SYSCTL_T _sysctl;
+
+SysTick_Type *SysTick = &_systick;
+SCB_Type *SCB = &_scb;
+LPC_SYSCTL_T *LPC_SYSCTL = &_sysctl;
+uint32_t SystemCoreClock;
+
+LPC_IOCON_T LPC_IOCON[1];
+LPC_GPIO_T LPC_GPIO[4];
+LPC_SSP_T LPC_SSP0[1];
+LPC_SSP_T LPC_SSP1[1];
+LPC_USART_T LPC_USART[1];
+
+uint8_t Sim_Flash[SIM_FLASH_SIZE];
+
+static uint32_t _nvic_enabled;
+static bool _masked;
+static uint32_t _ssp_bitrate[2];
+static uint32_t _uart_baud;
+static uint32_t _prepared; 						// Sectors prepared by the last IAP prepare
+
+static CCAN_CALLBACKS_T _callbacks;
+static CCAN_MSG_OBJ_T _filters[CCAN_MSG_OBJS]; 	// Receive objects as configured
+static CCAN_MSG_OBJ_T _objs[CCAN_MSG_OBJS]; 	// Last frame each object received
+static uint32_t _rx_configured;
+static uint32_t _rx_pending;
+static uint32_t _tx_pending;
+
+static uint32_t us_to_cycles(uint32_t us) {
+	return us * SIM_CYCLES_PER_US;
+}
+
+// -------------------------------------------------------------
+// Core
+
+void SystemCoreClockUpdate(void) {
+	SystemCoreClock = SIM_CLOCK_HZ;
+}
+
+void NVIC_EnableIRQ(IRQn_Type irq) {
+	_nvic_enabled |= 1UL << irq;
+	Sim_Dispatch();
+}
+
+void NVIC_DisableIRQ(IRQn_Type irq) {
+	_nvic_enabled &= ~(1UL << irq);
+}
+
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority) {
+	(void)irq;
+	(void)priority;
+}
+
+void __disable_irq(void) {
+	_masked = true;
+}
+
+void __enable_irq(void) {
+	_masked = false;
+	Sim_Dispatch();
+}
+
+bool Sim_IRQ_Enabled(IRQn_Type irq) {
+	return !_masked && (_nvic_enabled & (1UL << irq));
+}
+
+bool Sim_IRQ_Masked(void) {
+	return _masked;
+}
+
+// -------------------------------------------------------------
+// Clocks and pins
+
+void Chip_Clock_EnablePeriphClock(uint32_t clk) {
+	(void)clk;
+}
+
+uint32_t Chip_Clock_GetMainClockRate(void) {
+	return SIM_CLOCK_HZ;
+}
+
+uint32_t Chip_Clock_GetSystemClockRate(void) {
+	return SIM_CLOCK_HZ;
+}
+
+void Chip_IOCON_PinMuxSet(LPC_IOCON_T *iocon, CHIP_IOCON_PIO_T pin, uint32_t mode) {
+	iocon->PIO[pin] = mode;
+}
+
+void Chip_IOCON_PinLocSel(LPC_IOCON_T *iocon, CHIP_IOCON_PIN_LOC_T sel) {
+	iocon->LOC = sel;
+}
+
+void Chip_GPIO_Init(LPC_GPIO_T *gpio) {
+	(void)gpio;
+}
+
+void Chip_GPIO_WriteDirBit(LPC_GPIO_T *gpio, uint32_t port, uint8_t bit, bool output) {
+	if (output) gpio[port].DIR |= 1UL << bit;
+	else gpio[port].DIR &= ~(1UL << bit);
+}
+
+void Chip_GPIO_SetPinState(LPC_GPIO_T *gpio, uint8_t port, uint8_t pin, bool high) {
+	if (high) gpio[port].DATA |= 1UL << pin;
+	else gpio[port].DATA &= ~(1UL << pin);
+}
+
+bool Chip_GPIO_GetPinState(LPC_GPIO_T *gpio, uint8_t port, uint8_t pin) {
+	// Inputs float high, nothing drives them
+	if (!(gpio[port].DIR & (1UL << pin))) return true;
+	return (gpio[port].DATA >> pin) & 1;
+}
+
+void Chip_GPIO_SetupPinInt(LPC_GPIO_T *gpio, uint8_t port, uint8_t pin, GPIO_INT_MODE_T mode) {
+	uint32_t bit = 1UL << pin;
+
+	gpio[port].IS = (mode == GPIO_INT_ACTIVE_LOW_LEVEL || mode == GPIO_INT_ACTIVE_HIGH_LEVEL) ?
+		(gpio[port].IS | bit) : (gpio[port].IS & ~bit);
+	gpio[port].IEV = (mode == GPIO_INT_ACTIVE_HIGH_LEVEL || mode == GPIO_INT_RISING_EDGE) ?
+		(gpio[port].IEV | bit) : (gpio[port].IEV & ~bit);
+	gpio[port].IBE = (mode == GPIO_INT_BOTH_EDGES) ? (gpio[port].IBE | bit) : (gpio[port].IBE & ~bit);
+}
+
+void Chip_GPIO_EnableInt(LPC_GPIO_T *gpio, uint8_t port, uint32_t pinmask) {
+	gpio[port].IE |= pinmask;
+}
+
+void Chip_GPIO_ClearInts(LPC_GPIO_T *gpio, uint8_t port, uint32_t pinmask) {
+	gpio[port].IC = pinmask;
+}
+
+uint32_t Chip_GPIO_GetMaskedInts(LPC_GPIO_T *gpio, uint8_t port) {
+	(void)gpio;
+	(void)port;
+	return 0;
+}
+
+// -------------------------------------------------------------
+// SSP
+
+static uint32_t ssp_index(LPC_SSP_T *ssp) {
+	return ssp == LPC_SSP1 ? 1 : 0;
+}
+
+/**
+ * Blocking transfers take as long as the frames take to clock out
+ */
+static void ssp_clock(LPC_SSP_T *ssp, uint32_t frames) {
+	uint32_t rate = _ssp_bitrate[ssp_index(ssp)];
+	if (rate) Sim_Advance((uint64_t)frames * 8 * SIM_CLOCK_HZ / rate);
+}
+
+void Chip_SSP_Init(LPC_SSP_T *ssp) {
+	memset(ssp, 0, sizeof(*ssp));
+}
+
+void Chip_SSP_SetBitRate(LPC_SSP_T *ssp, uint32_t bitrate) {
+	_ssp_bitrate[ssp_index(ssp)] = bitrate;
+}
+
+void Chip_SSP_SetFormat(LPC_SSP_T *ssp, uint32_t bits, uint32_t frame_format, uint32_t clock_mode) {
+	ssp->CR0 = bits | frame_format | clock_mode;
+}
+
+void Chip_SSP_SetMaster(LPC_SSP_T *ssp, bool master) {
+	if (master) ssp->CR1 &= ~(1UL << 2);
+	else ssp->CR1 |= 1UL << 2;
+}
+
+void Chip_SSP_Enable(LPC_SSP_T *ssp) {
+	ssp->CR1 |= 1UL << 1;
+}
+
+uint32_t Chip_SSP_WriteFrames_Blocking(LPC_SSP_T *ssp, uint8_t *buffer, uint32_t buffer_len) {
+	(void)buffer;
+	ssp_clock(ssp, buffer_len);
+	return buffer_len;
+}
+
+uint32_t Chip_SSP_RWFrames_Blocking(LPC_SSP_T *ssp, Chip_SSP_DATA_SETUP_T *setup) {
+	uint32_t n = setup->length - setup->rx_cnt;
+
+	if (setup->rx_data) memset((uint8_t *)setup->rx_data + setup->rx_cnt, SSP_FILL, n);
+	setup->tx_cnt = setup->length;
+	setup->rx_cnt = setup->length;
+	ssp_clock(ssp, n);
+	return setup->length;
+}
+
+uint32_t Sim_SSP_BitRate(LPC_SSP_T *ssp) {
+	return _ssp_bitrate[ssp_index(ssp)];
+}
+
+// -------------------------------------------------------------
+// UART
+
+void Chip_UART_Init(LPC_USART_T *uart) {
+	(void)uart;
+}
+
+uint32_t Chip_UART_SetBaud(LPC_USART_T *uart, uint32_t baudrate) {
+	(void)uart;
+	_uart_baud = baudrate;
+	return baudrate;
+}
+
+void Chip_UART_ConfigData(LPC_USART_T *uart, uint32_t config) {
+	uart->LCR = config;
+}
+
+void Chip_UART_SetupFIFOS(LPC_USART_T *uart, uint32_t fcr) {
+	(void)uart;
+	(void)fcr;
+}
+
+void Chip_UART_TXEnable(LPC_USART_T *uart) {
+	(void)uart;
+}
+
+int Chip_UART_SendBlocking(LPC_USART_T *uart, const void *data, int num_bytes) {
+	(void)uart;
+	fwrite(data, 1, num_bytes, stdout);
+	if (_uart_baud) Sim_Advance((uint64_t)num_bytes * UART_BITS_PER_BYTE * SIM_CLOCK_HZ / _uart_baud);
+	return num_bytes;
+}
+
+/**
+ * The main loop polls this once per pass, which is what moves time on
+ */
+int Chip_UART_Read(LPC_USART_T *uart, void *data, int num_bytes) {
+	int c = Sim_Poll();
+
+	(void)uart;
+	if (c < 0 || num_bytes < 1) return 0;
+	*(uint8_t *)data = c;
+	return 1;
+}
+
+// -------------------------------------------------------------
+// IAP
+
+static bool sector_valid(uint32_t sector) {
+	return sector < SIM_FLASH_SIZE / SIM_FLASH_SECTOR_SIZE;
+}
+
+uint8_t Chip_IAP_PreSectorForReadWrite(uint32_t strSector, uint32_t endSector) {
+	uint32_t i;
+
+	if (strSector > endSector || !sector_valid(endSector)) return IAP_INVALID_SECTOR;
+	for (i = strSector; i <= endSector; i++) _prepared |= 1UL << i;
+	return IAP_CMD_SUCCESS;
+}
+
+uint8_t Chip_IAP_EraseSector(uint32_t strSector, uint32_t endSector) {
+	uint32_t i;
+
+	if (strSector > endSector || !sector_valid(endSector)) return IAP_INVALID_SECTOR;
+	for (i = strSector; i <= endSector; i++) {
+		if (!(_prepared & (1UL << i))) return IAP_SECTOR_NOT_PREPARED_FOR_WRITE_OPERATION;
+	}
+	memset(Sim_Flash + strSector * SIM_FLASH_SECTOR_SIZE, 0xFF, (endSector - strSector + 1) * SIM_FLASH_SECTOR_SIZE);
+	_prepared = 0;
+	Sim_Advance(us_to_cycles(SIM_ERASE_US) * (endSector - strSector + 1));
+	return IAP_CMD_SUCCESS;
+}
+
+uint8_t Chip_IAP_CopyRamToFlash(uint32_t dstAdd, uint32_t *srcAdd, uint32_t byteswrt) {
+	const uint8_t *src = (const uint8_t *)srcAdd;
+	uint32_t i;
+
+	if (dstAdd % 256) return IAP_DST_ADDR_ERROR;
+	if ((uintptr_t)srcAdd % 4) return IAP_SRC_ADDR_ERROR;
+	if (byteswrt != 256 && byteswrt != 512 && byteswrt != 1024 && byteswrt != 4096) return IAP_COUNT_ERROR;
+	if (dstAdd + byteswrt > SIM_FLASH_SIZE) return IAP_DST_ADDR_ERROR;
+	if (!(_prepared & (1UL << (dstAdd / SIM_FLASH_SECTOR_SIZE)))) return IAP_SECTOR_NOT_PREPARED_FOR_WRITE_OPERATION;
+
+	for (i = 0; i < byteswrt; i++) Sim_Flash[dstAdd + i] &= src[i];
+	_prepared = 0;
+	Sim_Advance(us_to_cycles(SIM_PROGRAM_US));
+	return IAP_CMD_SUCCESS;
+}
+
+// -------------------------------------------------------------
+// Ring buffer
+
+int RingBuffer_Init(RINGBUFF_T *rb, void *buffer, int itemSize, int count) {
+	rb->data = buffer;
+	rb->count = count;
+	rb->itemSz = itemSize;
+	rb->head = rb->tail = 0;
+	return 1;
+}
+
+int RingBuffer_Insert(RINGBUFF_T *rb, const void *data) {
+	uint8_t *ptr = rb->data;
+
+	if (RingBuffer_IsFull(rb)) return 0;
+	ptr += (rb->head & (rb->count - 1)) * rb->itemSz;
+	memcpy(ptr, data, rb->itemSz);
+	rb->head++;
+	return 1;
+}
+
+int RingBuffer_Pop(RINGBUFF_T *rb, void *data) {
+	uint8_t *ptr = rb->data;
+
+	if (RingBuffer_IsEmpty(rb)) return 0;
+	ptr += (rb->tail & (rb->count - 1)) * rb->itemSz;
+	memcpy(data, ptr, rb->itemSz);
+	rb->tail++;
+	return 1;
+}
+
+// -------------------------------------------------------------
+// C_CAN ROM API
+
+static void can_init(uint32_t *can_cfg, uint8_t isr_ena) {
+	(void)can_cfg;
+	(void)isr_ena;
+	_rx_configured = 0;
+	_rx_pending = 0;
+	_tx_pending = 0;
+}
+
+/**
+ * Receive callbacks first, in message object order, then transmit ones
+ */
+static void can_isr(void) {
+	uint8_t i;
+
+	for (i = 0; i < CCAN_MSG_OBJS; i++) {
+		if (!(_rx_pending & (1UL << i))) continue;
+		_rx_pending &= ~(1UL << i);
+		if (_callbacks.CAN_rx) _callbacks.CAN_rx(i);
+	}
+	for (i = 0; i < CCAN_MSG_OBJS; i++) {
+		if (!(_tx_pending & (1UL << i))) continue;
+		_tx_pending &= ~(1UL << i);
+		if (_callbacks.CAN_tx) _callbacks.CAN_tx(i);
+	}
+}
+
+static void can_config_rxmsgobj(CCAN_MSG_OBJ_T *msg_obj) {
+	uint8_t n = msg_obj->msgobj % CCAN_MSG_OBJS;
+
+	_filters[n] = *msg_obj;
+	_rx_configured |= 1UL << n;
+}
+
+static uint8_t can_receive(CCAN_MSG_OBJ_T *msg_obj) {
+	uint8_t n = msg_obj->msgobj % CCAN_MSG_OBJS;
+
+	msg_obj->mode_id = _objs[n].mode_id;
+	msg_obj->mask = _filters[n].mask;
+	memcpy(msg_obj->data, _objs[n].data, sizeof(msg_obj->data));
+	msg_obj->dlc = _objs[n].dlc;
+	return 1;
+}
+
+static void can_transmit(CCAN_MSG_OBJ_T *msg_obj) {
+	uint8_t n = msg_obj->msgobj % CCAN_MSG_OBJS;
+
+	// Sending on a receive object reconfigures it, as on the part
+	_rx_configured &= ~(1UL << n);
+	Sim_CAN_Transmit(msg_obj);
+	_tx_pending |= 1UL << n;
+}
+
+static void can_config_canopen(void *canopen_cfg) {
+	(void)canopen_cfg;
+}
+
+static void can_canopen_handler(void) {
+}
+
+static void can_config_calb(CCAN_CALLBACKS_T *callback_cfg) {
+	_callbacks = *callback_cfg;
+}
+
+static const CCAN_API_T _ccan_api = {
+	can_init,
+	can_isr,
+	can_config_rxmsgobj,
+	can_receive,
+	can_transmit,
+	can_config_canopen,
+	can_canopen_handler,
+	can_config_calb,
+};
+
+const CCAN_API_T *LPC_CCAN_API = &_ccan_api;
+
+bool Sim_CAN_Receive(const CCAN_MSG_OBJ_T *msg) {
+	uint8_t i;
+
+	for (i = 0; i < CCAN_MSG_OBJS; i++) {
+		const CCAN_MSG_OBJ_T *filter = &_filters[i];
+		CCAN_MSG_OBJ_T *obj = &_objs[i];
+		if (!(_rx_configured & (1UL << i))) continue;
+		if ((msg->mode_id & filter->mask) != (filter->mode_id & filter->mask)) continue;
+
+		// An unread frame is overwritten by the next, as in message RAM
+		obj->mode_id = msg->mode_id;
+		memcpy(obj->data, msg->data, sizeof(obj->data));
+		obj->dlc = msg->dlc;
+		_rx_pending |= 1UL << i;
+		return true;
+	}
+	return false;
+}
+
+bool Sim_CAN_Pending(void) {
+	return _rx_pending || _tx_pending;
+}
+
+/**
+ * A transmit object stays busy until the CAN interrupt reports it sent
+ */
+uint32_t Sim_CAN_TxRequests(void) {
+	return _tx_pending;
+}
@@ -0,0 +1,297 @@
+//--------------------------------------------
+// Runs the firmware on the PC against the stand-in chip layer, for
+// debugging under sanitizers and profiling the main loop. Car bus frames
+// come from a recording in the format the 'w' command produces (a zero byte
+// then a CANCapture_PackFrame() record, text lines skipped), which may be a
+// file or a pipe, and are delivered at their recorded spacing from the
+// first main loop pass. The UART goes to stdout, and reads stdin. Cycle
+// counts the firmware measures between two waits read 0, see sim.h for what
+// moves time; the profiler is the tool for those.
+//
+// Usage: sim [-i frames] [-o frames] [-t ms] [-s us] [-k keys] [-f flash]
+//   -i  car bus input recording
+//   -o  write the frames the firmware sends on the C_CAN, same format
+//   -t  stop at this virtual time, otherwise SIM_DRAIN_MS after the last
+//       input frame, or never without -i
+//   -s  virtual time per main loop pass, SIM_STEP_US by default
+//   -k  UART input typed at boot, one byte per pass, e.g. -k s for telemetry
+//   -f  flash image, loaded at start and saved at the end, so the event log
+//       carries over between runs
+//
+// The run summary goes to stderr.
+//--------------------------------------------
+
+#include "sim.h"
+#include "can_capture.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+
+// main.c is built with main renamed so this one can drive it
+#undef main
+
+#define CYCLES_PER_MS (SIM_CLOCK_HZ / 1000)
+
+static uint64_t _now;
+static uint64_t _step = SIM_STEP_US * SIM_CYCLES_PER_US;
+static uint64_t _end; 							// 0 runs until the input ends
+static bool _in_handler;
+
+static uint32_t _tick_period; 					// 0 until SysTick_Config
+static uint64_t _next_tick;
+
+static FILE *_in;
+static FILE *_out;
+static const char *_flash_path;
+static const char *_keys = "";
+static uint64_t _next_stdin;
+static bool _stdin_eof;
+
+static bool _started; 							// Input plays from the first main loop pass
+static bool _have_frame;
+static CCAN_MSG_OBJ_T _frame;
+static uint64_t _frame_due;
+static bool _seen; 								// A frame has been read, timestamps are relative to it
+static uint64_t _frame_base;
+static uint32_t _last_us;
+static uint64_t _total_us;
+static unsigned long _frames_in, _frames_unaccepted, _frames_out;
+
+// -------------------------------------------------------------
+// Input and output recordings
+
+/**
+ * Read the next frame of the input recording and work out when it is due
+ *
+ * @return false at the end of the recording
+ */
+static bool read_frame(void) {
+	uint8_t rec[6];
+	uint32_t us;
+	int c;
+
+	while ((c = fgetc(_in)) != EOF && c != 0) {
+		while (c != '\n' && c != EOF) c = fgetc(_in);
+	}
+	if (c == EOF || fread(rec, 1, sizeof(rec), _in) != sizeof(rec)) return false;
+
+	us = rec[0] | (rec[1] << 8) | (rec[2] << 16) | ((uint32_t)rec[3] << 24);
+	_frame.mode_id = rec[4] | ((rec[5] & 0x07) << 8);
+	_frame.dlc = rec[5] >> 3;
+	if (_frame.dlc > 8) {
+		fprintf(stderr, "bad DLC %u, input recording corrupt\n", _frame.dlc);
+		return false;
+	}
+	memset(_frame.data, 0, sizeof(_frame.data));
+	if (fread(_frame.data, 1, _frame.dlc, _in) != _frame.dlc) return false;
+
+	// Timestamps wrap with the uint32_t microseconds, time keeps counting
+	if (!_seen) _last_us = us;
+	_seen = true;
+	_total_us += (uint32_t)(us - _last_us);
+	_last_us = us;
+	_frame_due = _frame_base + _total_us * SIM_CYCLES_PER_US;
+	return true;
+}
+
+static void next_frame(void) {
+	_have_frame = _in && read_frame();
+	if (!_have_frame && _in && !_end) {
+		_end = _now + (uint64_t)SIM_DRAIN_MS * CYCLES_PER_MS;
+	}
+}
+
+void Sim_CAN_Transmit(const CCAN_MSG_OBJ_T *msg) {
+	uint8_t buf[1 + CAN_CAPTURE_RECORD_MAX];
+
+	_frames_out++;
+	if (!_out) return;
+	buf[0] = 0;
+	fwrite(buf, 1, 1 + CANCapture_PackFrame(buf + 1, msg->mode_id, msg->data, msg->dlc,
+		(uint32_t)(_now / SIM_CYCLES_PER_US)), _out);
+}
+
+// -------------------------------------------------------------
+// Virtual time and interrupts
+
+static void update_systick(void) {
+	if (!_tick_period) return;
+
+	// A tick that cannot be taken stays pending once, the rest are lost
+	if (_now >= _next_tick) {
+		SCB->ICSR |= SCB_ICSR_PENDSTSET_Msk;
+		_next_tick += ((_now - _next_tick) / _tick_period + 1) * _tick_period;
+	}
+	SysTick->VAL = (uint32_t)(_next_tick - _now) - 1;
+}
+
+uint32_t SysTick_Config(uint32_t ticks) {
+	_tick_period = ticks;
+	_next_tick = _now + ticks;
+	SysTick->LOAD = ticks - 1;
+	SysTick->VAL = ticks - 1;
+	return 0;
+}
+
+uint64_t Sim_Now(void) {
+	return _now;
+}
+
+void Sim_Dispatch(void) {
+	if (_in_handler || Sim_IRQ_Masked()) return;
+	_in_handler = true;
+
+	update_systick();
+	if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+		SCB->ICSR &= ~SCB_ICSR_PENDSTSET_Msk;
+		SysTick_Handler();
+	}
+
+	// One interrupt per frame, so none is overwritten in its message object
+	while (_have_frame && _frame_due <= _now && Sim_IRQ_Enabled(CAN_IRQn)) {
+		_frames_in++;
+		if (Sim_CAN_Receive(&_frame)) CAN_IRQHandler();
+		else _frames_unaccepted++;
+		next_frame();
+	}
+	if (Sim_CAN_Pending() && Sim_IRQ_Enabled(CAN_IRQn)) CAN_IRQHandler();
+
+	while (Sim_SSP_Async_Due() && Sim_IRQ_Enabled(SSP1_IRQn)) SSP1_IRQHandler();
+
+	_in_handler = false;
+}
+
+void Sim_Advance(uint64_t cycles) {
+	uint64_t end = _now + cycles;
+
+	// Stop at every tick and frame on the way, unless they would wait anyway
+	while (!_in_handler && !Sim_IRQ_Masked()) {
+		uint64_t next = end;
+		if (_tick_period && _next_tick < next) next = _next_tick;
+		if (_have_frame && _frame_due > _now && _frame_due < next) next = _frame_due;
+		_now = next;
+		Sim_Dispatch();
+		if (_now == end) return;
+	}
+	_now = end;
+	update_systick();
+}
+
+// -------------------------------------------------------------
+// Main loop polling
+
+static void finish(void) {
+	double seconds = (double)clock() / CLOCKS_PER_SEC;
+	FILE *f;
+
+	fflush(stdout);
+	if (_out) fclose(_out);
+	if (_flash_path) {
+		if ((f = fopen(_flash_path, "wb")) != NULL) {
+			fwrite(Sim_Flash, 1, SIM_FLASH_SIZE, f);
+			fclose(f);
+		} else {
+			perror(_flash_path);
+		}
+	}
+
+	fprintf(stderr, "%llu ms simulated in %.3f s, frames in:%lu unaccepted:%lu out:%lu\n",
+		(unsigned long long)(_now / CYCLES_PER_MS), seconds, _frames_in, _frames_unaccepted, _frames_out);
+	exit(0);
+}
+
+/**
+ * @return one byte from stdin if one is waiting, looked at once a
+ * millisecond of virtual time
+ */
+static int read_stdin(void) {
+	struct pollfd fd;
+	uint8_t c;
+
+	if (_stdin_eof || _now < _next_stdin) return -1;
+	_next_stdin = _now + CYCLES_PER_MS;
+
+	fd.fd = STDIN_FILENO;
+	fd.events = POLLIN;
+	if (poll(&fd, 1, 0) <= 0) return -1;
+	if (read(STDIN_FILENO, &c, 1) != 1) {
+		_stdin_eof = true;
+		return -1;
+	}
+	return c;
+}
+
+int Sim_Poll(void) {
+	if (!_started) {
+		_started = true;
+		_frame_base = _now;
+		next_frame();
+	}
+
+	Sim_Advance(_step);
+	if (_end && _now >= _end) finish();
+
+	if (*_keys) return (uint8_t)*_keys++;
+	return read_stdin();
+}
+
+// -------------------------------------------------------------
+// Entry
+
+static void usage(const char *name) {
+	fprintf(stderr, "usage: %s [-i frames] [-o frames] [-t ms] [-s us] [-k keys] [-f flash]\n", name);
+	exit(2);
+}
+
+int main(int argc, char *argv[]) {
+	FILE *f;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "i:o:t:s:k:f:")) != -1) {
+		switch (opt) {
+			case 'i':
+				if (!(_in = fopen(optarg, "rb"))) {
+					perror(optarg);
+					return 2;
+				}
+				break;
+			case 'o':
+				if (!(_out = fopen(optarg, "wb"))) {
+					perror(optarg);
+					return 2;
+				}
+				break;
+			case 't':
+				_end = strtoull(optarg, NULL, 0) * CYCLES_PER_MS;
+				break;
+			case 's':
+				_step = strtoull(optarg, NULL, 0) * SIM_CYCLES_PER_US;
+				break;
+			case 'k':
+				_keys = optarg;
+				break;
+			case 'f':
+				_flash_path = optarg;
+				break;
+			default:
+				usage(argv[0]);
+		}
+	}
+	if (optind != argc || !_step) usage(argv[0]);
+
+	memset(Sim_Flash, 0xFF, SIM_FLASH_SIZE);
+	if (_flash_path && (f = fopen(_flash_path, "rb")) != NULL) {
+		if (fread(Sim_Flash, 1, SIM_FLASH_SIZE, f) != SIM_FLASH_SIZE) {
+			fprintf(stderr, "%s: short flash image, rest left erased\n", _flash_path);
+		}
+		fclose(f);
+	}
+	LPC_SYSCTL->SYSRSTSTAT = SIM_RESET_POR;
+
+	Firmware_Main();
+	finish();
+	return 0;
+}
@@ -0,0 +1,107 @@
+#include "ssp_async.h"
+#include "sim.h"
+#include <string.h>
+
+//--------------------------------------------
+// Stands in for src/ssp_async.c, whose FIFO loops spin on SR and DR and so
+// cannot run against plain memory registers. Same queue and callback
+// contract: a window closes in the SSP interrupt once its frames have had
+// time to clock out at the configured bit rate. Nothing is attached, every
+// byte reads back as SSP_ASYNC_FILL.
+//--------------------------------------------
+
+static LPC_SSP_T *_ssp;
+static IRQn_Type _irq;
+
+static SSP_ASYNC_XFER_T *_queue[SSP_ASYNC_QUEUE_SIZE];
+static uint8_t _head;
+static uint8_t _count;
+static bool _active; 							// Head transfer is on the wire
+static uint64_t _window_end; 					// When the active window's last frame is in
+
+static void start(SSP_ASYNC_XFER_T *xfer) {
+	uint32_t rate = Sim_SSP_BitRate(_ssp);
+
+	xfer->tx_cnt = 0;
+	xfer->rx_cnt = 0;
+	_active = true;
+	Chip_GPIO_SetPinState(LPC_GPIO, xfer->cs_port, xfer->cs_pin, false);
+	_window_end = Sim_Now() + (rate ? (uint64_t)xfer->length * 8 * SIM_CLOCK_HZ / rate : 0);
+}
+
+void SSP_Async_Init(LPC_SSP_T *ssp, IRQn_Type irq) {
+	_ssp = ssp;
+	_irq = irq;
+	_head = 0;
+	_count = 0;
+	_active = false;
+	NVIC_EnableIRQ(_irq);
+}
+
+/**
+ * @return true if xfer is active or waiting, call with the interrupt off
+ */
+static bool queued(const SSP_ASYNC_XFER_T *xfer) {
+	uint8_t i;
+
+	for (i = 0; i < _count; i++) {
+		if (_queue[(_head + i) % SSP_ASYNC_QUEUE_SIZE] == xfer) return true;
+	}
+	return false;
+}
+
+bool SSP_Async_Submit(SSP_ASYNC_XFER_T *xfer) {
+	bool ok = true;
+
+	NVIC_DisableIRQ(_irq);
+	// A descriptor left alone keeps its done flag and repeat count
+	if (_count == SSP_ASYNC_QUEUE_SIZE || queued(xfer)) {
+		ok = false;
+	} else {
+		xfer->done = false;
+		xfer->repeat_left = xfer->repeat;
+		_queue[(_head + _count) % SSP_ASYNC_QUEUE_SIZE] = xfer;
+		_count++;
+		// Idle with transfers queued when a completion callback submits, the
+		// oldest goes first
+		if (!_active) start(_queue[_head]);
+	}
+	NVIC_EnableIRQ(_irq);
+
+	return ok;
+}
+
+bool SSP_Async_IsIdle(void) {
+	return _count == 0;
+}
+
+bool Sim_SSP_Async_Due(void) {
+	return _count && Sim_Now() >= _window_end;
+}
+
+void SSP_Async_IRQHandler(void) {
+	SSP_ASYNC_XFER_T *xfer;
+
+	if (!Sim_SSP_Async_Due()) return;
+
+	xfer = _queue[_head];
+	if (xfer->rx_data) memset(xfer->rx_data, SSP_ASYNC_FILL, xfer->length);
+	xfer->tx_cnt = xfer->length;
+	xfer->rx_cnt = xfer->length;
+
+	Chip_GPIO_SetPinState(LPC_GPIO, xfer->cs_port, xfer->cs_pin, true);
+	if (xfer->repeat_left) {
+		xfer->repeat_left--;
+		start(xfer);
+		return;
+	}
+
+	_head = (_head + 1) % SSP_ASYNC_QUEUE_SIZE;
+	_count--;
+	_active = false;
+	xfer->done = true;
+	if (xfer->callback) xfer->callback(xfer);
+
+	// A callback that queued more work has already had Submit start the head
+	if (_count && !_active) start(_queue[_head]);
+}
@@ -0,0 +1,11 @@
+#include "unity_fixture.h"
+
+static void RunAllTests(void) {
+  RUN_TEST_GROUP(SSPAsync_Test);
+  RUN_TEST_GROUP(Gateway_Test);
+  RUN_TEST_GROUP(Charger_Test);
+}
+
+int main(int argc, char * argv[]) {
+  return UnityMain(argc, argv, RunAllTests);
+}
@@ -0,0 +1,241 @@
+#include "charger.h"
+#include "signal_store.h"
+#include "unity.h"
+#include "unity_fixture.h"
+#include <string.h>
+
+// The NLG5 is played through the signal store, the pack through the
+// max_cell callback. Every step's NLG5_CTL is decoded back for checking.
+
+#define NUM_CELLS 96
+#define CC_CAMPS 1200
+#define MAINS_CAMPS 1600
+
+static uint16_t _max_cell;
+static bool _send_ok;
+static uint32_t _sent;
+static CAN_NLG5_CTL_T _ctl; 					// Last NLG5_CTL sent
+static uint32_t _now;
+
+TEST_GROUP(Charger_Test);
+
+static bool send(const CCAN_MSG_OBJ_T *msg) {
+	if (!_send_ok) return false;
+	TEST_ASSERT_EQUAL_HEX16(CAN_NLG5_CTL, msg->mode_id);
+	TEST_ASSERT_EQUAL_INT8(0, CANMsgs_DecodeNLG5Ctl(&_ctl, msg->data, msg->dlc));
+	_sent++;
+	return true;
+}
+
+static uint16_t max_cell(void) {
+	return _max_cell;
+}
+
+static void nlg5_status(bool error_latch) {
+	CAN_NLG5_STATUS_T status;
+	uint8_t data[8];
+
+	memset(&status, 0, sizeof(status));
+	status.power_enabled = true;
+	status.error_latch = error_latch;
+	TEST_ASSERT_TRUE(SignalStore_Receive(CAN_NLG5_STATUS, data, CANMsgs_EncodeNLG5Status(&status, data), _now));
+}
+
+static void nlg5_err(uint32_t errors) {
+	CAN_NLG5_ERR_T err;
+	uint8_t data[8];
+
+	err.errors = errors;
+	err.warnings = 0;
+	TEST_ASSERT_TRUE(SignalStore_Receive(CAN_NLG5_ERR, data, CANMsgs_EncodeNLG5Err(&err, data), _now));
+}
+
+/**
+ * Run control steps with the NLG5 reporting before each, as it does every
+ * 100 ms
+ */
+static void run(uint16_t steps) {
+	while (steps--) {
+		nlg5_status(false);
+		SignalStore_Update(_now);
+		Charger_Update(_now, _now * 48000);
+		_now += CHARGER_PERIOD_MS;
+	}
+}
+
+/**
+ * Run control steps with the NLG5 silent
+ */
+static void run_quiet(uint16_t steps) {
+	while (steps--) {
+		SignalStore_Update(_now);
+		Charger_Update(_now, _now * 48000);
+		_now += CHARGER_PERIOD_MS;
+	}
+}
+
+TEST_SETUP(Charger_Test) {
+	_max_cell = 3400;
+	_send_ok = true;
+	_sent = 0;
+	_now = 0;
+	memset(&_ctl, 0, sizeof(_ctl));
+	SignalStore_Init();
+	Charger_Init(NUM_CELLS, CC_CAMPS, MAINS_CAMPS, send, max_cell);
+}
+
+TEST_TEAR_DOWN(Charger_Test) {
+
+}
+
+TEST(Charger_Test, test_idle) {
+	run(3);
+	TEST_ASSERT_EQUAL(CHARGER_IDLE, Charger_GetState()->mode);
+	TEST_ASSERT_EQUAL_UINT32(3, _sent);
+	TEST_ASSERT_FALSE(_ctl.enable);
+	TEST_ASSERT_EQUAL_UINT16(0, _ctl.output_dA);
+	TEST_ASSERT_EQUAL_UINT16(NUM_CELLS * CHARGER_CELL_CV_MV / 100, _ctl.output_dV);
+	TEST_ASSERT_EQUAL_UINT16(MAINS_CAMPS / 10, _ctl.max_mains_dA);
+}
+
+TEST(Charger_Test, test_cc) {
+	Charger_Start(_now);
+	run(1);
+	TEST_ASSERT_EQUAL(CHARGER_CC, Charger_GetState()->mode);
+	TEST_ASSERT_TRUE(_ctl.enable);
+	TEST_ASSERT_TRUE(_ctl.clear_error);
+	TEST_ASSERT_EQUAL_UINT16(CC_CAMPS / 10, _ctl.output_dA);
+
+	// The error clear is only held through the start
+	run(CHARGER_STALE_MS / CHARGER_PERIOD_MS);
+	TEST_ASSERT_EQUAL(CHARGER_CC, Charger_GetState()->mode);
+	TEST_ASSERT_FALSE(_ctl.clear_error);
+}
+
+TEST(Charger_Test, test_cc_to_cv) {
+	Charger_Start(_now);
+	run(2);
+	_max_cell = CHARGER_CELL_CV_MV - CHARGER_CV_BAND_MV - 1;
+	run(1);
+	TEST_ASSERT_EQUAL(CHARGER_CC, Charger_GetState()->mode);
+
+	// At the band CV takes over and integrates the 50 mV still to go, clamped at the CC current
+	_max_cell = CHARGER_CELL_CV_MV - CHARGER_CV_BAND_MV;
+	run(1);
+	TEST_ASSERT_EQUAL(CHARGER_CV, Charger_GetState()->mode);
+	TEST_ASSERT_EQUAL_UINT16(CC_CAMPS, Charger_GetState()->current_cAmps);
+
+	// Above the CV voltage the setpoint backs off by the gain per mV
+	_max_cell = CHARGER_CELL_CV_MV + 10;
+	run(1);
+	TEST_ASSERT_EQUAL_UINT16(CC_CAMPS - 10 * CHARGER_CV_GAIN, Charger_GetState()->current_cAmps);
+	TEST_ASSERT_EQUAL_UINT16((CC_CAMPS - 10 * CHARGER_CV_GAIN) / 10, _ctl.output_dA);
+
+	// and holds at the CV voltage
+	_max_cell = CHARGER_CELL_CV_MV;
+	run(5);
+	TEST_ASSERT_EQUAL_UINT16(CC_CAMPS - 10 * CHARGER_CV_GAIN, Charger_GetState()->current_cAmps);
+}
+
+TEST(Charger_Test, test_termination) {
+	uint16_t steps = 0;
+
+	Charger_Start(_now);
+	_max_cell = CHARGER_CELL_CV_MV + 50;
+	while (Charger_GetState()->current_cAmps >= CHARGER_TERM_CAMPS || Charger_GetState()->mode == CHARGER_CC) {
+		run(1);
+		TEST_ASSERT_EQUAL(CHARGER_CV, Charger_GetState()->mode);
+		TEST_ASSERT_TRUE(++steps < 100);
+	}
+
+	// The setpoint has to stay under the termination current for the whole count
+	run(CHARGER_TERM_STEPS - 2);
+	TEST_ASSERT_EQUAL(CHARGER_CV, Charger_GetState()->mode);
+	run(1);
+	TEST_ASSERT_EQUAL(CHARGER_DONE, Charger_GetState()->mode);
+	TEST_ASSERT_EQUAL_UINT16(0, Charger_GetState()->current_cAmps);
+	TEST_ASSERT_EQUAL(0, Charger_GetState()->faults);
+
+	run(1);
+	TEST_ASSERT_FALSE(_ctl.enable);
+	TEST_ASSERT_EQUAL_UINT16(0, _ctl.output_dA);
+}
+
+TEST(Charger_Test, test_overvolt) {
+	Charger_Start(_now);
+	run(2);
+	_max_cell = CHARGER_CELL_ABS_MAX_MV;
+	run(1);
+	TEST_ASSERT_EQUAL(CHARGER_FAULT, Charger_GetState()->mode);
+	TEST_ASSERT_EQUAL_HEX8(CHARGER_FAULT_OVERVOLT, Charger_GetState()->faults);
+	TEST_ASSERT_FALSE(_ctl.enable);
+	TEST_ASSERT_EQUAL_UINT16(0, _ctl.output_dA);
+}
+
+TEST(Charger_Test, test_no_cells) {
+	_max_cell = 0;
+	Charger_Start(_now);
+	run(1);
+	TEST_ASSERT_EQUAL(CHARGER_FAULT, Charger_GetState()->mode);
+	TEST_ASSERT_EQUAL_HEX8(CHARGER_FAULT_NO_CELLS, Charger_GetState()->faults);
+	TEST_ASSERT_FALSE(_ctl.enable);
+}
+
+TEST(Charger_Test, test_stale) {
+	Charger_Start(_now);
+	run(1);
+
+	// A quiet NLG5 is tolerated through the start
+	run_quiet(CHARGER_STALE_MS / CHARGER_PERIOD_MS - 1);
+	TEST_ASSERT_EQUAL(CHARGER_CC, Charger_GetState()->mode);
+	run_quiet(1);
+	TEST_ASSERT_EQUAL(CHARGER_FAULT, Charger_GetState()->mode);
+	TEST_ASSERT_EQUAL_HEX8(CHARGER_FAULT_STALE, Charger_GetState()->faults);
+}
+
+TEST(Charger_Test, test_nlg5_error) {
+	Charger_Start(_now);
+	run(CHARGER_STALE_MS / CHARGER_PERIOD_MS);
+	nlg5_err(0x100);
+	run(1);
+	TEST_ASSERT_EQUAL(CHARGER_FAULT, Charger_GetState()->mode);
+	TEST_ASSERT_EQUAL_HEX8(CHARGER_FAULT_NLG5, Charger_GetState()->faults);
+
+	// A restart clears the latch and the ERR bits are not looked at until the grace ends
+	nlg5_err(0);
+	Charger_Start(_now);
+	run(1);
+	TEST_ASSERT_EQUAL(CHARGER_CC, Charger_GetState()->mode);
+}
+
+TEST(Charger_Test, test_error_latch) {
+	Charger_Start(_now);
+	run(CHARGER_STALE_MS / CHARGER_PERIOD_MS);
+	nlg5_status(true);
+	Charger_Update(_now, _now * 48000);
+	TEST_ASSERT_EQUAL(CHARGER_FAULT, Charger_GetState()->mode);
+	TEST_ASSERT_EQUAL_HEX8(CHARGER_FAULT_NLG5, Charger_GetState()->faults);
+}
+
+TEST(Charger_Test, test_send_failed) {
+	_send_ok = false;
+	run(3);
+	TEST_ASSERT_EQUAL_UINT32(3, Charger_GetStats()->send_failed);
+	_send_ok = true;
+	run(1);
+	TEST_ASSERT_EQUAL_UINT32(3, Charger_GetStats()->send_failed);
+	TEST_ASSERT_EQUAL_UINT32(1, _sent);
+}
+
+TEST_GROUP_RUNNER(Charger_Test) {
+	RUN_TEST_CASE(Charger_Test, test_idle);
+	RUN_TEST_CASE(Charger_Test, test_cc);
+	RUN_TEST_CASE(Charger_Test, test_cc_to_cv);
+	RUN_TEST_CASE(Charger_Test, test_termination);
+	RUN_TEST_CASE(Charger_Test, test_overvolt);
+	RUN_TEST_CASE(Charger_Test, test_no_cells);
+	RUN_TEST_CASE(Charger_Test, test_stale);
+	RUN_TEST_CASE(Charger_Test, test_nlg5_error);
+	RUN_TEST_CASE(Charger_Test, test_error_latch);
+	RUN_TEST_CASE(Charger_Test, test_send_failed);
+}
@@ -0,0 +1,67 @@
+#include "can_gateway.h"
+#include "unity.h"
+#include "unity_fixture.h"
+
+// Only the routing table checks, which Gateway_Init makes before it touches
+// the MCP2515.
+
+#define NUM_ROUTES(routes) (sizeof(routes) / sizeof(routes[0]))
+
+TEST_GROUP(Gateway_Test);
+
+static uint8_t init(const GATEWAY_ROUTE_T *routes, uint8_t num_routes) {
+	return Gateway_Init(routes, num_routes, 500, 16, 0, 1, 2, 3);
+}
+
+TEST_SETUP(Gateway_Test) {
+
+}
+
+TEST_TEAR_DOWN(Gateway_Test) {
+
+}
+
+TEST(Gateway_Test, test_reserved_range) {
+	static const GATEWAY_ROUTE_T routes[] = {
+		{0x300, 0x3FF, GATEWAY_CCAN_TO_MCP, 100, 0},
+	};
+	TEST_ASSERT_EQUAL(GATEWAY_ERR_ROUTE, init(routes, NUM_ROUTES(routes)));
+}
+
+TEST(Gateway_Test, test_reserved_edges) {
+	static const GATEWAY_ROUTE_T below[] = {
+		{0x100, 0x1FF, GATEWAY_CCAN_TO_MCP, 0, 0},
+		{0x100, 0x200, GATEWAY_CCAN_TO_MCP, 0, 0},
+	};
+	static const GATEWAY_ROUTE_T above[] = {
+		{0x5FF, 0x6FF, GATEWAY_BOTH, 0, 0},
+	};
+	TEST_ASSERT_EQUAL(GATEWAY_ERR_ROUTE, init(below, NUM_ROUTES(below)));
+	TEST_ASSERT_EQUAL(GATEWAY_ERR_ROUTE, init(above, NUM_ROUTES(above)));
+}
+
+TEST(Gateway_Test, test_reserved_offset) {
+	static const GATEWAY_ROUTE_T into[] = {
+		{0x6F0, 0x6FF, GATEWAY_CCAN_TO_MCP, 0, -0x100},
+	};
+	static const GATEWAY_ROUTE_T wrap[] = {
+		{0x700, 0x7FF, GATEWAY_CCAN_TO_MCP, 0, 0x10},
+	};
+	TEST_ASSERT_EQUAL(GATEWAY_ERR_ROUTE, init(into, NUM_ROUTES(into)));
+	TEST_ASSERT_EQUAL(GATEWAY_ERR_ROUTE, init(wrap, NUM_ROUTES(wrap)));
+}
+
+TEST(Gateway_Test, test_reserved_other_direction) {
+	static const GATEWAY_ROUTE_T routes[] = {
+		{0x200, 0x5FF, GATEWAY_MCP_TO_CCAN, 0, 0},
+		{0x505, 0x505, GATEWAY_CCAN_TO_MCP, 0, 0x100},
+	};
+	TEST_ASSERT_NOT_EQUAL(GATEWAY_ERR_ROUTE, init(routes, NUM_ROUTES(routes)));
+}
+
+TEST_GROUP_RUNNER(Gateway_Test) {
+	RUN_TEST_CASE(Gateway_Test, test_reserved_range);
+	RUN_TEST_CASE(Gateway_Test, test_reserved_edges);
+	RUN_TEST_CASE(Gateway_Test, test_reserved_offset);
+	RUN_TEST_CASE(Gateway_Test, test_reserved_other_direction);
+}
@@ -0,0 +1,168 @@
+#include "ssp_async.h"
+#include "unity.h"
+#include "unity_fixture.h"
+#include <string.h>
+
+// The stand-in SSP has no FIFO behind its registers, so every window here
+// is empty. An empty window closes on its first interrupt, which is all the
+// queue and callback handling needs.
+
+#define CS_PORT 0
+#define NUM_XFERS (SSP_ASYNC_QUEUE_SIZE + 1)
+
+static SSP_ASYNC_XFER_T _xfers[NUM_XFERS];
+static SSP_ASYNC_XFER_T *_order[NUM_XFERS];
+static uint8_t _completed;
+
+TEST_GROUP(SSPAsync_Test);
+
+static void record(SSP_ASYNC_XFER_T *xfer) {
+	_order[_completed++] = xfer;
+}
+
+/**
+ * Completion that queues the descriptor in its context
+ */
+static void record_and_submit(SSP_ASYNC_XFER_T *xfer) {
+	record(xfer);
+	SSP_Async_Submit(xfer->context);
+}
+
+static bool selected(const SSP_ASYNC_XFER_T *xfer) {
+	return !Chip_GPIO_GetPinState(LPC_GPIO, xfer->cs_port, xfer->cs_pin);
+}
+
+TEST_SETUP(SSPAsync_Test) {
+	uint8_t i;
+
+	memset(_xfers, 0, sizeof(_xfers));
+	_completed = 0;
+	for (i = 0; i < NUM_XFERS; i++) {
+		_xfers[i].cs_port = CS_PORT;
+		_xfers[i].cs_pin = i;
+		_xfers[i].callback = record;
+		Chip_GPIO_WriteDirBit(LPC_GPIO, CS_PORT, i, true);
+		Chip_GPIO_SetPinState(LPC_GPIO, CS_PORT, i, true);
+	}
+	SSP_Async_Init(LPC_SSP1, SSP1_IRQn);
+}
+
+TEST_TEAR_DOWN(SSPAsync_Test) {
+
+}
+
+TEST(SSPAsync_Test, test_order) {
+	uint8_t i;
+
+	for (i = 0; i < 3; i++) {
+		TEST_ASSERT_TRUE(SSP_Async_Submit(&_xfers[i]));
+	}
+	for (i = 0; i < 3; i++) {
+		TEST_ASSERT_TRUE(selected(&_xfers[i]));
+		SSP_Async_IRQHandler();
+		TEST_ASSERT_FALSE(selected(&_xfers[i]));
+		TEST_ASSERT_TRUE(_xfers[i].done);
+		TEST_ASSERT_EQUAL_PTR(&_xfers[i], _order[i]);
+	}
+	TEST_ASSERT_TRUE(SSP_Async_IsIdle());
+}
+
+/**
+ * A callback submitting behind queued work must not jump the queue
+ */
+TEST(SSPAsync_Test, test_callback_submits_behind_queue) {
+	_xfers[0].callback = record_and_submit;
+	_xfers[0].context = &_xfers[3];
+	SSP_Async_Submit(&_xfers[0]);
+	SSP_Async_Submit(&_xfers[1]);
+
+	SSP_Async_IRQHandler();
+	TEST_ASSERT_TRUE(selected(&_xfers[1]));
+	TEST_ASSERT_FALSE(selected(&_xfers[3]));
+
+	SSP_Async_IRQHandler();
+	TEST_ASSERT_TRUE(selected(&_xfers[3]));
+	SSP_Async_IRQHandler();
+
+	TEST_ASSERT_EQUAL_UINT8(3, _completed);
+	TEST_ASSERT_EQUAL_PTR(&_xfers[0], _order[0]);
+	TEST_ASSERT_EQUAL_PTR(&_xfers[1], _order[1]);
+	TEST_ASSERT_EQUAL_PTR(&_xfers[3], _order[2]);
+	TEST_ASSERT_TRUE(SSP_Async_IsIdle());
+}
+
+/**
+ * A callback submitting into an empty queue starts the transfer once
+ */
+TEST(SSPAsync_Test, test_callback_submits_into_empty) {
+	_xfers[0].callback = record_and_submit;
+	_xfers[0].context = &_xfers[1];
+	SSP_Async_Submit(&_xfers[0]);
+
+	SSP_Async_IRQHandler();
+	TEST_ASSERT_TRUE(selected(&_xfers[1]));
+	TEST_ASSERT_FALSE(SSP_Async_IsIdle());
+
+	SSP_Async_IRQHandler();
+	TEST_ASSERT_EQUAL_UINT8(2, _completed);
+	TEST_ASSERT_EQUAL_PTR(&_xfers[1], _order[1]);
+	TEST_ASSERT_TRUE(SSP_Async_IsIdle());
+}
+
+TEST(SSPAsync_Test, test_repeat) {
+	_xfers[0].repeat = 2;
+	SSP_Async_Submit(&_xfers[0]);
+
+	SSP_Async_IRQHandler();
+	SSP_Async_IRQHandler();
+	TEST_ASSERT_FALSE(_xfers[0].done);
+	TEST_ASSERT_TRUE(selected(&_xfers[0]));
+	SSP_Async_IRQHandler();
+	TEST_ASSERT_TRUE(_xfers[0].done);
+	TEST_ASSERT_EQUAL_UINT8(1, _completed);
+}
+
+/**
+ * A rejected Submit must not touch the descriptor: a done flag cleared by a
+ * failed Submit would never be set again
+ */
+TEST(SSPAsync_Test, test_submit_full) {
+	SSP_ASYNC_XFER_T *extra = &_xfers[SSP_ASYNC_QUEUE_SIZE];
+	uint8_t i;
+
+	for (i = 0; i < SSP_ASYNC_QUEUE_SIZE; i++) {
+		TEST_ASSERT_TRUE(SSP_Async_Submit(&_xfers[i]));
+	}
+	extra->done = true;
+	extra->repeat = 3;
+	TEST_ASSERT_FALSE(SSP_Async_Submit(extra));
+	TEST_ASSERT_TRUE(extra->done);
+	TEST_ASSERT_EQUAL_UINT8(0, extra->repeat_left);
+}
+
+/**
+ * Submitting a descriptor that is still queued leaves its run alone
+ */
+TEST(SSPAsync_Test, test_submit_queued) {
+	_xfers[0].repeat = 1;
+	SSP_Async_Submit(&_xfers[0]);
+	SSP_Async_IRQHandler();
+	TEST_ASSERT_FALSE(SSP_Async_Submit(&_xfers[0]));
+
+	SSP_Async_IRQHandler();
+	TEST_ASSERT_TRUE(_xfers[0].done);
+	TEST_ASSERT_EQUAL_UINT8(1, _completed);
+	TEST_ASSERT_TRUE(SSP_Async_IsIdle());
+
+	// Once complete it may go again
+	TEST_ASSERT_TRUE(SSP_Async_Submit(&_xfers[0]));
+}
+
+TEST_GROUP_RUNNER(SSPAsync_Test) {
+	RUN_TEST_CASE(SSPAsync_Test, test_order);
+	RUN_TEST_CASE(SSPAsync_Test, test_callback_submits_behind_queue);
+	RUN_TEST_CASE(SSPAsync_Test, test_callback_submits_into_empty);
+	RUN_TEST_CASE(SSPAsync_Test, test_repeat);
+	RUN_TEST_CASE(SSPAsync_Test, test_submit_full);
+	RUN_TEST_CASE(SSPAsync_Test, test_submit_queued);
+}
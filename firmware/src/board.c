@@ -1,4 +1,6 @@
 #include "board.h"
+#include "iap.h"
+#include "ssp_async.h"
 
 
 // -------------------------------------------------------------
@@ -18,6 +20,13 @@ void CAN_IRQHandler(void) {
 	LPC_CCAN_API->isr();
 }
 
+/**
+ * SSP1 Interrupt Handler. Services the queued LTC6804 transactions
+ */
+void SSP1_IRQHandler(void) {
+	SSP_Async_IRQHandler();
+}
+
 // -------------------------------------------------------------
 // Public Functions and Members
 
@@ -33,9 +42,66 @@ int8_t Board_SysTick_Init(void) {
 	return (SysTick_Config (SystemCoreClock / 1000));
 }
 
+uint32_t Board_CycleCount(void) {
+	uint32_t ms, val;
+
+	// Retry if the millisecond tick lands between the two reads
+	do {
+		ms = msTicks;
+		val = SysTick->VAL;
+	} while (ms != msTicks);
+
+	return ms * (SysTick->LOAD + 1) + (SysTick->LOAD - val);
+}
+
+uint32_t Board_Micros(void) {
+	uint32_t ms, val, pending;
+
+	do {
+		ms = msTicks;
+		val = SysTick->VAL;
+		pending = SCB->ICSR & SCB_ICSR_PENDSTSET_Msk;
+	} while (ms != msTicks);
+
+	// Inside a handler the tick cannot run, a wrap shows as a pending tick
+	// with the counter back near the top
+	if (pending && val > SysTick->LOAD / 2) ms++;
+
+	return ms * 1000 + (SysTick->LOAD - val) / (SystemCoreClock / 1000000);
+}
+
+uint32_t Board_ResetCause(void) {
+	uint32_t cause = LPC_SYSCTL->SYSRSTSTAT;
+	LPC_SYSCTL->SYSRSTSTAT = cause;
+	return cause;
+}
+
+bool Board_Flash_Erase(uint8_t sector) {
+	uint8_t res;
+
+	// Flash cannot be read during IAP, so no vector fetches either
+	__disable_irq();
+	res = Chip_IAP_PreSectorForReadWrite(sector, sector);
+	if (res == IAP_CMD_SUCCESS) res = Chip_IAP_EraseSector(sector, sector);
+	__enable_irq();
+	return res == IAP_CMD_SUCCESS;
+}
+
+bool Board_Flash_Program(uint32_t addr, const uint32_t *page) {
+	uint32_t sector = addr / BOARD_FLASH_SECTOR_SIZE;
+	uint8_t res;
+
+	__disable_irq();
+	res = Chip_IAP_PreSectorForReadWrite(sector, sector);
+	if (res == IAP_CMD_SUCCESS) res = Chip_IAP_CopyRamToFlash(addr, (uint32_t *)page, BOARD_FLASH_PAGE_SIZE);
+	__enable_irq();
+	return res == IAP_CMD_SUCCESS;
+}
+
 void Board_LEDs_Init(void) {
 	Chip_GPIO_Init(LPC_GPIO);
 	Chip_GPIO_WriteDirBit(LPC_GPIO, LED0, true);
+	Chip_GPIO_WriteDirBit(LPC_GPIO, LED1, true);
 }
 
 void Board_SPI_Init(void) {
@@ -92,35 +158,11 @@ int8_t Board_UART_Read(void *data, uint8_t num_bytes) {
 	return Chip_UART_Read(LPC_USART, data, num_bytes);
 }
 
-void CAN_baudrate_calculate(uint32_t baud_rate, uint32_t *can_api_timing_cfg)
-{
-	uint32_t pClk, div, quanta, segs, seg1, seg2, clk_per_bit, can_sjw;
-	Chip_Clock_EnablePeriphClock(SYSCTL_CLOCK_CAN);
-	pClk = Chip_Clock_GetMainClockRate();
-
-	clk_per_bit = pClk / baud_rate;
-
-	for (div = 0; div <= 15; div++) {
-		for (quanta = 1; quanta <= 32; quanta++) {
-			for (segs = 3; segs <= 17; segs++) {
-				if (clk_per_bit == (segs * quanta * (div + 1))) {
-					segs -= 3;
-					seg1 = segs / 2;
-					seg2 = segs - seg1;
-					can_sjw = seg1 > 3 ? 3 : seg1;
-					can_api_timing_cfg[0] = div;
-					can_api_timing_cfg[1] =
-						((quanta - 1) & 0x3F) | (can_sjw & 0x03) << 6 | (seg1 & 0x0F) << 8 | (seg2 & 0x07) << 12;
-					return;
-				}
-			}
-		}
-	}
-}
-
-void Board_CAN_Init(uint32_t baudrate, void (*rx_callback)(uint8_t), void (*tx_callback)(uint8_t), void (*error_callback)(uint32_t)) {
+int8_t Board_CAN_Init(uint32_t baudrate, void (*rx_callback)(uint8_t), void (*tx_callback)(uint8_t), void (*error_callback)(uint32_t),
+	CAN_TIMING_T *timing) {
 
 	uint32_t can_api_timing_cfg[2];
+	uint32_t pClk, div;
 	
 	CCAN_CALLBACKS_T callbacks = {
 		rx_callback,
@@ -133,7 +175,20 @@ void Board_CAN_Init(uint32_t baudrate, void (*rx_callback)(uint8_t), void (*tx_c
 		NULL,
 	};
 
-	CAN_baudrate_calculate(baudrate, can_api_timing_cfg);
+	Chip_Clock_EnablePeriphClock(SYSCTL_CLOCK_CAN);
+	pClk = Chip_Clock_GetMainClockRate();
+
+	// CANCLKDIV only comes into play when the 6 bit prescaler runs out
+	for (div = 0; div <= 15; div++) {
+		if (pClk % (div + 1) == 0 &&
+			CANTiming_Solve(pClk / (div + 1), baudrate, CAN_TIMING_SAMPLE_POINT, &CANTiming_CCAN, timing)) {
+			break;
+		}
+	}
+	if (div > 15) return 1;
+
+	can_api_timing_cfg[0] = div;
+	can_api_timing_cfg[1] = CAN_TIMING_CCAN_BTR(timing);
 
 	/* Initialize the CAN controller */
 	LPC_CCAN_API->init_can(&can_api_timing_cfg[0], TRUE);
@@ -142,4 +197,5 @@ void Board_CAN_Init(uint32_t baudrate, void (*rx_callback)(uint8_t), void (*tx_c
 
 	/* Enable the CAN Interrupt */
 	NVIC_EnableIRQ(CAN_IRQn);
+	return 0;
 }
@@ -0,0 +1,98 @@
+#include "can_capture.h"
+
+#define MASK (CAN_CAPTURE_DEPTH - 1)
+
+// The ring indices are uint8_t, so the depth must divide 256
+typedef char DEPTH_CHECK[((CAN_CAPTURE_DEPTH & MASK) == 0 && CAN_CAPTURE_DEPTH <= 128 &&
+	CAN_CAPTURE_POST < CAN_CAPTURE_DEPTH) ? 1 : -1];
+
+static CAN_CAPTURE_FRAME_T _ring[CAN_CAPTURE_DEPTH];
+static volatile uint8_t _state;
+static volatile uint8_t _head; 					// Frames recorded since armed, wraps at 256
+static volatile uint8_t _post_left; 			// Frames left before freezing
+static uint8_t _trigger_head; 					// _head when triggered
+static uint8_t _reason;
+static uint8_t _total; 							// Frames since armed, saturating
+static int16_t _next; 							// Record to pack, -1 for the header
+
+void CANCapture_Arm(void) {
+	_head = 0;
+	_total = 0;
+	_next = -1;
+	_state = CAN_CAPTURE_ARMED;
+}
+
+void CANCapture_Record(uint16_t id, const uint8_t *data, uint8_t dlc, uint32_t us) {
+	CAN_CAPTURE_FRAME_T *frame;
+	uint8_t i;
+
+	if (_state == CAN_CAPTURE_FROZEN) return;
+
+	frame = &_ring[_head & MASK];
+	frame->us = us;
+	frame->id = id;
+	frame->dlc = dlc > 8 ? 8 : dlc;
+	for (i = 0; i < frame->dlc; i++) {
+		frame->data[i] = data[i];
+	}
+	_head++;
+	if (_total < CAN_CAPTURE_DEPTH) _total++;
+
+	if (_state == CAN_CAPTURE_TRIGGERED && --_post_left == 0) _state = CAN_CAPTURE_FROZEN;
+}
+
+void CANCapture_Trigger(uint8_t reason) {
+	if (_state != CAN_CAPTURE_ARMED) return;
+
+	_reason = reason;
+	_trigger_head = _head;
+	_post_left = CAN_CAPTURE_POST;
+	_state = CAN_CAPTURE_POST ? CAN_CAPTURE_TRIGGERED : CAN_CAPTURE_FROZEN;
+}
+
+CAN_CAPTURE_STATE_T CANCapture_GetState(void) {
+	return (CAN_CAPTURE_STATE_T)_state;
+}
+
+uint8_t CANCapture_Pack(uint8_t *buf) {
+	const CAN_CAPTURE_FRAME_T *frame;
+	uint8_t oldest = _head - _total;
+	uint8_t len;
+
+	if (_state != CAN_CAPTURE_FROZEN) return 0;
+
+	if (_next < 0) {
+		buf[0] = 'C';
+		buf[1] = 'P';
+		buf[2] = CAN_CAPTURE_VERSION;
+		buf[3] = _reason;
+		buf[4] = _total;
+		buf[5] = _trigger_head - oldest;
+		_next = 0;
+		if (!_total) CANCapture_Arm();
+		return CAN_CAPTURE_HEADER_SIZE;
+	}
+
+	frame = &_ring[(uint8_t)(oldest + _next) & MASK];
+	len = CANCapture_PackFrame(buf, frame->id, frame->data, frame->dlc, frame->us);
+
+	// The ISR may overwrite the ring as soon as it is re-armed
+	if (++_next >= _total) CANCapture_Arm();
+	return len;
+}
+
+uint8_t CANCapture_PackFrame(uint8_t *buf, uint16_t id, const uint8_t *data, uint8_t dlc, uint32_t us) {
+	uint8_t i;
+
+	if (dlc > 8) dlc = 8;
+	buf[0] = us;
+	buf[1] = us >> 8;
+	buf[2] = us >> 16;
+	buf[3] = us >> 24;
+	buf[4] = id;
+	buf[5] = ((id >> 8) & 0x07) | (dlc << 3);
+	for (i = 0; i < dlc; i++) {
+		buf[6 + i] = data[i];
+	}
+	return 6 + dlc;
+}
@@ -0,0 +1,230 @@
+#include "can_gateway.h"
+#include "board.h"
+#include "mcp2515.h"
+#include "mcp2515_fast.h"
+
+#define MCP2515_RX_INTERRUPTS 0x03 				// CANINTE RX0IE | RX1IE
+
+static const GATEWAY_ROUTE_T *_routes;
+static uint8_t _num_routes;
+static GATEWAY_STATS_T _stats[GATEWAY_MAX_ROUTES];
+static uint32_t _last_forward[GATEWAY_MAX_ROUTES];
+static uint32_t _unrouted[2];
+
+static uint8_t _int_gpio;
+static uint8_t _int_pin;
+static IRQn_Type _int_irq;
+static bool _int_enabled; 						// INT pin interrupt is up, the send functions may hold it off
+static uint8_t _ccan_tx_next;
+static CAN_TIMING_T _timing;
+static void (*_local)(const CCAN_MSG_OBJ_T *msg);
+
+/**
+ * Core clock cycles since start, valid for intervals under one SysTick period
+ */
+static uint32_t cycles_since(uint32_t start) {
+	uint32_t now = SysTick->VAL;
+	return (now <= start) ? start - now : start + (SysTick->LOAD + 1) - now;
+}
+
+static int8_t find_route(uint16_t id, uint8_t dir) {
+	uint8_t i;
+	for (i = 0; i < _num_routes; i++) {
+		const GATEWAY_ROUTE_T *r = &_routes[i];
+		if ((r->dir & dir) && id >= r->id_min && id <= r->id_max) return i;
+	}
+	return -1;
+}
+
+/**
+ * @return true if a C_CAN to MCP2515 route can transmit a reserved ID
+ */
+static bool route_reserved(const GATEWAY_ROUTE_T *r) {
+	int32_t lo = (int32_t)r->id_min + r->id_offset;
+	int32_t hi = (int32_t)r->id_max + r->id_offset;
+
+	if (!(r->dir & GATEWAY_CCAN_TO_MCP)) return false;
+	// The offset ID is masked to 11 bits, a range wrapping past either end reaches everything
+	if (lo < 0 || hi > 0x7FF) return true;
+	return lo <= GATEWAY_MCP_RESERVED_MAX && hi >= GATEWAY_MCP_RESERVED_MIN;
+}
+
+/**
+ * Transmit on the next forwarding object that is not still waiting for the
+ * bus. The ROM driver overwrites a pending object, which would lose its frame.
+ *
+ * @return false if every forwarding object is pending
+ */
+static bool send_ccan(CCAN_MSG_OBJ_T *msg) {
+	uint32_t pending = BOARD_CCAN_TXREQ();
+	uint8_t i, n;
+
+	for (i = 0; i < GATEWAY_CCAN_TX_COUNT; i++) {
+		n = (_ccan_tx_next + i) % GATEWAY_CCAN_TX_COUNT;
+		if (pending & (1UL << (GATEWAY_CCAN_TX_MSGOBJ + n))) continue;
+		msg->msgobj = GATEWAY_CCAN_TX_MSGOBJ + n;
+		_ccan_tx_next = (n + 1) % GATEWAY_CCAN_TX_COUNT;
+		LPC_CCAN_API->can_transmit(msg);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Apply the routing table to one frame and forward it to the far bus
+ */
+static void route(const CCAN_MSG_OBJ_T *msg, uint8_t dir, uint32_t start, uint32_t msTicks) {
+	int8_t r = find_route(msg->mode_id, dir);
+	if (r < 0) {
+		_unrouted[dir == GATEWAY_MCP_TO_CCAN]++;
+		if (dir == GATEWAY_MCP_TO_CCAN && _local) _local(msg);
+		return;
+	}
+
+	const GATEWAY_ROUTE_T *rt = &_routes[r];
+	GATEWAY_STATS_T *st = &_stats[r];
+
+	if (rt->min_interval_ms && st->forwarded && msTicks - _last_forward[r] < rt->min_interval_ms) {
+		st->rate_dropped++;
+		return;
+	}
+
+	CCAN_MSG_OBJ_T out = *msg;
+	out.mode_id = (msg->mode_id + rt->id_offset) & 0x7FF;
+
+	bool sent = (dir == GATEWAY_CCAN_TO_MCP) ? MCP2515Fast_Send(&out) : send_ccan(&out);
+	if (!sent) {
+		st->busy_dropped++;
+		return;
+	}
+
+	uint32_t latency = cycles_since(start);
+	st->forwarded++;
+	st->latency_sum += latency;
+	if (latency > st->latency_max) st->latency_max = latency;
+	_last_forward[r] = msTicks;
+}
+
+uint8_t Gateway_Init(const GATEWAY_ROUTE_T *routes, uint8_t num_routes, uint32_t baud_kHz, uint32_t osc_MHz,
+	uint8_t cs_gpio, uint8_t cs_pin, uint8_t int_gpio, uint8_t int_pin) {
+	uint8_t cnf1, readback, i;
+	IRQn_Type irq = (IRQn_Type)(EINT0_IRQn - int_gpio);
+
+	if (num_routes > GATEWAY_MAX_ROUTES) num_routes = GATEWAY_MAX_ROUTES;
+	_routes = routes;
+	_num_routes = 0;
+	_int_gpio = int_gpio;
+	_int_pin = int_pin;
+	_int_irq = irq;
+	_int_enabled = false;
+	_ccan_tx_next = 0;
+	Gateway_ResetStats();
+	for (i = 0; i < num_routes; i++) {
+		if (route_reserved(&routes[i])) return GATEWAY_ERR_ROUTE;
+	}
+
+	MCP2515_Init(cs_gpio, cs_pin, int_gpio, int_pin);
+	MCP2515_Reset();
+
+	// MCP2515 quanta are two oscillator periods per prescaler step
+	if (!CANTiming_Solve(osc_MHz * 1000000 / 2, baud_kHz * 1000, CAN_TIMING_SAMPLE_POINT,
+		&CANTiming_MCP2515, &_timing)) {
+		return GATEWAY_ERR_TIMING;
+	}
+	cnf1 = CAN_TIMING_MCP2515_CNF1(&_timing);
+	MCP2515_Write(CNF1, cnf1);
+	MCP2515_Write(CNF2, CAN_TIMING_MCP2515_CNF2(&_timing));
+	MCP2515_Write(CNF3, CAN_TIMING_MCP2515_CNF3(&_timing));
+	MCP2515_Write(TXRTSCTRL, 0);
+	MCP2515_Write(CANINTE, MCP2515_RX_INTERRUPTS);
+	MCP2515_Read(CNF1, &readback, 1);
+	if (readback != cnf1) return GATEWAY_ERR_VERIFY;
+
+	MCP2515_Mode(MODE_NORMAL);
+	MCP2515Fast_Init(cs_gpio, cs_pin);
+	_num_routes = num_routes;
+
+	// INT is active low and held until both receive buffers are empty
+	Chip_GPIO_SetupPinInt(LPC_GPIO, int_gpio, int_pin, GPIO_INT_ACTIVE_LOW_LEVEL);
+	Chip_GPIO_EnableInt(LPC_GPIO, int_gpio, 1 << int_pin);
+	NVIC_SetPriority(irq, GATEWAY_IRQ_PRIORITY);
+	NVIC_SetPriority(CAN_IRQn, GATEWAY_IRQ_PRIORITY);
+	NVIC_EnableIRQ(irq);
+	_int_enabled = true;
+
+	return 0;
+}
+
+void Gateway_FromCCAN(const CCAN_MSG_OBJ_T *msg, uint32_t msTicks) {
+	uint32_t start = SysTick->VAL;
+	route(msg, GATEWAY_CCAN_TO_MCP, start, msTicks);
+}
+
+void Gateway_MCP2515_IRQHandler(uint32_t msTicks) {
+	uint32_t start = SysTick->VAL;
+	CCAN_MSG_OBJ_T msgs[2];
+	uint8_t i, n;
+
+	Chip_GPIO_ClearInts(LPC_GPIO, _int_gpio, 1 << _int_pin);
+
+	// READ RX BUFFER clears each RXnIF, releasing INT once both are read
+	n = MCP2515Fast_Receive(msgs);
+	for (i = 0; i < n; i++) {
+		route(&msgs[i], GATEWAY_MCP_TO_CCAN, start, msTicks);
+	}
+}
+
+bool Gateway_SendMCP2515(const CCAN_MSG_OBJ_T *msg) {
+	bool sent;
+
+	// Both gateway interrupts use SSP0, keep them out of this transfer
+	if (_int_enabled) NVIC_DisableIRQ(_int_irq);
+	NVIC_DisableIRQ(CAN_IRQn);
+	sent = MCP2515Fast_Send(msg);
+	NVIC_EnableIRQ(CAN_IRQn);
+	if (_int_enabled) NVIC_EnableIRQ(_int_irq);
+	return sent;
+}
+
+bool Gateway_SendCCAN(CCAN_MSG_OBJ_T *msg) {
+	// A pending object still holds the previous frame, overwriting it would lose that
+	if (BOARD_CCAN_TXREQ() & (1UL << msg->msgobj)) return false;
+
+	if (_int_enabled) NVIC_DisableIRQ(_int_irq);
+	NVIC_DisableIRQ(CAN_IRQn);
+	LPC_CCAN_API->can_transmit(msg);
+	NVIC_EnableIRQ(CAN_IRQn);
+	if (_int_enabled) NVIC_EnableIRQ(_int_irq);
+	return true;
+}
+
+void Gateway_SetLocal(void (*local)(const CCAN_MSG_OBJ_T *msg)) {
+	_local = local;
+}
+
+const CAN_TIMING_T *Gateway_GetTiming(void) {
+	return &_timing;
+}
+
+const GATEWAY_STATS_T *Gateway_GetStats(uint8_t route) {
+	if (route >= _num_routes) return NULL;
+	return &_stats[route];
+}
+
+uint32_t Gateway_GetUnrouted(uint8_t dir) {
+	return _unrouted[dir == GATEWAY_MCP_TO_CCAN];
+}
+
+void Gateway_ResetStats(void) {
+	uint8_t i;
+	for (i = 0; i < GATEWAY_MAX_ROUTES; i++) {
+		_stats[i].forwarded = 0;
+		_stats[i].rate_dropped = 0;
+		_stats[i].busy_dropped = 0;
+		_stats[i].latency_max = 0;
+		_stats[i].latency_sum = 0;
+		_last_forward[i] = 0;
+	}
+	_unrouted[0] = 0;
+	_unrouted[1] = 0;
+}
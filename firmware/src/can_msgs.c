@@ -0,0 +1,824 @@
+// Generated by tools/dbcgen.py from can/bcm.dbc, do not edit.
+// Run make codegen after changing the description.
+
+#include "can_msgs.h"
+#include <stddef.h>
+
+static const CAN_SIGNAL_DESC_T throttle_signals[] = {
+	{"accel_pct", "%", 0, 8, 0, 1, 1, 0},
+	{"brake_pct", "%", 8, 8, 0, 1, 1, 0},
+};
+
+static const CAN_SIGNAL_DESC_T power_status_signals[] = {
+	{"lv_battery_flag", "", 0, 1, 0, 1, 1, 0},
+	{"lv_dcdc_status", "", 1, 1, 0, 1, 1, 0},
+	{"critical_battery_flag", "", 2, 1, 0, 1, 1, 0},
+	{"critical_dcdc_status", "", 3, 1, 0, 1, 1, 0},
+	{"pdm_status", "", 4, 1, 0, 1, 1, 0},
+};
+
+static const CAN_SIGNAL_DESC_T driver_input_signals[] = {
+	{"key_state", "", 0, 16, 0, 1, 1, 0},
+	{"drive_status", "", 16, 16, 0, 1, 1, 0},
+};
+
+static const CAN_SIGNAL_DESC_T contactors_signals[] = {
+	{"contactor_1_error", "", 0, 1, 0, 1, 1, 0},
+	{"contactor_2_error", "", 1, 1, 0, 1, 1, 0},
+	{"contactor_1_status", "", 2, 1, 0, 1, 1, 0},
+	{"contactor_2_status", "", 3, 1, 0, 1, 1, 0},
+	{"lv_contactor_status", "", 4, 1, 0, 1, 1, 0},
+	{"contactor_3_error", "", 5, 1, 0, 1, 1, 0},
+	{"contactor_3_status", "", 6, 1, 0, 1, 1, 0},
+	{"precharge_state", "", 7, 9, 0, 1, 1, 0},
+};
+
+static const CAN_SIGNAL_DESC_T cell_voltages_signals[] = {
+	{"min_cell_mV", "mV", 0, 16, 0, 1, 1, 0},
+	{"max_cell_mV", "mV", 16, 16, 0, 1, 1, 0},
+	{"min_cell_cmu", "", 32, 8, 0, 1, 1, 0},
+	{"min_cell_index", "", 40, 8, 0, 1, 1, 0},
+	{"max_cell_cmu", "", 48, 8, 0, 1, 1, 0},
+	{"max_cell_index", "", 56, 8, 0, 1, 1, 0},
+};
+
+static const CAN_SIGNAL_DESC_T cell_temps_signals[] = {
+	{"min_temp_dC", "C", 0, 16, CAN_SIGNAL_SIGNED, 1, 10, 0},
+	{"max_temp_dC", "C", 16, 16, CAN_SIGNAL_SIGNED, 1, 10, 0},
+	{"min_temp_cmu", "", 32, 8, 0, 1, 1, 0},
+	{"max_temp_cmu", "", 40, 8, 0, 1, 1, 0},
+};
+
+static const CAN_SIGNAL_DESC_T battery_signals[] = {
+	{"voltage_dV", "V", 0, 16, 0, 1, 10, 0},
+	{"current_dA", "A", 16, 16, CAN_SIGNAL_SIGNED, 1, 10, 0},
+};
+
+static const CAN_SIGNAL_DESC_T velocity1_signals[] = {
+	{"speed_rpm", "rpm", 0, 16, 0, 1, 1, 0},
+};
+
+static const CAN_SIGNAL_DESC_T velocity2_signals[] = {
+	{"speed_rpm", "rpm", 0, 16, 0, 1, 1, 0},
+};
+
+static const CAN_SIGNAL_DESC_T motor_status_signals[] = {
+	{"shutdown_ok", "", 0, 16, 0, 1, 1, 0},
+	{"current_dA", "A", 16, 16, CAN_SIGNAL_SIGNED, 1, 10, 0},
+	{"speed_rpm", "rpm", 32, 16, CAN_SIGNAL_SIGNED, 1, 1, 0},
+	{"voltage_dV", "V", 48, 16, 0, 1, 10, 0},
+};
+
+static const CAN_SIGNAL_DESC_T nlg5_status_signals[] = {
+	{"power_enabled", "", 7, 1, CAN_SIGNAL_MOTOROLA, 1, 1, 0},
+	{"error_latch", "", 6, 1, CAN_SIGNAL_MOTOROLA, 1, 1, 0},
+	{"limit_warning", "", 5, 1, CAN_SIGNAL_MOTOROLA, 1, 1, 0},
+	{"fan_active", "", 4, 1, CAN_SIGNAL_MOTOROLA, 1, 1, 0},
+	{"mains_type", "", 3, 3, CAN_SIGNAL_MOTOROLA, 1, 1, 0},
+	{"pilot_detected", "", 0, 1, CAN_SIGNAL_MOTOROLA, 1, 1, 0},
+	{"bypass_detection", "", 15, 2, CAN_SIGNAL_MOTOROLA, 1, 1, 0},
+	{"limitation", "", 12, 13, CAN_SIGNAL_MOTOROLA, 1, 1, 0},
+};
+
+static const CAN_SIGNAL_DESC_T nlg5_act_i_signals[] = {
+	{"mains_cA", "A", 7, 16, CAN_SIGNAL_MOTOROLA, 1, 100, 0},
+	{"mains_dV", "V", 23, 16, CAN_SIGNAL_MOTOROLA, 1, 10, 0},
+	{"output_dV", "V", 39, 16, CAN_SIGNAL_MOTOROLA, 1, 10, 0},
+	{"output_cA", "A", 55, 16, CAN_SIGNAL_MOTOROLA, 1, 100, 0},
+};
+
+static const CAN_SIGNAL_DESC_T nlg5_act_ii_signals[] = {
+	{"mains_max_pilot_dA", "A", 7, 16, CAN_SIGNAL_MOTOROLA, 1, 10, 0},
+	{"mains_max_power_ind_dA", "A", 23, 8, CAN_SIGNAL_MOTOROLA, 1, 10, 0},
+	{"aux_battery_dV", "V", 31, 8, CAN_SIGNAL_MOTOROLA, 1, 10, 0},
+	{"ext_shunt_cAh", "Ah", 39, 16, CAN_SIGNAL_SIGNED | CAN_SIGNAL_MOTOROLA, 1, 100, 0},
+	{"booster_output_cA", "A", 55, 16, CAN_SIGNAL_MOTOROLA, 1, 100, 0},
+};
+
+static const CAN_SIGNAL_DESC_T nlg5_temp_signals[] = {
+	{"power_temp_dC", "C", 7, 16, CAN_SIGNAL_SIGNED | CAN_SIGNAL_MOTOROLA, 1, 10, 0},
+	{"temp_1_dC", "C", 23, 16, CAN_SIGNAL_SIGNED | CAN_SIGNAL_MOTOROLA, 1, 10, 0},
+	{"temp_2_dC", "C", 39, 16, CAN_SIGNAL_SIGNED | CAN_SIGNAL_MOTOROLA, 1, 10, 0},
+	{"temp_3_dC", "C", 55, 16, CAN_SIGNAL_SIGNED | CAN_SIGNAL_MOTOROLA, 1, 10, 0},
+};
+
+static const CAN_SIGNAL_DESC_T nlg5_err_signals[] = {
+	{"errors", "", 0, 32, 0, 1, 1, 0},
+	{"warnings", "", 32, 8, 0, 1, 1, 0},
+};
+
+static const CAN_SIGNAL_DESC_T nlg5_ctl_signals[] = {
+	{"enable", "", 7, 1, CAN_SIGNAL_MOTOROLA, 1, 1, 0},
+	{"clear_error", "", 6, 1, CAN_SIGNAL_MOTOROLA, 1, 1, 0},
+	{"ventilation_request", "", 5, 1, CAN_SIGNAL_MOTOROLA, 1, 1, 0},
+	{"max_mains_dA", "A", 15, 16, CAN_SIGNAL_MOTOROLA, 1, 10, 0},
+	{"output_dV", "V", 31, 16, CAN_SIGNAL_MOTOROLA, 1, 10, 0},
+	{"output_dA", "A", 47, 16, CAN_SIGNAL_MOTOROLA, 1, 10, 0},
+};
+
+const CAN_MSG_DESC_T CANMsgs_Messages[CAN_MSGS_COUNT] = {
+	{"Throttle", CAN_THROTTLE, CAN_THROTTLE_DLC, 2, 20, throttle_signals},
+	{"PowerStatus", CAN_POWER_STATUS, CAN_POWER_STATUS_DLC, 5, 100, power_status_signals},
+	{"DriverInput", CAN_DRIVER_INPUT, CAN_DRIVER_INPUT_DLC, 2, 100, driver_input_signals},
+	{"Contactors", CAN_CONTACTORS, CAN_CONTACTORS_DLC, 8, 100, contactors_signals},
+	{"CellVoltages", CAN_CELL_VOLTAGES, CAN_CELL_VOLTAGES_DLC, 6, 200, cell_voltages_signals},
+	{"CellTemps", CAN_CELL_TEMPS, CAN_CELL_TEMPS_DLC, 4, 1000, cell_temps_signals},
+	{"Battery", CAN_BATTERY, CAN_BATTERY_DLC, 2, 100, battery_signals},
+	{"Velocity1", CAN_VELOCITY1, CAN_VELOCITY1_DLC, 1, 50, velocity1_signals},
+	{"Velocity2", CAN_VELOCITY2, CAN_VELOCITY2_DLC, 1, 50, velocity2_signals},
+	{"MotorStatus", CAN_MOTOR_STATUS, CAN_MOTOR_STATUS_DLC, 4, 50, motor_status_signals},
+	{"NLG5Status", CAN_NLG5_STATUS, CAN_NLG5_STATUS_DLC, 8, 100, nlg5_status_signals},
+	{"NLG5ActI", CAN_NLG5_ACT_I, CAN_NLG5_ACT_I_DLC, 4, 100, nlg5_act_i_signals},
+	{"NLG5ActII", CAN_NLG5_ACT_II, CAN_NLG5_ACT_II_DLC, 5, 100, nlg5_act_ii_signals},
+	{"NLG5Temp", CAN_NLG5_TEMP, CAN_NLG5_TEMP_DLC, 4, 100, nlg5_temp_signals},
+	{"NLG5Err", CAN_NLG5_ERR, CAN_NLG5_ERR_DLC, 2, 100, nlg5_err_signals},
+	{"NLG5Ctl", CAN_NLG5_CTL, CAN_NLG5_CTL_DLC, 6, 100, nlg5_ctl_signals},
+};
+
+const CAN_MSG_DESC_T *CANMsgs_Find(uint16_t id) {
+	switch (id) {
+		case CAN_THROTTLE: return &CANMsgs_Messages[0];
+		case CAN_POWER_STATUS: return &CANMsgs_Messages[1];
+		case CAN_DRIVER_INPUT: return &CANMsgs_Messages[2];
+		case CAN_CONTACTORS: return &CANMsgs_Messages[3];
+		case CAN_CELL_VOLTAGES: return &CANMsgs_Messages[4];
+		case CAN_CELL_TEMPS: return &CANMsgs_Messages[5];
+		case CAN_BATTERY: return &CANMsgs_Messages[6];
+		case CAN_VELOCITY1: return &CANMsgs_Messages[7];
+		case CAN_VELOCITY2: return &CANMsgs_Messages[8];
+		case CAN_MOTOR_STATUS: return &CANMsgs_Messages[9];
+		case CAN_NLG5_STATUS: return &CANMsgs_Messages[10];
+		case CAN_NLG5_ACT_I: return &CANMsgs_Messages[11];
+		case CAN_NLG5_ACT_II: return &CANMsgs_Messages[12];
+		case CAN_NLG5_TEMP: return &CANMsgs_Messages[13];
+		case CAN_NLG5_ERR: return &CANMsgs_Messages[14];
+		case CAN_NLG5_CTL: return &CANMsgs_Messages[15];
+		default: return NULL;
+	}
+}
+
+int8_t CANMsgs_DecodeThrottle(CAN_THROTTLE_T *msg, const uint8_t *data, uint8_t dlc) {
+	if (dlc != CAN_THROTTLE_DLC) return -1;
+
+	msg->accel_pct = data[0];
+	msg->brake_pct = data[1];
+	return 0;
+}
+
+uint8_t CANMsgs_EncodeThrottle(const CAN_THROTTLE_T *msg, uint8_t *data) {
+	data[0] = 0;
+	data[1] = 0;
+
+	data[0] |= (uint8_t)msg->accel_pct;
+	data[1] |= (uint8_t)msg->brake_pct;
+	return CAN_THROTTLE_DLC;
+}
+
+int8_t CANMsgs_DecodePowerStatus(CAN_POWER_STATUS_T *msg, const uint8_t *data, uint8_t dlc) {
+	if (dlc != CAN_POWER_STATUS_DLC) return -1;
+
+	msg->lv_battery_flag = (data[0] & 0x1) != 0;
+	msg->lv_dcdc_status = ((data[0] >> 1) & 0x1) != 0;
+	msg->critical_battery_flag = ((data[0] >> 2) & 0x1) != 0;
+	msg->critical_dcdc_status = ((data[0] >> 3) & 0x1) != 0;
+	msg->pdm_status = ((data[0] >> 4) & 0x1) != 0;
+	return 0;
+}
+
+uint8_t CANMsgs_EncodePowerStatus(const CAN_POWER_STATUS_T *msg, uint8_t *data) {
+	data[0] = 0;
+
+	data[0] |= (uint8_t)msg->lv_battery_flag;
+	data[0] |= (uint8_t)((uint8_t)msg->lv_dcdc_status << 1);
+	data[0] |= (uint8_t)((uint8_t)msg->critical_battery_flag << 2);
+	data[0] |= (uint8_t)((uint8_t)msg->critical_dcdc_status << 3);
+	data[0] |= (uint8_t)((uint8_t)msg->pdm_status << 4);
+	return CAN_POWER_STATUS_DLC;
+}
+
+int8_t CANMsgs_DecodeDriverInput(CAN_DRIVER_INPUT_T *msg, const uint8_t *data, uint8_t dlc) {
+	if (dlc != CAN_DRIVER_INPUT_DLC) return -1;
+
+	msg->key_state = (uint16_t)(data[0] | ((uint16_t)data[1] << 8));
+	msg->drive_status = (uint16_t)(data[2] | ((uint16_t)data[3] << 8));
+	return 0;
+}
+
+uint8_t CANMsgs_EncodeDriverInput(const CAN_DRIVER_INPUT_T *msg, uint8_t *data) {
+	data[0] = 0;
+	data[1] = 0;
+	data[2] = 0;
+	data[3] = 0;
+
+	data[0] |= (uint8_t)msg->key_state;
+	data[1] |= (uint8_t)((uint16_t)msg->key_state >> 8);
+	data[2] |= (uint8_t)msg->drive_status;
+	data[3] |= (uint8_t)((uint16_t)msg->drive_status >> 8);
+	return CAN_DRIVER_INPUT_DLC;
+}
+
+int8_t CANMsgs_DecodeContactors(CAN_CONTACTORS_T *msg, const uint8_t *data, uint8_t dlc) {
+	if (dlc != CAN_CONTACTORS_DLC) return -1;
+
+	msg->contactor_1_error = (data[0] & 0x1) != 0;
+	msg->contactor_2_error = ((data[0] >> 1) & 0x1) != 0;
+	msg->contactor_1_status = ((data[0] >> 2) & 0x1) != 0;
+	msg->contactor_2_status = ((data[0] >> 3) & 0x1) != 0;
+	msg->lv_contactor_status = ((data[0] >> 4) & 0x1) != 0;
+	msg->contactor_3_error = ((data[0] >> 5) & 0x1) != 0;
+	msg->contactor_3_status = ((data[0] >> 6) & 0x1) != 0;
+	msg->precharge_state = (uint16_t)((data[0] >> 7) | ((uint16_t)data[1] << 1));
+	return 0;
+}
+
+uint8_t CANMsgs_EncodeContactors(const CAN_CONTACTORS_T *msg, uint8_t *data) {
+	data[0] = 0;
+	data[1] = 0;
+
+	data[0] |= (uint8_t)msg->contactor_1_error;
+	data[0] |= (uint8_t)((uint8_t)msg->contactor_2_error << 1);
+	data[0] |= (uint8_t)((uint8_t)msg->contactor_1_status << 2);
+	data[0] |= (uint8_t)((uint8_t)msg->contactor_2_status << 3);
+	data[0] |= (uint8_t)((uint8_t)msg->lv_contactor_status << 4);
+	data[0] |= (uint8_t)((uint8_t)msg->contactor_3_error << 5);
+	data[0] |= (uint8_t)((uint8_t)msg->contactor_3_status << 6);
+	data[0] |= (uint8_t)((uint16_t)msg->precharge_state << 7);
+	data[1] |= (uint8_t)((uint16_t)msg->precharge_state >> 1);
+	return CAN_CONTACTORS_DLC;
+}
+
+int8_t CANMsgs_DecodeCellVoltages(CAN_CELL_VOLTAGES_T *msg, const uint8_t *data, uint8_t dlc) {
+	if (dlc != CAN_CELL_VOLTAGES_DLC) return -1;
+
+	msg->min_cell_mV = (uint16_t)(data[0] | ((uint16_t)data[1] << 8));
+	msg->max_cell_mV = (uint16_t)(data[2] | ((uint16_t)data[3] << 8));
+	msg->min_cell_cmu = data[4];
+	msg->min_cell_index = data[5];
+	msg->max_cell_cmu = data[6];
+	msg->max_cell_index = data[7];
+	return 0;
+}
+
+uint8_t CANMsgs_EncodeCellVoltages(const CAN_CELL_VOLTAGES_T *msg, uint8_t *data) {
+	data[0] = 0;
+	data[1] = 0;
+	data[2] = 0;
+	data[3] = 0;
+	data[4] = 0;
+	data[5] = 0;
+	data[6] = 0;
+	data[7] = 0;
+
+	data[0] |= (uint8_t)msg->min_cell_mV;
+	data[1] |= (uint8_t)((uint16_t)msg->min_cell_mV >> 8);
+	data[2] |= (uint8_t)msg->max_cell_mV;
+	data[3] |= (uint8_t)((uint16_t)msg->max_cell_mV >> 8);
+	data[4] |= (uint8_t)msg->min_cell_cmu;
+	data[5] |= (uint8_t)msg->min_cell_index;
+	data[6] |= (uint8_t)msg->max_cell_cmu;
+	data[7] |= (uint8_t)msg->max_cell_index;
+	return CAN_CELL_VOLTAGES_DLC;
+}
+
+int8_t CANMsgs_DecodeCellTemps(CAN_CELL_TEMPS_T *msg, const uint8_t *data, uint8_t dlc) {
+	if (dlc != CAN_CELL_TEMPS_DLC) return -1;
+
+	msg->min_temp_dC = (int16_t)(uint16_t)(data[0] | ((uint16_t)data[1] << 8));
+	msg->max_temp_dC = (int16_t)(uint16_t)(data[2] | ((uint16_t)data[3] << 8));
+	msg->min_temp_cmu = data[4];
+	msg->max_temp_cmu = data[5];
+	return 0;
+}
+
+uint8_t CANMsgs_EncodeCellTemps(const CAN_CELL_TEMPS_T *msg, uint8_t *data) {
+	data[0] = 0;
+	data[1] = 0;
+	data[2] = 0;
+	data[3] = 0;
+	data[4] = 0;
+	data[5] = 0;
+
+	data[0] |= (uint8_t)msg->min_temp_dC;
+	data[1] |= (uint8_t)((uint16_t)msg->min_temp_dC >> 8);
+	data[2] |= (uint8_t)msg->max_temp_dC;
+	data[3] |= (uint8_t)((uint16_t)msg->max_temp_dC >> 8);
+	data[4] |= (uint8_t)msg->min_temp_cmu;
+	data[5] |= (uint8_t)msg->max_temp_cmu;
+	return CAN_CELL_TEMPS_DLC;
+}
+
+int8_t CANMsgs_DecodeBattery(CAN_BATTERY_T *msg, const uint8_t *data, uint8_t dlc) {
+	if (dlc != CAN_BATTERY_DLC) return -1;
+
+	msg->voltage_dV = (uint16_t)(data[0] | ((uint16_t)data[1] << 8));
+	msg->current_dA = (int16_t)(uint16_t)(data[2] | ((uint16_t)data[3] << 8));
+	return 0;
+}
+
+uint8_t CANMsgs_EncodeBattery(const CAN_BATTERY_T *msg, uint8_t *data) {
+	data[0] = 0;
+	data[1] = 0;
+	data[2] = 0;
+	data[3] = 0;
+
+	data[0] |= (uint8_t)msg->voltage_dV;
+	data[1] |= (uint8_t)((uint16_t)msg->voltage_dV >> 8);
+	data[2] |= (uint8_t)msg->current_dA;
+	data[3] |= (uint8_t)((uint16_t)msg->current_dA >> 8);
+	return CAN_BATTERY_DLC;
+}
+
+int8_t CANMsgs_DecodeVelocity1(CAN_VELOCITY1_T *msg, const uint8_t *data, uint8_t dlc) {
+	if (dlc != CAN_VELOCITY1_DLC) return -1;
+
+	msg->speed_rpm = (uint16_t)(data[0] | ((uint16_t)data[1] << 8));
+	return 0;
+}
+
+uint8_t CANMsgs_EncodeVelocity1(const CAN_VELOCITY1_T *msg, uint8_t *data) {
+	data[0] = 0;
+	data[1] = 0;
+
+	data[0] |= (uint8_t)msg->speed_rpm;
+	data[1] |= (uint8_t)((uint16_t)msg->speed_rpm >> 8);
+	return CAN_VELOCITY1_DLC;
+}
+
+int8_t CANMsgs_DecodeVelocity2(CAN_VELOCITY2_T *msg, const uint8_t *data, uint8_t dlc) {
+	if (dlc != CAN_VELOCITY2_DLC) return -1;
+
+	msg->speed_rpm = (uint16_t)(data[0] | ((uint16_t)data[1] << 8));
+	return 0;
+}
+
+uint8_t CANMsgs_EncodeVelocity2(const CAN_VELOCITY2_T *msg, uint8_t *data) {
+	data[0] = 0;
+	data[1] = 0;
+
+	data[0] |= (uint8_t)msg->speed_rpm;
+	data[1] |= (uint8_t)((uint16_t)msg->speed_rpm >> 8);
+	return CAN_VELOCITY2_DLC;
+}
+
+int8_t CANMsgs_DecodeMotorStatus(CAN_MOTOR_STATUS_T *msg, const uint8_t *data, uint8_t dlc) {
+	if (dlc != CAN_MOTOR_STATUS_DLC) return -1;
+
+	msg->shutdown_ok = (uint16_t)(data[0] | ((uint16_t)data[1] << 8));
+	msg->current_dA = (int16_t)(uint16_t)(data[2] | ((uint16_t)data[3] << 8));
+	msg->speed_rpm = (int16_t)(uint16_t)(data[4] | ((uint16_t)data[5] << 8));
+	msg->voltage_dV = (uint16_t)(data[6] | ((uint16_t)data[7] << 8));
+	return 0;
+}
+
+uint8_t CANMsgs_EncodeMotorStatus(const CAN_MOTOR_STATUS_T *msg, uint8_t *data) {
+	data[0] = 0;
+	data[1] = 0;
+	data[2] = 0;
+	data[3] = 0;
+	data[4] = 0;
+	data[5] = 0;
+	data[6] = 0;
+	data[7] = 0;
+
+	data[0] |= (uint8_t)msg->shutdown_ok;
+	data[1] |= (uint8_t)((uint16_t)msg->shutdown_ok >> 8);
+	data[2] |= (uint8_t)msg->current_dA;
+	data[3] |= (uint8_t)((uint16_t)msg->current_dA >> 8);
+	data[4] |= (uint8_t)msg->speed_rpm;
+	data[5] |= (uint8_t)((uint16_t)msg->speed_rpm >> 8);
+	data[6] |= (uint8_t)msg->voltage_dV;
+	data[7] |= (uint8_t)((uint16_t)msg->voltage_dV >> 8);
+	return CAN_MOTOR_STATUS_DLC;
+}
+
+int8_t CANMsgs_DecodeNLG5Status(CAN_NLG5_STATUS_T *msg, const uint8_t *data, uint8_t dlc) {
+	if (dlc != CAN_NLG5_STATUS_DLC) return -1;
+
+	msg->power_enabled = (data[0] >> 7) != 0;
+	msg->error_latch = ((data[0] >> 6) & 0x1) != 0;
+	msg->limit_warning = ((data[0] >> 5) & 0x1) != 0;
+	msg->fan_active = ((data[0] >> 4) & 0x1) != 0;
+	msg->mains_type = ((data[0] >> 1) & 0x7);
+	msg->pilot_detected = (data[0] & 0x1) != 0;
+	msg->bypass_detection = (data[1] >> 6);
+	msg->limitation = (uint16_t)(data[2] | ((uint16_t)(data[1] & 0x1F) << 8));
+	return 0;
+}
+
+uint8_t CANMsgs_EncodeNLG5Status(const CAN_NLG5_STATUS_T *msg, uint8_t *data) {
+	data[0] = 0;
+	data[1] = 0;
+	data[2] = 0;
+	data[3] = 0;
+
+	data[0] |= (uint8_t)((uint8_t)msg->power_enabled << 7);
+	data[0] |= (uint8_t)((uint8_t)msg->error_latch << 6);
+	data[0] |= (uint8_t)((uint8_t)msg->limit_warning << 5);
+	data[0] |= (uint8_t)((uint8_t)msg->fan_active << 4);
+	data[0] |= (uint8_t)(((uint8_t)msg->mains_type & 0x7) << 1);
+	data[0] |= (uint8_t)msg->pilot_detected;
+	data[1] |= (uint8_t)((uint8_t)msg->bypass_detection << 6);
+	data[2] |= (uint8_t)msg->limitation;
+	data[1] |= (uint8_t)(((uint16_t)msg->limitation >> 8) & 0x1F);
+	return CAN_NLG5_STATUS_DLC;
+}
+
+int8_t CANMsgs_DecodeNLG5ActI(CAN_NLG5_ACT_I_T *msg, const uint8_t *data, uint8_t dlc) {
+	if (dlc != CAN_NLG5_ACT_I_DLC) return -1;
+
+	msg->mains_cA = (uint16_t)(data[1] | ((uint16_t)data[0] << 8));
+	msg->mains_dV = (uint16_t)(data[3] | ((uint16_t)data[2] << 8));
+	msg->output_dV = (uint16_t)(data[5] | ((uint16_t)data[4] << 8));
+	msg->output_cA = (uint16_t)(data[7] | ((uint16_t)data[6] << 8));
+	return 0;
+}
+
+uint8_t CANMsgs_EncodeNLG5ActI(const CAN_NLG5_ACT_I_T *msg, uint8_t *data) {
+	data[0] = 0;
+	data[1] = 0;
+	data[2] = 0;
+	data[3] = 0;
+	data[4] = 0;
+	data[5] = 0;
+	data[6] = 0;
+	data[7] = 0;
+
+	data[1] |= (uint8_t)msg->mains_cA;
+	data[0] |= (uint8_t)((uint16_t)msg->mains_cA >> 8);
+	data[3] |= (uint8_t)msg->mains_dV;
+	data[2] |= (uint8_t)((uint16_t)msg->mains_dV >> 8);
+	data[5] |= (uint8_t)msg->output_dV;
+	data[4] |= (uint8_t)((uint16_t)msg->output_dV >> 8);
+	data[7] |= (uint8_t)msg->output_cA;
+	data[6] |= (uint8_t)((uint16_t)msg->output_cA >> 8);
+	return CAN_NLG5_ACT_I_DLC;
+}
+
+int8_t CANMsgs_DecodeNLG5ActII(CAN_NLG5_ACT_II_T *msg, const uint8_t *data, uint8_t dlc) {
+	if (dlc != CAN_NLG5_ACT_II_DLC) return -1;
+
+	msg->mains_max_pilot_dA = (uint16_t)(data[1] | ((uint16_t)data[0] << 8));
+	msg->mains_max_power_ind_dA = data[2];
+	msg->aux_battery_dV = data[3];
+	msg->ext_shunt_cAh = (int16_t)(uint16_t)(data[5] | ((uint16_t)data[4] << 8));
+	msg->booster_output_cA = (uint16_t)(data[7] | ((uint16_t)data[6] << 8));
+	return 0;
+}
+
+uint8_t CANMsgs_EncodeNLG5ActII(const CAN_NLG5_ACT_II_T *msg, uint8_t *data) {
+	data[0] = 0;
+	data[1] = 0;
+	data[2] = 0;
+	data[3] = 0;
+	data[4] = 0;
+	data[5] = 0;
+	data[6] = 0;
+	data[7] = 0;
+
+	data[1] |= (uint8_t)msg->mains_max_pilot_dA;
+	data[0] |= (uint8_t)((uint16_t)msg->mains_max_pilot_dA >> 8);
+	data[2] |= (uint8_t)msg->mains_max_power_ind_dA;
+	data[3] |= (uint8_t)msg->aux_battery_dV;
+	data[5] |= (uint8_t)msg->ext_shunt_cAh;
+	data[4] |= (uint8_t)((uint16_t)msg->ext_shunt_cAh >> 8);
+	data[7] |= (uint8_t)msg->booster_output_cA;
+	data[6] |= (uint8_t)((uint16_t)msg->booster_output_cA >> 8);
+	return CAN_NLG5_ACT_II_DLC;
+}
+
+int8_t CANMsgs_DecodeNLG5Temp(CAN_NLG5_TEMP_T *msg, const uint8_t *data, uint8_t dlc) {
+	if (dlc != CAN_NLG5_TEMP_DLC) return -1;
+
+	msg->power_temp_dC = (int16_t)(uint16_t)(data[1] | ((uint16_t)data[0] << 8));
+	msg->temp_1_dC = (int16_t)(uint16_t)(data[3] | ((uint16_t)data[2] << 8));
+	msg->temp_2_dC = (int16_t)(uint16_t)(data[5] | ((uint16_t)data[4] << 8));
+	msg->temp_3_dC = (int16_t)(uint16_t)(data[7] | ((uint16_t)data[6] << 8));
+	return 0;
+}
+
+uint8_t CANMsgs_EncodeNLG5Temp(const CAN_NLG5_TEMP_T *msg, uint8_t *data) {
+	data[0] = 0;
+	data[1] = 0;
+	data[2] = 0;
+	data[3] = 0;
+	data[4] = 0;
+	data[5] = 0;
+	data[6] = 0;
+	data[7] = 0;
+
+	data[1] |= (uint8_t)msg->power_temp_dC;
+	data[0] |= (uint8_t)((uint16_t)msg->power_temp_dC >> 8);
+	data[3] |= (uint8_t)msg->temp_1_dC;
+	data[2] |= (uint8_t)((uint16_t)msg->temp_1_dC >> 8);
+	data[5] |= (uint8_t)msg->temp_2_dC;
+	data[4] |= (uint8_t)((uint16_t)msg->temp_2_dC >> 8);
+	data[7] |= (uint8_t)msg->temp_3_dC;
+	data[6] |= (uint8_t)((uint16_t)msg->temp_3_dC >> 8);
+	return CAN_NLG5_TEMP_DLC;
+}
+
+int8_t CANMsgs_DecodeNLG5Err(CAN_NLG5_ERR_T *msg, const uint8_t *data, uint8_t dlc) {
+	if (dlc != CAN_NLG5_ERR_DLC) return -1;
+
+	msg->errors = (uint32_t)(data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24));
+	msg->warnings = data[4];
+	return 0;
+}
+
+uint8_t CANMsgs_EncodeNLG5Err(const CAN_NLG5_ERR_T *msg, uint8_t *data) {
+	data[0] = 0;
+	data[1] = 0;
+	data[2] = 0;
+	data[3] = 0;
+	data[4] = 0;
+
+	data[0] |= (uint8_t)msg->errors;
+	data[1] |= (uint8_t)((uint32_t)msg->errors >> 8);
+	data[2] |= (uint8_t)((uint32_t)msg->errors >> 16);
+	data[3] |= (uint8_t)((uint32_t)msg->errors >> 24);
+	data[4] |= (uint8_t)msg->warnings;
+	return CAN_NLG5_ERR_DLC;
+}
+
+int8_t CANMsgs_DecodeNLG5Ctl(CAN_NLG5_CTL_T *msg, const uint8_t *data, uint8_t dlc) {
+	if (dlc != CAN_NLG5_CTL_DLC) return -1;
+
+	msg->enable = (data[0] >> 7) != 0;
+	msg->clear_error = ((data[0] >> 6) & 0x1) != 0;
+	msg->ventilation_request = ((data[0] >> 5) & 0x1) != 0;
+	msg->max_mains_dA = (uint16_t)(data[2] | ((uint16_t)data[1] << 8));
+	msg->output_dV = (uint16_t)(data[4] | ((uint16_t)data[3] << 8));
+	msg->output_dA = (uint16_t)(data[6] | ((uint16_t)data[5] << 8));
+	return 0;
+}
+
+uint8_t CANMsgs_EncodeNLG5Ctl(const CAN_NLG5_CTL_T *msg, uint8_t *data) {
+	data[0] = 0;
+	data[1] = 0;
+	data[2] = 0;
+	data[3] = 0;
+	data[4] = 0;
+	data[5] = 0;
+	data[6] = 0;
+
+	data[0] |= (uint8_t)((uint8_t)msg->enable << 7);
+	data[0] |= (uint8_t)((uint8_t)msg->clear_error << 6);
+	data[0] |= (uint8_t)((uint8_t)msg->ventilation_request << 5);
+	data[2] |= (uint8_t)msg->max_mains_dA;
+	data[1] |= (uint8_t)((uint16_t)msg->max_mains_dA >> 8);
+	data[4] |= (uint8_t)msg->output_dV;
+	data[3] |= (uint8_t)((uint16_t)msg->output_dV >> 8);
+	data[6] |= (uint8_t)msg->output_dA;
+	data[5] |= (uint8_t)((uint16_t)msg->output_dA >> 8);
+	return CAN_NLG5_CTL_DLC;
+}
+
+const CAN_SIGNAL_META_T CANMsgs_Signals[CAN_SIGNALS_COUNT] = {
+	{0, 0, CAN_SIG_THROTTLE_ACCEL_PCT},
+	{0, 1, CAN_SIG_THROTTLE_BRAKE_PCT},
+	{1, 0, CAN_SIG_POWER_STATUS_LV_BATTERY_FLAG},
+	{1, 1, CAN_SIG_POWER_STATUS_LV_DCDC_STATUS},
+	{1, 2, CAN_SIG_POWER_STATUS_CRITICAL_BATTERY_FLAG},
+	{1, 3, CAN_SIG_POWER_STATUS_CRITICAL_DCDC_STATUS},
+	{1, 4, CAN_SIG_POWER_STATUS_PDM_STATUS},
+	{2, 0, CAN_SIG_DRIVER_INPUT_KEY_STATE},
+	{2, 1, CAN_SIG_DRIVER_INPUT_DRIVE_STATUS},
+	{3, 0, CAN_SIG_CONTACTORS_CONTACTOR_1_ERROR},
+	{3, 1, CAN_SIG_CONTACTORS_CONTACTOR_2_ERROR},
+	{3, 2, CAN_SIG_CONTACTORS_CONTACTOR_1_STATUS},
+	{3, 3, CAN_SIG_CONTACTORS_CONTACTOR_2_STATUS},
+	{3, 4, CAN_SIG_CONTACTORS_LV_CONTACTOR_STATUS},
+	{3, 5, CAN_SIG_CONTACTORS_CONTACTOR_3_ERROR},
+	{3, 6, CAN_SIG_CONTACTORS_CONTACTOR_3_STATUS},
+	{3, 7, CAN_SIG_CONTACTORS_PRECHARGE_STATE},
+	{4, 0, CAN_SIG_CELL_VOLTAGES_MIN_CELL_MV},
+	{4, 1, CAN_SIG_CELL_VOLTAGES_MAX_CELL_MV},
+	{4, 2, CAN_SIG_CELL_VOLTAGES_MIN_CELL_CMU},
+	{4, 3, CAN_SIG_CELL_VOLTAGES_MIN_CELL_INDEX},
+	{4, 4, CAN_SIG_CELL_VOLTAGES_MAX_CELL_CMU},
+	{4, 5, CAN_SIG_CELL_VOLTAGES_MAX_CELL_INDEX},
+	{5, 0, CAN_SIG_CELL_TEMPS_MIN_TEMP_DC},
+	{5, 1, CAN_SIG_CELL_TEMPS_MAX_TEMP_DC},
+	{5, 2, CAN_SIG_CELL_TEMPS_MIN_TEMP_CMU},
+	{5, 3, CAN_SIG_CELL_TEMPS_MAX_TEMP_CMU},
+	{6, 0, CAN_SIG_BATTERY_VOLTAGE_DV},
+	{6, 1, CAN_SIG_BATTERY_CURRENT_DA},
+	{7, 0, CAN_SIG_VELOCITY1_SPEED_RPM},
+	{8, 0, CAN_SIG_VELOCITY2_SPEED_RPM},
+	{9, 0, CAN_SIG_MOTOR_STATUS_SHUTDOWN_OK},
+	{9, 1, CAN_SIG_MOTOR_STATUS_CURRENT_DA},
+	{9, 2, CAN_SIG_MOTOR_STATUS_SPEED_RPM},
+	{9, 3, CAN_SIG_MOTOR_STATUS_VOLTAGE_DV},
+	{10, 0, CAN_SIG_NLG5_STATUS_POWER_ENABLED},
+	{10, 1, CAN_SIG_NLG5_STATUS_ERROR_LATCH},
+	{10, 2, CAN_SIG_NLG5_STATUS_LIMIT_WARNING},
+	{10, 3, CAN_SIG_NLG5_STATUS_FAN_ACTIVE},
+	{10, 4, CAN_SIG_NLG5_STATUS_MAINS_TYPE},
+	{10, 5, CAN_SIG_NLG5_STATUS_PILOT_DETECTED},
+	{10, 6, CAN_SIG_NLG5_STATUS_BYPASS_DETECTION},
+	{10, 7, CAN_SIG_NLG5_STATUS_LIMITATION},
+	{11, 0, CAN_SIG_NLG5_ACT_I_MAINS_CA},
+	{11, 1, CAN_SIG_NLG5_ACT_I_MAINS_DV},
+	{11, 2, CAN_SIG_NLG5_ACT_I_OUTPUT_DV},
+	{11, 3, CAN_SIG_NLG5_ACT_I_OUTPUT_CA},
+	{12, 0, CAN_SIG_NLG5_ACT_II_MAINS_MAX_PILOT_DA},
+	{12, 1, CAN_SIG_NLG5_ACT_II_MAINS_MAX_POWER_IND_DA},
+	{12, 2, CAN_SIG_NLG5_ACT_II_AUX_BATTERY_DV},
+	{12, 3, CAN_SIG_NLG5_ACT_II_EXT_SHUNT_CAH},
+	{12, 4, CAN_SIG_NLG5_ACT_II_BOOSTER_OUTPUT_CA},
+	{13, 0, CAN_SIG_NLG5_TEMP_POWER_TEMP_DC},
+	{13, 1, CAN_SIG_NLG5_TEMP_TEMP_1_DC},
+	{13, 2, CAN_SIG_NLG5_TEMP_TEMP_2_DC},
+	{13, 3, CAN_SIG_NLG5_TEMP_TEMP_3_DC},
+	{14, 0, CAN_SIG_NLG5_ERR_ERRORS},
+	{14, 1, CAN_SIG_NLG5_ERR_WARNINGS},
+	{15, 0, CAN_SIG_NLG5_CTL_ENABLE},
+	{15, 1, CAN_SIG_NLG5_CTL_CLEAR_ERROR},
+	{15, 2, CAN_SIG_NLG5_CTL_VENTILATION_REQUEST},
+	{15, 3, CAN_SIG_NLG5_CTL_MAX_MAINS_DA},
+	{15, 4, CAN_SIG_NLG5_CTL_OUTPUT_DV},
+	{15, 5, CAN_SIG_NLG5_CTL_OUTPUT_DA},
+};
+
+static void store_throttle(CAN_STORE_T *store, const uint8_t *data) {
+	store->u8[0] = data[0];
+	store->u8[1] = data[1];
+}
+
+static void store_power_status(CAN_STORE_T *store, const uint8_t *data) {
+	store->bits[0] = (store->bits[0] & ~0x01) | ((data[0] & 0x1) ? 0x01 : 0);
+	store->bits[0] = (store->bits[0] & ~0x02) | (((data[0] >> 1) & 0x1) ? 0x02 : 0);
+	store->bits[0] = (store->bits[0] & ~0x04) | (((data[0] >> 2) & 0x1) ? 0x04 : 0);
+	store->bits[0] = (store->bits[0] & ~0x08) | (((data[0] >> 3) & 0x1) ? 0x08 : 0);
+	store->bits[0] = (store->bits[0] & ~0x10) | (((data[0] >> 4) & 0x1) ? 0x10 : 0);
+}
+
+static void store_driver_input(CAN_STORE_T *store, const uint8_t *data) {
+	store->u16[0] = (uint16_t)(data[0] | ((uint16_t)data[1] << 8));
+	store->u16[1] = (uint16_t)(data[2] | ((uint16_t)data[3] << 8));
+}
+
+static void store_contactors(CAN_STORE_T *store, const uint8_t *data) {
+	store->bits[0] = (store->bits[0] & ~0x20) | ((data[0] & 0x1) ? 0x20 : 0);
+	store->bits[0] = (store->bits[0] & ~0x40) | (((data[0] >> 1) & 0x1) ? 0x40 : 0);
+	store->bits[0] = (store->bits[0] & ~0x80) | (((data[0] >> 2) & 0x1) ? 0x80 : 0);
+	store->bits[1] = (store->bits[1] & ~0x01) | (((data[0] >> 3) & 0x1) ? 0x01 : 0);
+	store->bits[1] = (store->bits[1] & ~0x02) | (((data[0] >> 4) & 0x1) ? 0x02 : 0);
+	store->bits[1] = (store->bits[1] & ~0x04) | (((data[0] >> 5) & 0x1) ? 0x04 : 0);
+	store->bits[1] = (store->bits[1] & ~0x08) | (((data[0] >> 6) & 0x1) ? 0x08 : 0);
+	store->u16[2] = (uint16_t)((data[0] >> 7) | ((uint16_t)data[1] << 1));
+}
+
+static void store_cell_voltages(CAN_STORE_T *store, const uint8_t *data) {
+	store->u16[3] = (uint16_t)(data[0] | ((uint16_t)data[1] << 8));
+	store->u16[4] = (uint16_t)(data[2] | ((uint16_t)data[3] << 8));
+	store->u8[2] = data[4];
+	store->u8[3] = data[5];
+	store->u8[4] = data[6];
+	store->u8[5] = data[7];
+}
+
+static void store_cell_temps(CAN_STORE_T *store, const uint8_t *data) {
+	store->u16[5] = (uint16_t)(data[0] | ((uint16_t)data[1] << 8));
+	store->u16[6] = (uint16_t)(data[2] | ((uint16_t)data[3] << 8));
+	store->u8[6] = data[4];
+	store->u8[7] = data[5];
+}
+
+static void store_battery(CAN_STORE_T *store, const uint8_t *data) {
+	store->u16[7] = (uint16_t)(data[0] | ((uint16_t)data[1] << 8));
+	store->u16[8] = (uint16_t)(data[2] | ((uint16_t)data[3] << 8));
+}
+
+static void store_velocity1(CAN_STORE_T *store, const uint8_t *data) {
+	store->u16[9] = (uint16_t)(data[0] | ((uint16_t)data[1] << 8));
+}
+
+static void store_velocity2(CAN_STORE_T *store, const uint8_t *data) {
+	store->u16[10] = (uint16_t)(data[0] | ((uint16_t)data[1] << 8));
+}
+
+static void store_motor_status(CAN_STORE_T *store, const uint8_t *data) {
+	store->u16[11] = (uint16_t)(data[0] | ((uint16_t)data[1] << 8));
+	store->u16[12] = (uint16_t)(data[2] | ((uint16_t)data[3] << 8));
+	store->u16[13] = (uint16_t)(data[4] | ((uint16_t)data[5] << 8));
+	store->u16[14] = (uint16_t)(data[6] | ((uint16_t)data[7] << 8));
+}
+
+static void store_nlg5_status(CAN_STORE_T *store, const uint8_t *data) {
+	store->bits[1] = (store->bits[1] & ~0x10) | ((data[0] >> 7) ? 0x10 : 0);
+	store->bits[1] = (store->bits[1] & ~0x20) | (((data[0] >> 6) & 0x1) ? 0x20 : 0);
+	store->bits[1] = (store->bits[1] & ~0x40) | (((data[0] >> 5) & 0x1) ? 0x40 : 0);
+	store->bits[1] = (store->bits[1] & ~0x80) | (((data[0] >> 4) & 0x1) ? 0x80 : 0);
+	store->u8[8] = ((data[0] >> 1) & 0x7);
+	store->bits[2] = (store->bits[2] & ~0x01) | ((data[0] & 0x1) ? 0x01 : 0);
+	store->u8[9] = (data[1] >> 6);
+	store->u16[15] = (uint16_t)(data[2] | ((uint16_t)(data[1] & 0x1F) << 8));
+}
+
+static void store_nlg5_act_i(CAN_STORE_T *store, const uint8_t *data) {
+	store->u16[16] = (uint16_t)(data[1] | ((uint16_t)data[0] << 8));
+	store->u16[17] = (uint16_t)(data[3] | ((uint16_t)data[2] << 8));
+	store->u16[18] = (uint16_t)(data[5] | ((uint16_t)data[4] << 8));
+	store->u16[19] = (uint16_t)(data[7] | ((uint16_t)data[6] << 8));
+}
+
+static void store_nlg5_act_ii(CAN_STORE_T *store, const uint8_t *data) {
+	store->u16[20] = (uint16_t)(data[1] | ((uint16_t)data[0] << 8));
+	store->u8[10] = data[2];
+	store->u8[11] = data[3];
+	store->u16[21] = (uint16_t)(data[5] | ((uint16_t)data[4] << 8));
+	store->u16[22] = (uint16_t)(data[7] | ((uint16_t)data[6] << 8));
+}
+
+static void store_nlg5_temp(CAN_STORE_T *store, const uint8_t *data) {
+	store->u16[23] = (uint16_t)(data[1] | ((uint16_t)data[0] << 8));
+	store->u16[24] = (uint16_t)(data[3] | ((uint16_t)data[2] << 8));
+	store->u16[25] = (uint16_t)(data[5] | ((uint16_t)data[4] << 8));
+	store->u16[26] = (uint16_t)(data[7] | ((uint16_t)data[6] << 8));
+}
+
+static void store_nlg5_err(CAN_STORE_T *store, const uint8_t *data) {
+	store->u32[0] = (uint32_t)(data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24));
+	store->u8[12] = data[4];
+}
+
+static void store_nlg5_ctl(CAN_STORE_T *store, const uint8_t *data) {
+	store->bits[2] = (store->bits[2] & ~0x02) | ((data[0] >> 7) ? 0x02 : 0);
+	store->bits[2] = (store->bits[2] & ~0x04) | (((data[0] >> 6) & 0x1) ? 0x04 : 0);
+	store->bits[2] = (store->bits[2] & ~0x08) | (((data[0] >> 5) & 0x1) ? 0x08 : 0);
+	store->u16[27] = (uint16_t)(data[2] | ((uint16_t)data[1] << 8));
+	store->u16[28] = (uint16_t)(data[4] | ((uint16_t)data[3] << 8));
+	store->u16[29] = (uint16_t)(data[6] | ((uint16_t)data[5] << 8));
+}
+
+int8_t CANMsgs_Store(CAN_STORE_T *store, uint16_t id, const uint8_t *data, uint8_t dlc) {
+	switch (id) {
+		case CAN_THROTTLE:
+			if (dlc != CAN_THROTTLE_DLC) return -1;
+			store_throttle(store, data);
+			return 0;
+		case CAN_POWER_STATUS:
+			if (dlc != CAN_POWER_STATUS_DLC) return -1;
+			store_power_status(store, data);
+			return 0;
+		case CAN_DRIVER_INPUT:
+			if (dlc != CAN_DRIVER_INPUT_DLC) return -1;
+			store_driver_input(store, data);
+			return 0;
+		case CAN_CONTACTORS:
+			if (dlc != CAN_CONTACTORS_DLC) return -1;
+			store_contactors(store, data);
+			return 0;
+		case CAN_CELL_VOLTAGES:
+			if (dlc != CAN_CELL_VOLTAGES_DLC) return -1;
+			store_cell_voltages(store, data);
+			return 0;
+		case CAN_CELL_TEMPS:
+			if (dlc != CAN_CELL_TEMPS_DLC) return -1;
+			store_cell_temps(store, data);
+			return 0;
+		case CAN_BATTERY:
+			if (dlc != CAN_BATTERY_DLC) return -1;
+			store_battery(store, data);
+			return 0;
+		case CAN_VELOCITY1:
+			if (dlc != CAN_VELOCITY1_DLC) return -1;
+			store_velocity1(store, data);
+			return 0;
+		case CAN_VELOCITY2:
+			if (dlc != CAN_VELOCITY2_DLC) return -1;
+			store_velocity2(store, data);
+			return 0;
+		case CAN_MOTOR_STATUS:
+			if (dlc != CAN_MOTOR_STATUS_DLC) return -1;
+			store_motor_status(store, data);
+			return 0;
+		case CAN_NLG5_STATUS:
+			if (dlc != CAN_NLG5_STATUS_DLC) return -1;
+			store_nlg5_status(store, data);
+			return 0;
+		case CAN_NLG5_ACT_I:
+			if (dlc != CAN_NLG5_ACT_I_DLC) return -1;
+			store_nlg5_act_i(store, data);
+			return 0;
+		case CAN_NLG5_ACT_II:
+			if (dlc != CAN_NLG5_ACT_II_DLC) return -1;
+			store_nlg5_act_ii(store, data);
+			return 0;
+		case CAN_NLG5_TEMP:
+			if (dlc != CAN_NLG5_TEMP_DLC) return -1;
+			store_nlg5_temp(store, data);
+			return 0;
+		case CAN_NLG5_ERR:
+			if (dlc != CAN_NLG5_ERR_DLC) return -1;
+			store_nlg5_err(store, data);
+			return 0;
+		case CAN_NLG5_CTL:
+			if (dlc != CAN_NLG5_CTL_DLC) return -1;
+			store_nlg5_ctl(store, data);
+			return 0;
+		default:
+			return 1;
+	}
+}
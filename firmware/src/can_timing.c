@@ -0,0 +1,90 @@
+#include "can_timing.h"
+
+#define MAX_QUANTA 25 							// Sync + 16 + 8, the most either controller allows
+
+const CAN_TIMING_LIMITS_T CANTiming_CCAN = {64, 2, 16, 1, 8, 4, 0};
+const CAN_TIMING_LIMITS_T CANTiming_MCP2515 = {64, 2, 16, 2, 8, 4, 1};
+
+/**
+ * Split tq quanta around a sample point within the segment limits
+ *
+ * @return false if tq cannot be split
+ */
+static bool split(uint8_t tq, uint16_t sample_point, const CAN_TIMING_LIMITS_T *limits, CAN_TIMING_T *t) {
+	int16_t tseg2 = tq - (sample_point * tq + 500) / 1000;
+	int16_t tseg1;
+
+	if (tseg2 < limits->tseg2_min) tseg2 = limits->tseg2_min;
+	if (tseg2 > limits->tseg2_max) tseg2 = limits->tseg2_max;
+	tseg1 = tq - 1 - tseg2;
+	if (tseg1 > limits->tseg1_max) {
+		tseg1 = limits->tseg1_max;
+		tseg2 = tq - 1 - tseg1;
+	} else if (tseg1 < limits->tseg1_min) {
+		tseg1 = limits->tseg1_min;
+		tseg2 = tq - 1 - tseg1;
+	}
+	if (tseg2 < limits->tseg2_min || tseg2 > limits->tseg2_max) return false;
+
+	t->tseg1 = tseg1;
+	t->tseg2 = tseg2;
+	return true;
+}
+
+bool CANTiming_Solve(uint32_t clock, uint32_t baud, uint16_t sample_point,
+	const CAN_TIMING_LIMITS_T *limits, CAN_TIMING_T *timing) {
+	CAN_TIMING_T t;
+	uint16_t best_sp_err = 0;
+	uint8_t best_tq = 0;
+	uint8_t tq;
+
+	if (baud == 0 || clock < 1000) return false;
+
+	// Most quanta first so ties keep the finer resynchronisation
+	for (tq = MAX_QUANTA; tq >= 1 + limits->tseg1_min + limits->tseg2_min; tq--) {
+		uint32_t per_bit = baud * tq;
+		uint32_t brp = (clock + per_bit / 2) / per_bit;
+		uint32_t actual, err;
+		uint16_t sp_err;
+		int16_t sjw;
+
+		if (tq > 1 + limits->tseg1_max + limits->tseg2_max) continue;
+		if (brp < 1 || brp > limits->brp_max) continue;
+
+		// Relative bit rate error, bounded first so the ppm product fits 32 bits
+		actual = brp * per_bit;
+		err = actual > clock ? actual - clock : clock - actual;
+		if (err * 64 > actual) continue;
+		t.rate_err_ppm = (err * 1000) / (clock / 1000);
+		if (t.rate_err_ppm > CAN_TIMING_MAX_RATE_ERR_PPM) continue;
+
+		if (!split(tq, sample_point, limits, &t)) continue;
+
+		// Sample point error in units of 1/(1000 * tq), compared across tq by cross multiplying
+		sp_err = 1000 * (1 + t.tseg1) > sample_point * tq ?
+			1000 * (1 + t.tseg1) - sample_point * tq : sample_point * tq - 1000 * (1 + t.tseg1);
+		if (best_tq &&
+			(t.rate_err_ppm > timing->rate_err_ppm ||
+			(t.rate_err_ppm == timing->rate_err_ppm && (uint32_t)sp_err * best_tq >= (uint32_t)best_sp_err * tq))) {
+			continue;
+		}
+
+		sjw = t.tseg2 - limits->sjw_margin;
+		if (sjw > limits->sjw_max) sjw = limits->sjw_max;
+		if (sjw < 1) continue;
+
+		t.brp = brp;
+		t.sjw = sjw;
+		t.sample_point = (1000 * (1 + t.tseg1) + tq / 2) / tq;
+		t.sp_error = (int16_t)t.sample_point - (int16_t)sample_point;
+		*timing = t;
+		best_sp_err = sp_err;
+		best_tq = tq;
+	}
+
+	return best_tq != 0;
+}
+
+uint8_t CANTiming_Quanta(const CAN_TIMING_T *timing) {
+	return 1 + timing->tseg1 + timing->tseg2;
+}
@@ -0,0 +1,155 @@
+#include "cell_scan.h"
+#include <string.h>
+
+typedef enum {
+	CELL_SCAN_IDLE,
+	CELL_SCAN_CONVERTING,
+	CELL_SCAN_READING
+} CELL_SCAN_STATE_T;
+
+static CELL_SCAN_STATE_T _state;
+static uint16_t _adcv_cmd;
+
+static CELL_SCAN_T _scans[2];
+static uint8_t _front; 							// Index of the published half
+
+static uint8_t _raw[CELL_SCAN_NUM_GROUPS][LTC6804_ASYNC_FRAME_LEN(LTC6804_ASYNC_MAX_DEVICES)];
+static uint16_t _group_pec[CELL_SCAN_NUM_GROUPS];
+static uint8_t _groups_queued;
+
+// Set from the SSP interrupt
+static volatile bool _poll_pending;
+static volatile bool _adc_done;
+static volatile uint8_t _groups_done;
+
+static uint8_t _generation; 					// Conversion the queued polls belong to
+
+static uint32_t _convert_start;
+static uint32_t _scan_start; 				// Conversion start of the scan being read
+static uint32_t _last_poll;
+static uint32_t _last_scan;
+static uint32_t _rate_start;
+static uint32_t _rate_count;
+static CELL_SCAN_STATS_T _stats;
+
+static void poll_done(void *context, const uint8_t *data, uint16_t pec_errors) {
+	(void)pec_errors;
+	// A poll still queued when its conversion timed out says nothing about the next one
+	if ((uint8_t)(uintptr_t)context != _generation) return;
+	if (*data == 0xFF) _adc_done = true;
+	_poll_pending = false;
+}
+
+static void group_done(void *context, const uint8_t *data, uint16_t pec_errors) {
+	(void)data;
+	*(uint16_t *)context = pec_errors;
+	_groups_done++;
+}
+
+static bool start_conversion(uint32_t msTicks) {
+	_generation++;
+	_adc_done = false;
+	_poll_pending = false;
+	if (!LTC6804Async_Command(_adcv_cmd, msTicks, NULL, NULL)) return false;
+
+	_convert_start = msTicks;
+	_last_poll = msTicks;
+	return true;
+}
+
+static void queue_reads(uint32_t msTicks) {
+	while (_groups_queued < CELL_SCAN_NUM_GROUPS &&
+		   LTC6804Async_ReadVoltageGroup((CELL_GROUPS_T)_groups_queued, _raw[_groups_queued], msTicks,
+			   group_done, &_group_pec[_groups_queued])) {
+		_groups_queued++;
+	}
+}
+
+/**
+ * Decode the raw group reads into the idle buffer and swap it in
+ */
+static void publish(uint32_t timestamp, uint32_t msTicks) {
+	CELL_SCAN_T *back = &_scans[_front ^ 1];
+	uint8_t g;
+
+	// Devices that fail a PEC keep their previous reading
+	memcpy(back->cells, _scans[_front].cells, sizeof(back->cells));
+	back->pec_errors = 0;
+	for (g = 0; g < CELL_SCAN_NUM_GROUPS; g++) {
+		LTC6804Async_DecodeVoltageGroup(_raw[g] + LTC6804_ASYNC_CMD_LEN, _group_pec[g], (CELL_GROUPS_T)g, back->cells);
+		back->pec_errors |= _group_pec[g];
+	}
+	back->seq = _scans[_front].seq + 1;
+	back->timestamp = timestamp;
+	_front ^= 1;
+
+	_stats.scans++;
+	_stats.period_ms = msTicks - _last_scan;
+	_last_scan = msTicks;
+
+	_rate_count++;
+	if (msTicks - _rate_start >= CELL_SCAN_RATE_WINDOW_MS) {
+		_stats.rate_mHz = (_rate_count * 1000000) / (msTicks - _rate_start);
+		_rate_count = 0;
+		_rate_start = msTicks;
+	}
+}
+
+void CellScan_Init(uint16_t adcv_cmd) {
+	_adcv_cmd = adcv_cmd;
+	_state = CELL_SCAN_IDLE;
+	_front = 0;
+	memset(_scans, 0, sizeof(_scans));
+	memset(&_stats, 0, sizeof(_stats));
+	_rate_count = 0;
+	_rate_start = 0;
+	_last_scan = 0;
+}
+
+bool CellScan_Update(uint32_t msTicks) {
+	bool published = false;
+
+	switch (_state) {
+		case CELL_SCAN_IDLE:
+			if (start_conversion(msTicks)) _state = CELL_SCAN_CONVERTING;
+			break;
+
+		case CELL_SCAN_CONVERTING:
+			if (_adc_done) {
+				_stats.convert_ms = msTicks - _convert_start;
+				_groups_queued = 0;
+				_groups_done = 0;
+				_scan_start = _convert_start;
+				queue_reads(msTicks);
+				_state = CELL_SCAN_READING;
+			} else if (msTicks - _convert_start >= CELL_SCAN_TIMEOUT_MS) {
+				_stats.timeouts++;
+				_state = CELL_SCAN_IDLE;
+			} else if (!_poll_pending && msTicks - _last_poll >= CELL_SCAN_POLL_MS) {
+				_poll_pending = true;
+				_last_poll = msTicks;
+				if (!LTC6804Async_PollADC(msTicks, poll_done, (void *)(uintptr_t)_generation)) _poll_pending = false;
+			}
+			break;
+
+		case CELL_SCAN_READING:
+			queue_reads(msTicks);
+			if (_groups_done < CELL_SCAN_NUM_GROUPS) break;
+
+			// Cell registers are in _raw now, so the next conversion can run while they are decoded
+			_state = start_conversion(msTicks) ? CELL_SCAN_CONVERTING : CELL_SCAN_IDLE;
+			publish(_scan_start, msTicks);
+			published = true;
+			break;
+	}
+
+	return published;
+}
+
+const CELL_SCAN_T *CellScan_GetLatest(void) {
+	return &_scans[_front];
+}
+
+void CellScan_GetStats(CELL_SCAN_STATS_T *stats) {
+	*stats = _stats;
+}
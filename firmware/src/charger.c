@@ -0,0 +1,152 @@
+#include "charger.h"
+#include "signal_store.h"
+
+static CHARGER_STATE_T _state;
+static CHARGER_STATS_T _stats;
+
+static bool (*_send)(const CCAN_MSG_OBJ_T *msg);
+static uint16_t (*_max_cell)(void);
+static uint16_t _cc_cAmps;
+static uint16_t _mains_cAmps;
+
+static uint32_t _next_step; 					// msTicks the next step is due
+static uint32_t _last_cycles; 					// Board_CycleCount() at the last step
+static uint32_t _start_ms;
+static uint8_t _term_steps;
+
+static bool charging(void) {
+	return _state.mode == CHARGER_CC || _state.mode == CHARGER_CV;
+}
+
+static uint8_t check_faults(uint32_t msTicks) {
+	uint8_t faults = 0;
+
+	// The NLG5 gets CHARGER_STALE_MS after a start to clear its latch and report
+	if (msTicks - _start_ms >= CHARGER_STALE_MS) {
+		if (SignalStore_Get(CAN_SIG_NLG5_STATUS_ERROR_LATCH) || SignalStore_Get(CAN_SIG_NLG5_ERR_ERRORS)) {
+			faults |= CHARGER_FAULT_NLG5;
+		}
+		if (!SignalStore_IsFresh(CAN_MSG_NLG5_STATUS)) faults |= CHARGER_FAULT_STALE;
+	}
+	if (_state.max_cell_mV == 0) faults |= CHARGER_FAULT_NO_CELLS;
+	else if (_state.max_cell_mV >= CHARGER_CELL_ABS_MAX_MV) faults |= CHARGER_FAULT_OVERVOLT;
+	return faults;
+}
+
+/**
+ * Integrate the highest cell's distance from the CV voltage into the setpoint
+ */
+static void regulate_cv(void) {
+	int32_t current = _state.current_cAmps;
+
+	current += ((int32_t)CHARGER_CELL_CV_MV - _state.max_cell_mV) * CHARGER_CV_GAIN;
+	if (current < 0) current = 0;
+	if (current > _cc_cAmps) current = _cc_cAmps;
+	_state.current_cAmps = current;
+
+	if (_state.current_cAmps < CHARGER_TERM_CAMPS) {
+		if (++_term_steps >= CHARGER_TERM_STEPS) _state.mode = CHARGER_DONE;
+	} else {
+		_term_steps = 0;
+	}
+}
+
+static void step(uint32_t msTicks) {
+	CCAN_MSG_OBJ_T msg;
+	NLG5_CTL_T ctl;
+
+	_state.max_cell_mV = _max_cell();
+
+	if (charging()) {
+		_state.faults = check_faults(msTicks);
+		if (_state.faults) _state.mode = CHARGER_FAULT;
+	}
+
+	if (_state.mode == CHARGER_CC && _state.max_cell_mV >= CHARGER_CELL_CV_MV - CHARGER_CV_BAND_MV) {
+		_state.mode = CHARGER_CV;
+		_term_steps = 0;
+	}
+	if (_state.mode == CHARGER_CC) _state.current_cAmps = _cc_cAmps;
+	else if (_state.mode == CHARGER_CV) regulate_cv();
+	if (!charging()) _state.current_cAmps = 0;
+
+	// Control frames keep flowing while idle so the NLG5 holds its output off
+	ctl.enable = charging();
+	ctl.clear_error = charging() && msTicks - _start_ms < CHARGER_STALE_MS;
+	ctl.ventilation_request = charging();
+	ctl.max_mains_cAmps = _mains_cAmps;
+	ctl.output_mVolts = _state.voltage_mVolts;
+	ctl.output_cAmps = _state.current_cAmps;
+	Brusa_MakeCTL(&ctl, &msg);
+	if (!_send(&msg)) _stats.send_failed++;
+}
+
+void Charger_Init(uint16_t num_cells, uint16_t cc_cAmps, uint16_t mains_cAmps,
+	bool (*send)(const CCAN_MSG_OBJ_T *msg), uint16_t (*max_cell)(void)) {
+	_send = send;
+	_max_cell = max_cell;
+	_cc_cAmps = cc_cAmps;
+	_mains_cAmps = mains_cAmps;
+
+	_state.mode = CHARGER_IDLE;
+	_state.faults = 0;
+	_state.current_cAmps = 0;
+	_state.voltage_mVolts = (uint32_t)num_cells * CHARGER_CELL_CV_MV;
+	_state.max_cell_mV = 0;
+
+	_next_step = 0;
+	_start_ms = 0;
+	_term_steps = 0;
+	Charger_ResetStats();
+}
+
+void Charger_Start(uint32_t msTicks) {
+	_state.mode = CHARGER_CC;
+	_state.faults = 0;
+	_state.current_cAmps = 0;
+	_start_ms = msTicks;
+	_term_steps = 0;
+}
+
+void Charger_Stop(void) {
+	_state.mode = CHARGER_IDLE;
+	_state.current_cAmps = 0;
+}
+
+void Charger_Update(uint32_t msTicks, uint32_t cycles) {
+	if (!_send || (int32_t)(msTicks - _next_step) < 0) return;
+
+	// Deadlines advance by whole periods so late steps do not shift the rate,
+	// but a loop stalled past a full period resynchronises instead of bursting
+	_next_step += CHARGER_PERIOD_MS;
+	if ((int32_t)(msTicks - _next_step) >= 0) {
+		if (_stats.steps) _stats.overruns++;
+		_next_step = msTicks + CHARGER_PERIOD_MS;
+	}
+
+	if (_stats.steps) {
+		uint32_t period = cycles - _last_cycles;
+		if (period < _stats.period_min) _stats.period_min = period;
+		if (period > _stats.period_max) _stats.period_max = period;
+	}
+	_last_cycles = cycles;
+	_stats.steps++;
+
+	step(msTicks);
+}
+
+const CHARGER_STATE_T *Charger_GetState(void) {
+	return &_state;
+}
+
+const CHARGER_STATS_T *Charger_GetStats(void) {
+	return &_stats;
+}
+
+void Charger_ResetStats(void) {
+	_stats.steps = 0;
+	_stats.overruns = 0;
+	_stats.period_min = 0xFFFFFFFF;
+	_stats.period_max = 0;
+	_stats.send_failed = 0;
+}
@@ -0,0 +1,154 @@
+#include "event_log.h"
+#include <stddef.h>
+#include <string.h>
+
+#define ERASED 0xFFFFFFFF
+
+typedef char SECTORS_CHECK[(EVENT_LOG_SECTORS >= 1 && EVENT_LOG_PAGE_SIZE % sizeof(EVENT_LOG_RECORD_T) == 0) ? 1 : -1];
+
+static const uint8_t *_base;
+static bool (*_erase)(uint8_t sector);
+static bool (*_program)(uint32_t offset, const uint32_t *page);
+
+static uint32_t _page[EVENT_LOG_PAGE_SIZE / 4]; 	// Staged records, word aligned for IAP
+static uint8_t _staged;
+static uint8_t _sector; 						// Sector and page the staged records go to
+static uint8_t _page_index;
+static uint32_t _seq;
+static EVENT_LOG_STATS_T _stats;
+
+static uint16_t crc16(const uint8_t *data, uint8_t len) {
+	uint16_t crc = 0xFFFF;
+	uint8_t i;
+
+	while (len--) {
+		crc ^= (uint16_t)*data++ << 8;
+		for (i = 0; i < 8; i++) {
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+		}
+	}
+	return crc;
+}
+
+static const EVENT_LOG_RECORD_T *flash_record(uint8_t sector, uint8_t page, uint8_t index) {
+	return (const EVENT_LOG_RECORD_T *)(_base + (uint32_t)sector * EVENT_LOG_SECTOR_SIZE +
+		(uint32_t)page * EVENT_LOG_PAGE_SIZE) + index;
+}
+
+static bool valid(const EVENT_LOG_RECORD_T *record) {
+	return record->crc == crc16((const uint8_t *)record, offsetof(EVENT_LOG_RECORD_T, crc));
+}
+
+static bool page_written(uint8_t sector, uint8_t page) {
+	return flash_record(sector, page, 0)->seq != ERASED;
+}
+
+/**
+ * Program the staged page and move on, rotating into the next sector
+ */
+static void program_page(void) {
+	uint32_t offset = (uint32_t)_sector * EVENT_LOG_SECTOR_SIZE + (uint32_t)_page_index * EVENT_LOG_PAGE_SIZE;
+
+	if (_page_index == 0) {
+		_stats.erases++;
+		if (!_erase(_sector)) _stats.failed++;
+	}
+	_stats.pages++;
+	if (!_program(offset, _page)) _stats.failed++;
+
+	memset(_page, 0xFF, sizeof(_page));
+	_staged = 0;
+	if (++_page_index == EVENT_LOG_PAGES) {
+		_page_index = 0;
+		_sector = (_sector + 1) % EVENT_LOG_SECTORS;
+	}
+}
+
+void EventLog_Init(const uint8_t *base, bool (*erase)(uint8_t sector),
+	bool (*program)(uint32_t offset, const uint32_t *page)) {
+	uint8_t sector, lo, hi, i;
+	bool found = false;
+
+	_base = base;
+	_erase = erase;
+	_program = program;
+	memset(_page, 0xFF, sizeof(_page));
+	memset(&_stats, 0, sizeof(_stats));
+	_staged = 0;
+	_sector = 0;
+	_page_index = 0;
+	_seq = 0;
+
+	// The newest sector starts with the highest sequence number
+	for (sector = 0; sector < EVENT_LOG_SECTORS; sector++) {
+		const EVENT_LOG_RECORD_T *first = flash_record(sector, 0, 0);
+		if (first->seq == ERASED || !valid(first)) continue;
+		if (!found || first->seq > flash_record(_sector, 0, 0)->seq) _sector = sector;
+		found = true;
+	}
+	if (!found) return;
+
+	// First unwritten page, page 0 is known written
+	lo = 1;
+	hi = EVENT_LOG_PAGES;
+	while (lo < hi) {
+		uint8_t mid = (lo + hi) / 2;
+		if (page_written(_sector, mid)) lo = mid + 1;
+		else hi = mid;
+	}
+	_page_index = lo;
+
+	for (i = 0; i < EVENT_LOG_RECORDS; i++) {
+		const EVENT_LOG_RECORD_T *record = flash_record(_sector, _page_index - 1, i);
+		if (record->seq != ERASED && valid(record) && record->seq >= _seq) _seq = record->seq + 1;
+	}
+	if (_page_index == EVENT_LOG_PAGES) {
+		_page_index = 0;
+		_sector = (_sector + 1) % EVENT_LOG_SECTORS;
+	}
+}
+
+void EventLog_Write(uint8_t type, uint8_t code, uint32_t data, uint32_t msTicks) {
+	EVENT_LOG_RECORD_T *record = (EVENT_LOG_RECORD_T *)_page + _staged;
+
+	record->seq = _seq++;
+	record->timestamp = msTicks;
+	record->data = data;
+	record->type = type;
+	record->code = code;
+	record->crc = crc16((const uint8_t *)record, offsetof(EVENT_LOG_RECORD_T, crc));
+	_stats.records++;
+
+	if (++_staged == EVENT_LOG_RECORDS) program_page();
+}
+
+void EventLog_Flush(void) {
+	if (_staged) program_page();
+}
+
+uint32_t EventLog_Dump(void (*emit)(const EVENT_LOG_RECORD_T *record)) {
+	uint32_t bad = 0;
+	uint8_t s, page, i;
+
+	// The sector after the one being written holds the oldest records
+	for (s = 1; s <= EVENT_LOG_SECTORS; s++) {
+		uint8_t sector = (_sector + s) % EVENT_LOG_SECTORS;
+		uint8_t pages = (sector == _sector) ? _page_index : EVENT_LOG_PAGES;
+		for (page = 0; page < pages && page_written(sector, page); page++) {
+			for (i = 0; i < EVENT_LOG_RECORDS; i++) {
+				const EVENT_LOG_RECORD_T *record = flash_record(sector, page, i);
+				if (record->seq == ERASED) break;
+				if (valid(record)) emit(record);
+				else bad++;
+			}
+		}
+	}
+	for (i = 0; i < _staged; i++) {
+		emit((const EVENT_LOG_RECORD_T *)_page + i);
+	}
+	return bad;
+}
+
+const EVENT_LOG_STATS_T *EventLog_GetStats(void) {
+	return &_stats;
+}
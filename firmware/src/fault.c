@@ -0,0 +1,83 @@
+#include "fault.h"
+#include "can_msgs.h"
+
+const FAULT_SOURCE_T Fault_Sources[FAULT_COUNT] = {
+	{"contactor_1", CAN_CONTACTORS, 0, 0x01, FAULT_CRITICAL, 2, FAULT_LATCH},
+	{"contactor_2", CAN_CONTACTORS, 0, 0x02, FAULT_CRITICAL, 2, FAULT_LATCH},
+	{"contactor_3", CAN_CONTACTORS, 0, 0x20, FAULT_CRITICAL, 2, FAULT_LATCH},
+	{"lv_battery", CAN_POWER_STATUS, 0, 0x01, FAULT_WARNING, 3, 0},
+	{"critical_battery", CAN_POWER_STATUS, 0, 0x04, FAULT_CRITICAL, 3, FAULT_LATCH},
+	{"motor_shutdown", CAN_MOTOR_STATUS, 0, 0x01, FAULT_CRITICAL, 2, FAULT_ACTIVE_LOW},
+};
+
+static FAULT_SET_T _active;
+static FAULT_SET_T _latched;
+static FAULT_SET_T _changed;
+static FAULT_SET_T _latching; 					// Sources with FAULT_LATCH
+static uint8_t _count[FAULT_COUNT]; 			// Consecutive frames disagreeing with _active
+
+void Fault_Init(void) {
+	uint8_t i;
+
+	_active = 0;
+	_latched = 0;
+	_changed = 0;
+	_latching = 0;
+	for (i = 0; i < FAULT_COUNT; i++) {
+		_count[i] = 0;
+		if (Fault_Sources[i].flags & FAULT_LATCH) _latching |= FAULT_BIT(i);
+	}
+}
+
+FAULT_SET_T Fault_Receive(uint16_t id, const uint8_t *data, uint8_t dlc) {
+	FAULT_SET_T before = Fault_GetState();
+	FAULT_SET_T changed;
+	uint8_t i;
+
+	for (i = 0; i < FAULT_COUNT; i++) {
+		const FAULT_SOURCE_T *src = &Fault_Sources[i];
+		FAULT_SET_T bit = FAULT_BIT(i);
+		bool raw;
+
+		if (src->id != id || src->byte >= dlc) continue;
+
+		raw = (data[src->byte] & src->mask) != 0;
+		if (src->flags & FAULT_ACTIVE_LOW) raw = !raw;
+		if (raw == ((_active & bit) != 0)) {
+			_count[i] = 0;
+			continue;
+		}
+		if (++_count[i] < src->debounce) continue;
+
+		_count[i] = 0;
+		_active ^= bit;
+	}
+
+	_latched |= _active & _latching;
+	changed = Fault_GetState() ^ before;
+	_changed |= changed;
+	return changed;
+}
+
+FAULT_SET_T Fault_TakeChanged(void) {
+	FAULT_SET_T changed = _changed;
+	_changed = 0;
+	return changed;
+}
+
+FAULT_SET_T Fault_GetActive(void) {
+	return _active;
+}
+
+FAULT_SET_T Fault_GetLatched(void) {
+	return _latched;
+}
+
+FAULT_SET_T Fault_GetState(void) {
+	return _active | _latched;
+}
+
+void Fault_ClearLatched(void) {
+	_changed |= _latched & ~_active;
+	_latched &= _active;
+}
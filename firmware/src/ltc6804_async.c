@@ -0,0 +1,310 @@
+#include "ltc6804_async.h"
+#include "pec15.h"
+#include <string.h>
+
+typedef struct _LTC6804_SLOT_T_ {
+	SSP_ASYNC_XFER_T xfer;
+	uint8_t tx[LTC6804_ASYNC_CMD_LEN];
+	uint8_t poll[LTC6804_ASYNC_CMD_LEN + 1]; 	// PLADC reply, status byte last
+	LTC6804_ASYNC_CALLBACK_T callback;
+	void *context;
+	volatile bool busy;
+} LTC6804_SLOT_T;
+
+static LTC6804_SLOT_T _slots[LTC6804_ASYNC_SLOTS];
+typedef struct _LTC6804_DEVICE_T_ {
+	uint32_t last_activity; 					// msTicks of the last window that reached the device
+	bool awake; 								// false until the first wake after init
+} LTC6804_DEVICE_T;
+
+static SSP_ASYNC_XFER_T _wake;
+static uint16_t _sleep_wake_len; 				// Bytes holding CS low for tWAKE
+static uint8_t _cs_gpio;
+static uint8_t _cs_pin;
+static uint8_t _num_devices;
+static LTC6804_DEVICE_T _devices[LTC6804_ASYNC_MAX_DEVICES];
+static LTC6804_WAKE_STATS_T _wake_stats;
+
+static uint8_t _cfg[LTC6804_ASYNC_MAX_DEVICES][LTC6804_ASYNC_REG_LEN];
+static uint8_t _cfg_frame[LTC6804_ASYNC_FRAME_LEN(LTC6804_ASYNC_MAX_DEVICES)];
+static volatile bool _cfg_pending;
+
+static uint32_t _pec_errors[LTC6804_ASYNC_MAX_DEVICES];
+
+static const uint16_t RDCV[4] = {RDCVA, RDCVB, RDCVC, RDCVD};
+
+/**
+ * Runs in the SSP interrupt once the slot's window has closed
+ */
+static void slot_done(SSP_ASYNC_XFER_T *xfer) {
+	LTC6804_SLOT_T *slot = (LTC6804_SLOT_T *)xfer->context;
+	const uint8_t *data = NULL;
+	uint16_t pec_errors = 0;
+	uint8_t i;
+
+	if (xfer->rx_data == slot->poll) {
+		data = slot->poll + LTC6804_ASYNC_CMD_LEN;
+	} else if (xfer->rx_data) {
+		data = xfer->rx_data + LTC6804_ASYNC_CMD_LEN;
+		for (i = 0; i < _num_devices; i++) {
+			if (!PEC15_Check(data + i * LTC6804_ASYNC_GROUP_LEN, LTC6804_ASYNC_REG_LEN)) {
+				pec_errors |= 1 << i;
+				_pec_errors[i]++;
+			}
+		}
+	}
+	if (xfer->tx_data == _cfg_frame) _cfg_pending = false;
+
+	slot->busy = false;
+	if (slot->callback) slot->callback(slot->context, data, pec_errors);
+}
+
+static LTC6804_SLOT_T *slot_alloc(uint16_t cmd, LTC6804_ASYNC_CALLBACK_T callback, void *context) {
+	uint8_t i;
+	for (i = 0; i < LTC6804_ASYNC_SLOTS; i++) {
+		LTC6804_SLOT_T *slot = &_slots[i];
+		if (slot->busy) continue;
+
+		slot->busy = true;
+		slot->callback = callback;
+		slot->context = context;
+		slot->tx[0] = cmd >> 8;
+		slot->tx[1] = cmd & 0xFF;
+		PEC15_Append(slot->tx, 2);
+
+		slot->xfer.tx_data = slot->tx;
+		slot->xfer.tx_length = LTC6804_ASYNC_CMD_LEN;
+		slot->xfer.rx_data = NULL;
+		slot->xfer.length = LTC6804_ASYNC_CMD_LEN;
+		slot->xfer.cs_port = _cs_gpio;
+		slot->xfer.cs_pin = _cs_pin;
+		slot->xfer.repeat = 0;
+		slot->xfer.callback = slot_done;
+		slot->xfer.context = slot;
+		return slot;
+	}
+	return NULL;
+}
+
+static LTC6804_DEVICE_STATE_T device_state(const LTC6804_DEVICE_T *device, uint32_t msTicks) {
+	uint32_t idle = msTicks - device->last_activity;
+
+	if (!device->awake || idle >= LTC6804_ASYNC_SLEEP_MS) return LTC6804_DEVICE_SLEEP;
+	if (idle >= LTC6804_ASYNC_IDLE_MS) return LTC6804_DEVICE_STANDBY;
+	return LTC6804_DEVICE_READY;
+}
+
+/**
+ * Queue wake pulses ahead of a command if any device may have timed out. Each
+ * pulse brings one more device down the chain up, so the count runs to the
+ * furthest device that needs one.
+ */
+static void wake_chain(uint32_t msTicks) {
+	uint8_t i, pulses = 0;
+	bool sleep = false;
+
+	_wake_stats.commands++;
+	for (i = 0; i < _num_devices; i++) {
+		LTC6804_DEVICE_STATE_T state = device_state(&_devices[i], msTicks);
+		if (state != LTC6804_DEVICE_READY) pulses = i + 1;
+		if (state == LTC6804_DEVICE_SLEEP) sleep = true;
+	}
+
+	// A pending wake is already ahead of this command in the queue
+	if (pulses && _wake.done) {
+		_wake.length = sleep ? _sleep_wake_len : 1;
+		_wake.repeat = pulses - 1;
+		if (SSP_Async_Submit(&_wake)) {
+			_wake_stats.windows += pulses;
+			_wake_stats.bytes += pulses * _wake.length;
+			if (sleep) {
+				_wake_stats.sleep_wakes++;
+			} else {
+				_wake_stats.idle_wakes++;
+			}
+		}
+	}
+
+	// Every window propagates through the whole chain
+	for (i = 0; i < _num_devices; i++) {
+		_devices[i].last_activity = msTicks;
+		_devices[i].awake = true;
+	}
+}
+
+/**
+ * Queue the slot, preceded by wake pulses if needed
+ */
+static bool slot_submit(LTC6804_SLOT_T *slot, uint32_t msTicks) {
+	wake_chain(msTicks);
+
+	if (!SSP_Async_Submit(&slot->xfer)) {
+		slot->busy = false;
+		return false;
+	}
+	return true;
+}
+
+void LTC6804Async_Init(uint32_t baud, uint8_t cs_gpio, uint8_t cs_pin, uint8_t num_devices) {
+	uint8_t i;
+
+	if (num_devices > LTC6804_ASYNC_MAX_DEVICES) num_devices = LTC6804_ASYNC_MAX_DEVICES;
+	_num_devices = num_devices;
+	_cs_gpio = cs_gpio;
+	_cs_pin = cs_pin;
+	_cfg_pending = false;
+	memset(&_wake_stats, 0, sizeof(_wake_stats));
+
+	for (i = 0; i < LTC6804_ASYNC_SLOTS; i++) {
+		_slots[i].busy = false;
+	}
+
+	// GPIO pulldowns off, REFON = 1, ADCOPT = 0, no thresholds, no discharge
+	for (i = 0; i < LTC6804_ASYNC_MAX_DEVICES; i++) {
+		memset(_cfg[i], 0, LTC6804_ASYNC_REG_LEN);
+		_cfg[i][0] = 0xFC;
+		_pec_errors[i] = 0;
+		// State is unknown until the first wake
+		_devices[i].awake = false;
+		_devices[i].last_activity = 0;
+	}
+
+	// Wake window: the data is don't care, only the time CS is held low matters.
+	// From sleep that has to cover tWAKE, from isoSPI idle a single byte is enough.
+	_sleep_wake_len = (uint32_t)baud * LTC6804_ASYNC_TWAKE_US / 8000000 + 1;
+	_wake.tx_data = NULL;
+	_wake.tx_length = 0;
+	_wake.rx_data = NULL;
+	_wake.length = _sleep_wake_len;
+	_wake.cs_port = cs_gpio;
+	_wake.cs_pin = cs_pin;
+	_wake.repeat = 0;
+	_wake.callback = NULL;
+	_wake.done = true;
+
+	Chip_IOCON_PinMuxSet(LPC_IOCON, IOCON_PIO2_2, (IOCON_FUNC2 | IOCON_MODE_INACT));	/* MISO1 */
+	Chip_IOCON_PinMuxSet(LPC_IOCON, IOCON_PIO2_3, (IOCON_FUNC2 | IOCON_MODE_INACT));	/* MOSI1 */
+	Chip_IOCON_PinMuxSet(LPC_IOCON, IOCON_PIO2_1, (IOCON_FUNC2 | IOCON_MODE_INACT));	/* SCK1 */
+	Chip_GPIO_WriteDirBit(LPC_GPIO, cs_gpio, cs_pin, true);							/* Chip Select */
+	Chip_GPIO_SetPinState(LPC_GPIO, cs_gpio, cs_pin, true);
+
+	Chip_SSP_Init(LPC_SSP1);
+	Chip_SSP_SetBitRate(LPC_SSP1, baud);
+	Chip_SSP_SetFormat(LPC_SSP1, SSP_BITS_8, SSP_FRAMEFORMAT_SPI, SSP_CLOCK_MODE3);
+	Chip_SSP_SetMaster(LPC_SSP1, true);
+	Chip_SSP_Enable(LPC_SSP1);
+
+	SSP_Async_Init(LPC_SSP1, SSP1_IRQn);
+}
+
+uint8_t LTC6804Async_NumDevices(void) {
+	return _num_devices;
+}
+
+bool LTC6804Async_Command(uint16_t cmd, uint32_t msTicks, LTC6804_ASYNC_CALLBACK_T callback, void *context) {
+	LTC6804_SLOT_T *slot = slot_alloc(cmd, callback, context);
+	if (!slot) return false;
+
+	return slot_submit(slot, msTicks);
+}
+
+void LTC6804Async_SetCFG(uint8_t device, const uint8_t *cfg) {
+	memcpy(_cfg[device], cfg, LTC6804_ASYNC_REG_LEN);
+}
+
+const uint8_t *LTC6804Async_GetCFG(uint8_t device) {
+	return _cfg[device];
+}
+
+bool LTC6804Async_WriteCFG(uint32_t msTicks, LTC6804_ASYNC_CALLBACK_T callback, void *context) {
+	uint8_t i;
+
+	if (_cfg_pending) return false;
+	LTC6804_SLOT_T *slot = slot_alloc(WRCFG, callback, context);
+	if (!slot) return false;
+
+	// The first group shifted in ends up in the device furthest up the chain
+	memcpy(_cfg_frame, slot->tx, LTC6804_ASYNC_CMD_LEN);
+	for (i = 0; i < _num_devices; i++) {
+		uint8_t *group = _cfg_frame + LTC6804_ASYNC_CMD_LEN + i * LTC6804_ASYNC_GROUP_LEN;
+		memcpy(group, _cfg[_num_devices - 1 - i], LTC6804_ASYNC_REG_LEN);
+		PEC15_Append(group, LTC6804_ASYNC_REG_LEN);
+	}
+
+	slot->xfer.tx_data = _cfg_frame;
+	slot->xfer.tx_length = LTC6804_ASYNC_FRAME_LEN(_num_devices);
+	slot->xfer.length = LTC6804_ASYNC_FRAME_LEN(_num_devices);
+	_cfg_pending = true;
+
+	if (!slot_submit(slot, msTicks)) {
+		_cfg_pending = false;
+		return false;
+	}
+	return true;
+}
+
+bool LTC6804Async_Read(uint16_t cmd, uint8_t *rx_buf, uint32_t msTicks, LTC6804_ASYNC_CALLBACK_T callback, void *context) {
+	LTC6804_SLOT_T *slot = slot_alloc(cmd, callback, context);
+	if (!slot) return false;
+
+	slot->xfer.rx_data = rx_buf;
+	slot->xfer.length = LTC6804_ASYNC_FRAME_LEN(_num_devices);
+
+	return slot_submit(slot, msTicks);
+}
+
+bool LTC6804Async_PollADC(uint32_t msTicks, LTC6804_ASYNC_CALLBACK_T callback, void *context) {
+	LTC6804_SLOT_T *slot = slot_alloc(PLADC, callback, context);
+	if (!slot) return false;
+
+	// SDO is held low until every device in the chain has finished converting
+	slot->xfer.rx_data = slot->poll;
+	slot->xfer.length = LTC6804_ASYNC_CMD_LEN + 1;
+
+	return slot_submit(slot, msTicks);
+}
+
+bool LTC6804Async_ReadVoltageGroup(CELL_GROUPS_T cg, uint8_t *rx_buf, uint32_t msTicks,
+	LTC6804_ASYNC_CALLBACK_T callback, void *context) {
+	return LTC6804Async_Read(RDCV[cg & 0x3], rx_buf, msTicks, callback, context);
+}
+
+void LTC6804Async_DecodeVoltageGroup(const uint8_t *data, uint16_t pec_errors, CELL_GROUPS_T cg, CELL_INFO_T *readings) {
+	uint8_t i, c;
+
+	for (i = 0; i < _num_devices; i++, data += LTC6804_ASYNC_GROUP_LEN) {
+		uint16_t *cells;
+
+		if (pec_errors & (1 << i)) continue;
+
+		if (cg == CELL_GROUP_A) {
+			cells = readings[i].groupA;
+		} else if (cg == CELL_GROUP_B) {
+			cells = readings[i].groupB;
+		} else if (cg == CELL_GROUP_C) {
+			cells = readings[i].groupC;
+		} else {
+			cells = readings[i].groupD;
+		}
+
+		for (c = 0; c < 3; c++) {
+			cells[c] = data[2 * c] | (data[2 * c + 1] << 8);
+		}
+	}
+}
+
+uint32_t LTC6804Async_GetPECErrors(uint8_t device) {
+	return _pec_errors[device];
+}
+
+LTC6804_DEVICE_STATE_T LTC6804Async_GetDeviceState(uint8_t device, uint32_t msTicks) {
+	return device_state(&_devices[device], msTicks);
+}
+
+void LTC6804Async_GetWakeStats(LTC6804_WAKE_STATS_T *stats) {
+	*stats = _wake_stats;
+}
+
+bool LTC6804Async_IsBusy(void) {
+	return !SSP_Async_IsIdle();
+}
@@ -1,4 +1,17 @@
 #include "board.h"
+#include "cell_scan.h"
+#include "pack_stats.h"
+#include "can_gateway.h"
+#include "mcp2515_fast.h"
+#include "mbb_pack.h"
+#include "mbb_poll.h"
+#include "charger.h"
+#include "signal_store.h"
+#include "fault.h"
+#include "warning.h"
+#include "can_capture.h"
+#include "event_log.h"
+#include "telemetry.h"
 
 // -------------------------------------------------------------
 // Macro Definitions
@@ -6,6 +19,28 @@
 #define CCAN_BAUD_RATE 500000 					// Desired CAN Baud Rate
 #define UART_BAUD_RATE 57600 					// Desired UART Baud Rate
 
+#define LTC6804_BAUD 500000 					// isoSPI bit rate
+#define LTC6804_NUM_DEVICES 1 					// LTC6804s in the daisy chain
+#define CELLS_PER_DEVICE 12
+
+#define MCP2515_SPI_BAUD 4000000 				// SSP0 bit rate to the MCP2515
+#define MCP2515_CAN_BAUD_KHZ 500 				// Second bus bit rate
+#define MCP2515_OSC_MHZ 16
+
+#define PACK_SUMMARY_PERIOD_MS 1000 			// Pack statistics summary rate on the UART
+#define HEARTBEAT_PERIOD_MS 6000 				// 0x7F5 heartbeat rate on the car bus
+#define CAPTURE_RECORDS_PER_PASS 2 				// About 5 ms of UART per main loop pass
+
+#define MBB_FIRST_ID 1 							// A123 module IDs on the second bus
+#define MBB_NUM_MODULES 8
+#define MBB_BUFFER_SIZE (MBB_NUM_MODULES * 4) 	// One standard and three extended responses per module, power of 2
+#define MBB_BALANCE_WINDOW_MV 20 				// Balance cells more than this above the lowest
+#define MBB_STALE_MS CHARGER_STALE_MS 			// Module readings older than this stop charging
+
+#define CHARGER_CC_CAMPS 1200 					// NLG5 output current until the CV phase
+#define CHARGER_MAINS_CAMPS 1600 				// Wall socket limit
+#define CHARGER_MSGOBJ 27 						// C_CAN message object for NLG5_CTL
+
 #define BUFFER_SIZE 8
 
 // -------------------------------------------------------------
@@ -13,100 +48,503 @@
 
 extern volatile uint32_t msTicks;
 static uint32_t lastPrint;
+static uint32_t lastHeartbeat;
 
 static CCAN_MSG_OBJ_T msg_obj; 					// Message Object data structure for manipulating CAN messages
 static RINGBUFF_T can_rx_buffer;				// Ring Buffer for storing received CAN messages
 static CCAN_MSG_OBJ_T _rx_buffer[BUFFER_SIZE]; 	// Underlying array used in ring buffer
+static volatile uint32_t can_rx_dropped; 		// Frames lost to a full can_rx_buffer
 
 static char str[100];							// Used for composing UART messages
 static uint8_t uart_rx_buffer[BUFFER_SIZE]; 	// UART received message buffer
 static uint8_t uart_tx_buffer[BUFFER_SIZE];
 
+static PACK_STATS_T cell_stats; 				// Cell voltages, 100uV units
+static uint16_t cell_values[LTC6804_NUM_DEVICES * CELLS_PER_DEVICE];
+static uint32_t lastSummary;
+
+// Second bus bridging. BMS traffic is brought over for the dashboard, the
+// drive status is mirrored to the second bus above the module responses.
+static const GATEWAY_ROUTE_T gateway_routes[] = {
+	{0x6F0, 0x6FF, GATEWAY_MCP_TO_CCAN, 0, 0},
+	{0x505, 0x505, GATEWAY_CCAN_TO_MCP, 0, 0x100},
+};
+#define NUM_GATEWAY_ROUTES (sizeof(gateway_routes) / sizeof(gateway_routes[0]))
+
+static RINGBUFF_T mbb_rx_buffer; 				// Module responses handed over by the gateway
+static CCAN_MSG_OBJ_T _mbb_rx_buffer[MBB_BUFFER_SIZE];
+static volatile uint32_t mbb_rx_dropped; 		// Responses lost to a full mbb_rx_buffer
+
+static uint32_t decode_frames; 					// Frames offered to the signal store
+static uint32_t decode_sum; 					// Core clock cycles spent storing them
+static uint32_t decode_max;
+
+static uint32_t lastBench; 						// MCP2515 frame rate is measured between 'b' reports
+static uint32_t lastBenchFrames;
+
 static bool can_error_flag;
 static uint32_t can_error_info;
 
-static uint32_t vel1[3]=[0x703,0,0];
-static uint32_t vel2[3]=[0x704,0,0];
+// -------------------------------------------------------------
+// Helper Functions
 
-static uint32_t throt_acc[3]=[0x301,0,0];
-static uint32_t throt_break[3]=[0x301,1,0];
+/**
+ * Delay the processor for a given number of milliseconds
+ * @param ms Number of milliseconds to delay
+ */
+void _delay(uint32_t ms) {
+	uint32_t curTicks = msTicks;
+	while ((msTicks - curTicks) < ms);
+}
+
+/**
+ * Send one frame to the recorder stream: a zero byte, which never starts a
+ * text line, then the capture frame record timestamped with the msTicks the
+ * decoders saw, so tools/replay.c reproduces their output
+ */
+static void record_frame(const CCAN_MSG_OBJ_T *msg, uint32_t timestamp) {
+	uint8_t buf[1 + CAN_CAPTURE_RECORD_MAX];
+
+	buf[0] = 0;
+	Board_UART_SendBlocking(buf, 1 + CANCapture_PackFrame(buf + 1, msg->mode_id, msg->data, msg->dlc, timestamp * 1000));
+}
 
-static uint32_t drive_key[3]=[0x505,0,0];
-static uint32_t drive_status[3]=[0x505,1,0];
+/**
+ * Mark frames lost to a full receive ring in the recorder stream, as a
+ * "Gap <frames>" text line after the frames that were waiting in the ring
+ */
+static void record_gap(uint32_t dropped) {
+	Board_UART_Print("Gap ");
+	Board_UART_PrintNum(dropped, 10, true);
+}
 
-static uint32_t motor_shut_ok[3]=[0x705,0,0];
-static uint32_t motor_curr[3]=[0x705,1,0];
-static uint32_t motor_speed[3]=[0x705,2,0];
-static uint32_t motor_volt[3]=[0x705,3,0];
-static uint32_t motor_torque[3]=[0x705,4,0];
+/**
+ * Decode one car bus frame into the signal store, timing the decode
+ *
+ * @return true if the frame was described and stored
+ */
+static bool store_frame(const CCAN_MSG_OBJ_T *msg, uint32_t msTicks) {
+	uint32_t start = Board_CycleCount();
+	bool stored = SignalStore_Receive(msg->mode_id, msg->data, msg->dlc, msTicks);
+	uint32_t cycles = Board_CycleCount() - start;
+
+	decode_frames++;
+	decode_sum += cycles;
+	if (cycles > decode_max) decode_max = cycles;
+	return stored;
+}
 
-static uint32_t low_voltage_bus_battery_flag[3]=[0x305,0,0]; 
-static uint32_t low_voltage_DC-DC_status[3]=[0x305,1,0]; 
-static uint32_t critical_systems_battery_flag[3]=[0x305,2,0];
-static uint32_t critical_systems_DC-DC_status[3]=[0x305,3,0];
-static uint32_tpdm_status[3]=[0x305,4,0];
+/**
+ * Print and log the faults that changed, flushing critical ones to flash
+ */
+static void report_faults(FAULT_SET_T changed, uint32_t timestamp) {
+	FAULT_SET_T state = Fault_GetState();
+	bool flush = false;
+	uint8_t i;
+
+	Telemetry_Faults(changed, timestamp);
+	for (i = 0; i < FAULT_COUNT; i++) {
+		if (!(changed & FAULT_BIT(i))) continue;
+		EventLog_Write(EVENT_LOG_FAULT, i, (state & FAULT_BIT(i)) != 0, timestamp);
+		if ((state & FAULT_BIT(i)) && Fault_Sources[i].severity == FAULT_CRITICAL) flush = true;
+	}
+	if (flush) EventLog_Flush();
+}
 
-static uint32_t contactor_1_error[3]=[0x6F7,0,0];
-static uint32_t contactor_2_error[3]=[0x6F7,1,0];
-static uint32_t contactor_1_status[3]=[0x6F7,2,0];
-static uint32_t contactor_2_status[3]=[0x6F7,3,0];
-static uint32_t 21v_contactor_status[3]=[0x6F7,4,0];
-static uint32_t contactor_3_error[3]=[0x6F7,5,0];
-static uint32_t contactor_3_status[3]=[0x6F7,6,0];
-static uint32_t precharge_state[3]=[0x6F7,7,0];
+/**
+ * Print and log the warnings that changed, the LEDs follow the active ones
+ */
+static void show_warnings(WARNING_SET_T changed, uint32_t timestamp) {
+	uint8_t leds = Warning_GetLeds();
+	uint8_t i;
 
-static uint32_t min_cell_temp[3]=[0x6F9,0,0];
-static uint32_t max_cell_temp[3]=[0x6F9,1,0];
-static uint32_t cmu_with_min_temp[3]=[0x6F9,2,0];
-static uint32_t cmu_with_max_temp[3]=[0x6F9,3,0];
+	Telemetry_Warnings(changed, timestamp);
+	for (i = 0; i < WARNING_COUNT; i++) {
+		if (changed & WARNING_BIT(i)) EventLog_Write(EVENT_LOG_WARNING, i, Warning_GetValue(i), timestamp);
+	}
 
-static uint32_t min_cell_voltage[3]=[0x6F8,0,0];
-static uint32_t max_cell_voltage[3]=[0x6F8,1,0];
-static uint32_t cmu_with_min_cell_voltage[3]=[0x6F8,2,0];
-static uint32_t cell_with_min_voltage[3]=[0x6F8,3,0];
-static uint32_t cmu_with_max_voltage[3]=[0x6F8,4,0];
-static uint32_t cell_with_max_voltage[3]=[0x6F8,5,0];
+	if (leds & WARNING_LED0) {
+		Board_LED_On(LED0);
+	} else {
+		Board_LED_Off(LED0);
+	}
+	if (leds & WARNING_LED1) {
+		Board_LED_On(LED1);
+	} else {
+		Board_LED_Off(LED1);
+	}
+}
 
-static uint32_t battery_voltage[3]=[0x6FA,0,0];
-static uint32_t battery_current[3]=[0x6FA,1,0];
+static bool log_erase(uint8_t sector) {
+	return Board_Flash_Erase(EVENT_LOG_FIRST_SECTOR + sector);
+}
 
-static uint32_t (*info1[])[3]= {&vel1,&vel1,&throt_acc,&throt_break,&motor_curr,&motor_speed, &motor_volt,&motor_torque,&motor_torque,&min_cell_temp,&max_cell_temp,&cmu_with_min_temp, &cmu_with_max_temp,&min_cell_voltage,&max_cell_voltage,&cmu_with_min_voltage,&cell_with_min_voltage, &cmu_with_max_voltage,&cell_with_max_voltage,&battery_voltage,&battery_current};
+static bool log_program(uint32_t offset, const uint32_t *page) {
+	return Board_Flash_Program(EVENT_LOG_BASE + offset, page);
+}
 
-static uint32_t (*info2[])[3]={&drive_key,&drive_status,&motor_shut_ok};
+/**
+ * One line per record: sequence number, type, code, data, timestamp
+ */
+static void print_event(const EVENT_LOG_RECORD_T *record) {
+	Board_UART_Print("L,");
+	Board_UART_PrintNum(record->seq, 10, false);
+	Board_UART_Print(",");
+	Board_UART_PrintNum(record->type, 10, false);
+	Board_UART_Print(",");
+	Board_UART_PrintNum(record->code, 10, false);
+	Board_UART_Print(",");
+	Board_UART_PrintNum(record->data, 10, false);
+	Board_UART_Print(",");
+	Board_UART_PrintNum(record->timestamp, 10, true);
+}
 
-// -------------------------------------------------------------
-// Helper Functions
+static void print_event_log(void) {
+	const EVENT_LOG_STATS_T *stats = EventLog_GetStats();
+	uint32_t bad = EventLog_Dump(print_event);
+
+	Board_UART_Print("Log bad_crc:");
+	Board_UART_PrintNum(bad, 10, false);
+	Board_UART_Print(" records:");
+	Board_UART_PrintNum(stats->records, 10, false);
+	Board_UART_Print(" pages:");
+	Board_UART_PrintNum(stats->pages, 10, false);
+	Board_UART_Print(" erases:");
+	Board_UART_PrintNum(stats->erases, 10, false);
+	Board_UART_Print(" failed:");
+	Board_UART_PrintNum(stats->failed, 10, true);
+}
 
 /**
- * Delay the processor for a given number of milliseconds
- * @param ms Number of milliseconds to delay
+ * Print the latest pack scan and the scan engine timing
  */
-void _delay(uint32_t ms) {
-	uint32_t curTicks = msTicks;
-	while ((msTicks - curTicks) < ms);
+static void print_cell_scan(void) {
+	const CELL_SCAN_T *scan = CellScan_GetLatest();
+	CELL_SCAN_STATS_T stats;
+	LTC6804_WAKE_STATS_T wake;
+	uint8_t i;
+
+	CellScan_GetStats(&stats);
+	Board_UART_Print("Scan ");
+	Board_UART_PrintNum(scan->seq, 10, false);
+	Board_UART_Print(" @");
+	Board_UART_PrintNum(scan->timestamp, 10, false);
+	Board_UART_Print(" rate_mHz:");
+	Board_UART_PrintNum(stats.rate_mHz, 10, false);
+	Board_UART_Print(" conv_ms:");
+	Board_UART_PrintNum(stats.convert_ms, 10, false);
+	Board_UART_Print(" timeouts:");
+	Board_UART_PrintNum(stats.timeouts, 10, false);
+	Board_UART_Print(" pec:0x");
+	Board_UART_PrintNum(scan->pec_errors, 16, true);
+
+	LTC6804Async_GetWakeStats(&wake);
+	Board_UART_Print("Wake cmds:");
+	Board_UART_PrintNum(wake.commands, 10, false);
+	Board_UART_Print(" sleep:");
+	Board_UART_PrintNum(wake.sleep_wakes, 10, false);
+	Board_UART_Print(" idle:");
+	Board_UART_PrintNum(wake.idle_wakes, 10, false);
+	Board_UART_Print(" windows:");
+	Board_UART_PrintNum(wake.windows, 10, false);
+	Board_UART_Print(" us:");
+	Board_UART_PrintNum((wake.bytes * 8000) / (LTC6804_BAUD / 1000), 10, true);
+
+	for (i = 0; i < LTC6804_NUM_DEVICES; i++) {
+		Board_UART_Print(" ");
+		Board_UART_PrintNum(scan->cells[i].groupA[0], 10, false);
+		Board_UART_Print("..");
+		Board_UART_PrintNum(scan->cells[i].groupD[2], 10, true);
+	}
 }
 
-inline static void car_status(int timestamp) {
-	for (int n=0,n<21,n++){
-		Board_UART_PrintNum(info1[n][0],16,false);
-		Board_UART_Print(",");
-		Board_UART_PrintNum(info1[n][1],10,false);
-		Board_UART_Print(",");
-		Board_UART_PrintNum(info1[n][2],10,false);
-		Board_UART_Print(",");
-		Board_UART_PrintNum(timestamp,10,true);
+/**
+ * Fold a freshly published scan into the pack statistics
+ */
+static void update_cell_stats(const CELL_SCAN_T *scan) {
+	uint8_t i;
+	for (i = 0; i < LTC6804_NUM_DEVICES; i++) {
+		uint16_t base = i * CELLS_PER_DEVICE;
+		if (scan->pec_errors & (1 << i)) continue;
+		PackStats_UpdateGroup(&cell_stats, base + 0, scan->cells[i].groupA, 3);
+		PackStats_UpdateGroup(&cell_stats, base + 3, scan->cells[i].groupB, 3);
+		PackStats_UpdateGroup(&cell_stats, base + 6, scan->cells[i].groupC, 3);
+		PackStats_UpdateGroup(&cell_stats, base + 9, scan->cells[i].groupD, 3);
 	}
+}
 
-	for (int m=0,m<3,m++){
-		Board_UART_PrintNum(info2[m][0],16,false);
-		Board_UART_Print(",");
-		Board_UART_PrintNum(info2[m][1],10,false);
-		Board_UART_Print(",");
-		Board_UART_PrintNum(info2[m][2],16,false);
-		Board_UART_Print(",");
-		Board_UART_PrintNum(timestamp,10,true);
+/**
+ * One line pack summary: count, min@cell, max@cell, mean, spread and histogram
+ */
+static void print_pack_summary(void) {
+	PACK_SUMMARY_T summary;
+	uint8_t i;
+
+	PackStats_GetSummary(&cell_stats, &summary);
+	Board_UART_Print("PS n:");
+	Board_UART_PrintNum(summary.count, 10, false);
+	Board_UART_Print(" min:");
+	Board_UART_PrintNum(summary.min, 10, false);
+	Board_UART_Print("@");
+	Board_UART_PrintNum(summary.argmin, 10, false);
+	Board_UART_Print(" max:");
+	Board_UART_PrintNum(summary.max, 10, false);
+	Board_UART_Print("@");
+	Board_UART_PrintNum(summary.argmax, 10, false);
+	Board_UART_Print(" mean:");
+	Board_UART_PrintNum(summary.mean, 10, false);
+	Board_UART_Print(" spread:");
+	Board_UART_PrintNum(summary.spread, 10, false);
+	Board_UART_Print(" hist:");
+	for (i = 0; i < PACK_STATS_HIST_BINS; i++) {
+		Board_UART_PrintNum(cell_stats.hist[i], 10, false);
+		Board_UART_Print(i + 1 < PACK_STATS_HIST_BINS ? "," : "\r\n");
 	}
+}
 
+/**
+ * Chosen bit timing, its sample point and rate error, and the cycles spent
+ * bringing the controller up
+ */
+static void print_can_timing(const char *name, const CAN_TIMING_T *timing, uint32_t cycles) {
+	Board_UART_Print(name);
+	Board_UART_Print(" brp:");
+	Board_UART_PrintNum(timing->brp, 10, false);
+	Board_UART_Print(" tq:");
+	Board_UART_PrintNum(CANTiming_Quanta(timing), 10, false);
+	Board_UART_Print(" sp:");
+	Board_UART_PrintNum(timing->sample_point, 10, false);
+	Board_UART_Print(" sp_err:");
+	Board_UART_PrintNum(timing->sp_error, 10, false);
+	Board_UART_Print(" ppm:");
+	Board_UART_PrintNum(timing->rate_err_ppm, 10, false);
+	Board_UART_Print(" cycles:");
+	Board_UART_PrintNum(cycles, 10, true);
+}
+
+/**
+ * Per route forwarding counts and latency, then MCP2515 SPI cost per frame
+ * and the frame rate since the last report
+ */
+static void print_gateway_stats(void) {
+	uint32_t cycles_per_us = SystemCoreClock / 1000000;
+	MCP2515_FAST_STATS_T spi;
+	uint32_t frames;
+	uint8_t i;
+
+	for (i = 0; i < NUM_GATEWAY_ROUTES; i++) {
+		const GATEWAY_STATS_T *st = Gateway_GetStats(i);
+		if (!st) break;
+		Board_UART_Print("R");
+		Board_UART_PrintNum(i, 10, false);
+		Board_UART_Print(" fwd:");
+		Board_UART_PrintNum(st->forwarded, 10, false);
+		Board_UART_Print(" rate:");
+		Board_UART_PrintNum(st->rate_dropped, 10, false);
+		Board_UART_Print(" busy:");
+		Board_UART_PrintNum(st->busy_dropped, 10, false);
+		Board_UART_Print(" us_max:");
+		Board_UART_PrintNum(st->latency_max / cycles_per_us, 10, false);
+		Board_UART_Print(" us_avg:");
+		Board_UART_PrintNum(st->forwarded ? st->latency_sum / st->forwarded / cycles_per_us : 0, 10, true);
+	}
+	Board_UART_Print("Unrouted ccan:");
+	Board_UART_PrintNum(Gateway_GetUnrouted(GATEWAY_CCAN_TO_MCP), 10, false);
+	Board_UART_Print(" mcp:");
+	Board_UART_PrintNum(Gateway_GetUnrouted(GATEWAY_MCP_TO_CCAN), 10, true);
+
+	MCP2515Fast_GetStats(&spi);
+	frames = spi.frames_rx + spi.frames_tx;
+	Board_UART_Print("MCP2515 rx:");
+	Board_UART_PrintNum(spi.frames_rx, 10, false);
+	Board_UART_Print(" B/f:");
+	Board_UART_PrintNum(spi.frames_rx ? spi.bytes_rx / spi.frames_rx : 0, 10, false);
+	Board_UART_Print(" tx:");
+	Board_UART_PrintNum(spi.frames_tx, 10, false);
+	Board_UART_Print(" B/f:");
+	Board_UART_PrintNum(spi.frames_tx ? spi.bytes_tx / spi.frames_tx : 0, 10, false);
+	Board_UART_Print(" cs:");
+	Board_UART_PrintNum(spi.windows, 10, false);
+	Board_UART_Print(" full:");
+	Board_UART_PrintNum(spi.tx_full, 10, false);
+	Board_UART_Print(" f/s:");
+	Board_UART_PrintNum(msTicks != lastBench ? (frames - lastBenchFrames) * 1000 / (msTicks - lastBench) : 0, 10, true);
+	lastBench = msTicks;
+	lastBenchFrames = frames;
+}
+
+/**
+ * Bleed cells down towards the lowest once every module has reported
+ */
+static void update_mbb_balance(void) {
+	PACK_SUMMARY_T cells, temps;
+
+	MBBPack_GetSummary(&cells, &temps);
+	if (cells.count == MBB_NUM_MODULES * MBB_PACK_CELLS && cells.spread > MBB_BALANCE_WINDOW_MV) {
+		MBBPoll_SetBalance(cells.min + MBB_BALANCE_WINDOW_MV);
+	} else {
+		MBBPoll_SetBalance(0);
+	}
+}
+
+/**
+ * @return highest cell of the A123 pack, 0 unless every module has been heard
+ * from within MBB_STALE_MS
+ */
+static uint16_t mbb_max_cell(void) {
+	PACK_SUMMARY_T cells, temps;
+	uint8_t i;
+
+	// A quiet bus leaves the last voltages in place, the charger must not regulate on them
+	for (i = 0; i < MBB_NUM_MODULES; i++) {
+		if (MBBPack_ModuleAge(i, msTicks) > MBB_STALE_MS) return 0;
+	}
+	MBBPack_GetSummary(&cells, &temps);
+	return (cells.count == MBB_NUM_MODULES * MBB_PACK_CELLS) ? cells.max : 0;
+}
+
+/**
+ * NLG5_CTL on its own message object, refused while the previous one is
+ * still waiting for the bus
+ */
+static bool charger_send(const CCAN_MSG_OBJ_T *msg) {
+	CCAN_MSG_OBJ_T out = *msg;
+
+	out.msgobj = CHARGER_MSGOBJ;
+	return Gateway_SendCCAN(&out);
+}
+
+/**
+ * Charger mode and setpoints, NLG5 readback from the signal store, control
+ * step period, then signal store frame counts and decode times in core clock
+ * cycles
+ */
+static void print_charger(void) {
+	static const char * const modes[] = {"idle", "cc", "cv", "done", "fault"};
+	const CHARGER_STATE_T *state = Charger_GetState();
+	const CHARGER_STATS_T *stats = Charger_GetStats();
+	const SIGNAL_STORE_STATS_T *store = SignalStore_GetStats();
+
+	Board_UART_Print("Charger ");
+	Board_UART_Print(modes[state->mode]);
+	Board_UART_Print(" faults:0x");
+	Board_UART_PrintNum(state->faults, 16, false);
+	Board_UART_Print(" max_cell:");
+	Board_UART_PrintNum(state->max_cell_mV, 10, false);
+	Board_UART_Print(" set:");
+	Board_UART_PrintNum(state->voltage_mVolts, 10, false);
+	Board_UART_Print("mV/");
+	Board_UART_PrintNum(state->current_cAmps, 10, false);
+	Board_UART_Print("cA out:");
+	Board_UART_PrintNum(SignalStore_Get(CAN_SIG_NLG5_ACT_I_OUTPUT_DV) * 100, 10, false);
+	Board_UART_Print("mV/");
+	Board_UART_PrintNum(SignalStore_Get(CAN_SIG_NLG5_ACT_I_OUTPUT_CA), 10, false);
+	Board_UART_Print("cA err:0x");
+	Board_UART_PrintNum(SignalStore_Get(CAN_SIG_NLG5_ERR_ERRORS), 16, false);
+	Board_UART_Println(SignalStore_IsFresh(CAN_MSG_NLG5_STATUS) ? "" : " stale");
+
+	Board_UART_Print("Charger steps:");
+	Board_UART_PrintNum(stats->steps, 10, false);
+	Board_UART_Print(" overruns:");
+	Board_UART_PrintNum(stats->overruns, 10, false);
+	Board_UART_Print(" period:");
+	Board_UART_PrintNum(stats->steps > 1 ? stats->period_min : 0, 10, false);
+	Board_UART_Print("-");
+	Board_UART_PrintNum(stats->period_max, 10, false);
+	Board_UART_Print(" jitter:");
+	Board_UART_PrintNum(stats->steps > 1 ? stats->period_max - stats->period_min : 0, 10, false);
+	Board_UART_Print(" send_failed:");
+	Board_UART_PrintNum(stats->send_failed, 10, true);
+
+	Board_UART_Print("Store frames:");
+	Board_UART_PrintNum(decode_frames, 10, false);
+	Board_UART_Print(" stored:");
+	Board_UART_PrintNum(store->stored, 10, false);
+	Board_UART_Print(" bad_dlc:");
+	Board_UART_PrintNum(store->bad_dlc, 10, false);
+	Board_UART_Print(" unknown:");
+	Board_UART_PrintNum(store->unknown, 10, false);
+	Board_UART_Print(" expired:");
+	Board_UART_PrintNum(store->expired, 10, false);
+	Board_UART_Print(" dropped:");
+	Board_UART_PrintNum(can_rx_dropped, 10, false);
+	Board_UART_Print(" decode:");
+	Board_UART_PrintNum(decode_frames ? decode_sum / decode_frames : 0, 10, false);
+	Board_UART_Print("/");
+	Board_UART_PrintNum(decode_max, 10, true);
+}
+
+/**
+ * A123 pack: per module age and flags, then cell and temperature summaries,
+ * then polling latency and refresh time
+ */
+static void print_mbb_pack(void) {
+	const MBB_PACK_T *pack = MBBPack_Get();
+	const MBB_POLL_STATS_T *poll = MBBPoll_GetStats();
+	PACK_SUMMARY_T cells, temps;
+	uint8_t i;
+
+	for (i = 0; i < pack->num_modules; i++) {
+		uint32_t age = MBBPack_ModuleAge(i, msTicks);
+		Board_UART_Print("MBB ");
+		Board_UART_PrintNum(pack->first_id + i, 10, false);
+		Board_UART_Print(" age:");
+		if (age == MBB_PACK_NEVER) Board_UART_Print("-");
+		else Board_UART_PrintNum(age, 10, false);
+		Board_UART_Print(" min:");
+		Board_UART_PrintNum(pack->modules[i].min_mV, 10, false);
+		Board_UART_Print(" max:");
+		Board_UART_PrintNum(pack->modules[i].max_mV, 10, false);
+		Board_UART_Print(" T:");
+		Board_UART_PrintNum(pack->modules[i].temp_degC, 10, false);
+		Board_UART_Print(" bal:0x");
+		Board_UART_PrintNum(pack->modules[i].bal, 16, false);
+		Board_UART_Print(" flags:");
+		Board_UART_PrintNum(pack->modules[i].flags, 10, true);
+	}
+
+	MBBPack_GetSummary(&cells, &temps);
+	Board_UART_Print("MBB cells n:");
+	Board_UART_PrintNum(cells.count, 10, false);
+	Board_UART_Print(" min:");
+	Board_UART_PrintNum(cells.min, 10, false);
+	Board_UART_Print("@");
+	Board_UART_PrintNum(cells.argmin, 10, false);
+	Board_UART_Print(" max:");
+	Board_UART_PrintNum(cells.max, 10, false);
+	Board_UART_Print("@");
+	Board_UART_PrintNum(cells.argmax, 10, false);
+	Board_UART_Print(" mean:");
+	Board_UART_PrintNum(cells.mean, 10, false);
+	Board_UART_Print(" T:");
+	Board_UART_PrintNum(temps.count ? temps.min - MBB_PACK_TEMP_OFFSET : 0, 10, false);
+	Board_UART_Print("..");
+	Board_UART_PrintNum(temps.count ? temps.max - MBB_PACK_TEMP_OFFSET : 0, 10, false);
+	Board_UART_Print(" balancing:");
+	Board_UART_PrintNum(pack->balancing, 10, false);
+	Board_UART_Print(" frames:");
+	Board_UART_PrintNum(pack->frames, 10, false);
+	Board_UART_Print(" rejected:");
+	Board_UART_PrintNum(pack->rejected, 10, false);
+	Board_UART_Print(" dropped:");
+	Board_UART_PrintNum(mbb_rx_dropped, 10, true);
+
+	Board_UART_Print("MBB poll sent:");
+	Board_UART_PrintNum(poll->sent, 10, false);
+	Board_UART_Print(" done:");
+	Board_UART_PrintNum(poll->completed, 10, false);
+	Board_UART_Print(" timeouts:");
+	Board_UART_PrintNum(poll->timeouts, 10, false);
+	Board_UART_Print(" missing:");
+	Board_UART_PrintNum(poll->missing, 10, false);
+	Board_UART_Print(" lat:");
+	Board_UART_PrintNum(poll->latency_avg, 10, false);
+	Board_UART_Print("/");
+	Board_UART_PrintNum(poll->latency_max, 10, false);
+	Board_UART_Print(" gap:");
+	Board_UART_PrintNum(poll->interval, 10, false);
+	Board_UART_Print(" refresh:");
+	Board_UART_PrintNum(poll->refresh_ms, 10, true);
 }
 
 // -------------------------------------------------------------
@@ -122,7 +560,9 @@ void CAN_rx(uint8_t msg_obj_num) {
 	/* Now load up the msg_obj structure with the CAN message */
 	LPC_CCAN_API->can_receive(&msg_obj);
 	if (msg_obj_num == 1) {
-		RingBuffer_Insert(&can_rx_buffer, &msg_obj);
+		CANCapture_Record(msg_obj.mode_id, msg_obj.data, msg_obj.dlc, Board_Micros());
+		if (!RingBuffer_Insert(&can_rx_buffer, &msg_obj)) can_rx_dropped++;
+		Gateway_FromCCAN(&msg_obj, msTicks);
 	}
 }
 
@@ -139,17 +579,35 @@ void CAN_tx(uint8_t msg_obj_num) {
 void CAN_error(uint32_t error_info) {
 	can_error_info = error_info;
 	can_error_flag = true;
+	CANCapture_Trigger(CAN_CAPTURE_CAN_ERROR);
+}
+
+/**
+ * Second bus frames not bridged by the gateway, queued for the main loop
+ */
+static void MBB_rx(const CCAN_MSG_OBJ_T *msg) {
+	if (!RingBuffer_Insert(&mbb_rx_buffer, msg)) mbb_rx_dropped++;
 }
 
 // -------------------------------------------------------------
 // Interrupt Service Routines
 
+/**
+ * Port 2 pin interrupt, MCP2515 INT
+ */
+void PIOINT2_IRQHandler(void) {
+	Gateway_MCP2515_IRQHandler(msTicks);
+}
 
 // -------------------------------------------------------------
 // Main Program Loop
 
 int main(void)
 {
+	CAN_TIMING_T ccan_timing;
+	CCAN_MSG_OBJ_T rx_msg;
+	uint32_t start;
+	uint8_t err;
 
 	//---------------
 	// Initialize UART Communication
@@ -165,31 +623,68 @@ int main(void)
 	}
 
 	//---------------
-	// Initialize GPIO and LED as output
+	// Initialize GPIO and LED as output, the LEDs show warnings
 	Board_LEDs_Init();
-	Board_LED_On(LED0);
-
-	//Initialize SSP
-//	Board_SPI_Init();
-//	Board_UART_Println("SPI pins set");
-//	Chip_SSP_Init(LPC_SSP);
-//	Board_UART_Println("SSP initialized");
-//	Chip_SSP_SetBitRate(LPC_SSP, 30000);
-	
-//	Board_UART_Println("Chip SSP set up");
-//	Chip_SSP_SetFormat(LPC_SSP, SSP_DATA_BITS, SSP_FRAMEFORMAT_SPI, SSP_CLOCK_MODE0);
-//	Chip_SSP_SetMaster(LPC_SSP, SSP_MODE_TEST);
-//	Chip_SSP_Enable(LPC_SSP);
-//	Board_UART_Println("SSP Buffer set up");
-//	SSP_Buffer_Init();
+
+	//---------------
+	// Pick the event log up where the last boot left it
+	EventLog_Init(BOARD_FLASH_ADDRESS(EVENT_LOG_BASE), log_erase, log_program);
+	EventLog_Write(EVENT_LOG_BOOT, 0, Board_ResetCause(), msTicks);
+	EventLog_Flush(); 							// A reset loop would otherwise never fill the page
+
+	//---------------
+	// Initialize SSP0 for the MCP2515
+	Board_SPI_Init();
+	Chip_SSP_Init(LPC_SSP);
+	Chip_SSP_SetBitRate(LPC_SSP, MCP2515_SPI_BAUD);
+	Chip_SSP_SetFormat(LPC_SSP, SSP_DATA_BITS, SSP_FRAMEFORMAT_SPI, SSP_CLOCK_MODE0);
+	Chip_SSP_SetMaster(LPC_SSP, true);
+	Chip_SSP_Enable(LPC_SSP);
+
+	//---------------
+	// Initialize the LTC6804 chain and start scanning cell voltages
+	LTC6804Async_Init(LTC6804_BAUD, LTC6804_CS, LTC6804_NUM_DEVICES);
+	LTC6804Async_WriteCFG(msTicks, NULL, NULL);
+	CellScan_Init(LTC6804_ADCV);
+	// 2.8V up in 8 bins of 102.4mV, covers the LiFePO4 working range
+	PackStats_Init(&cell_stats, cell_values, LTC6804_NUM_DEVICES * CELLS_PER_DEVICE, 28000, 10);
+	lastSummary = msTicks;
 	
 	//---------------
 	// Initialize CAN  and CAN Ring Buffer
 
 	RingBuffer_Init(&can_rx_buffer, _rx_buffer, sizeof(CCAN_MSG_OBJ_T), BUFFER_SIZE);
 	RingBuffer_Flush(&can_rx_buffer);
+	SignalStore_Init();
+	Telemetry_Init(Board_UART_Print);
+	Fault_Init();
+	Warning_Init();
+	CANCapture_Arm();
+	Charger_Init(MBB_NUM_MODULES * MBB_PACK_CELLS, CHARGER_CC_CAMPS, CHARGER_MAINS_CAMPS, charger_send, mbb_max_cell);
+
+	start = Board_CycleCount();
+	if (Board_CAN_Init(CCAN_BAUD_RATE, CAN_rx, CAN_tx, CAN_error, &ccan_timing)) {
+		Board_UART_Println("No C_CAN bit timing for CCAN_BAUD_RATE");
+	} else {
+		print_can_timing("C_CAN", &ccan_timing, Board_CycleCount() - start);
+	}
 
-	Board_CAN_Init(CCAN_BAUD_RATE, CAN_rx, CAN_tx, CAN_error);
+	RingBuffer_Init(&mbb_rx_buffer, _mbb_rx_buffer, sizeof(CCAN_MSG_OBJ_T), MBB_BUFFER_SIZE);
+	MBBPack_Init(MBB_FIRST_ID, MBB_NUM_MODULES);
+	Gateway_SetLocal(MBB_rx);
+
+	start = Board_CycleCount();
+	if ((err = Gateway_Init(gateway_routes, NUM_GATEWAY_ROUTES, MCP2515_CAN_BAUD_KHZ, MCP2515_OSC_MHZ, MCP2515_CS, MCP2515_INT)) == 0) {
+		print_can_timing("MCP2515", Gateway_GetTiming(), Board_CycleCount() - start);
+		MBBPoll_Init(MBB_FIRST_ID, MBB_NUM_MODULES, Gateway_SendMCP2515);
+	} else {
+		if (err == GATEWAY_ERR_TIMING) Board_UART_Print("MCP2515 bit rate rejected");
+		else if (err == GATEWAY_ERR_VERIFY) Board_UART_Print("MCP2515 not answering");
+		else if (err == GATEWAY_ERR_ROUTE) Board_UART_Print("Route onto the module responses");
+		else Board_UART_Print("MCP2515 init failed");
+		Board_UART_Print(", gateway disabled, error ");
+		Board_UART_PrintNum(err, 10, true);
+	}
 
 	// For your convenience.
 	// typedef struct CCAN_MSG_OBJ {
@@ -239,127 +734,74 @@ int main(void)
 	*/
 	can_error_flag = false;
 	can_error_info = 0;
-	bool error_flag = false
+	FAULT_SET_T faults;
+	WARNING_SET_T warnings;
+	uint8_t capture_buf[1 + CAN_CAPTURE_RECORD_MAX];
+	uint8_t len, records;
+	uint32_t logged_error = 0;
+	uint32_t dropped, rx_dropped = 0; 			// can_rx_dropped already reported
 	bool send = false;
-	int msTicks = 1000;
-	int lastPrint = msTicks;
+	bool recording = false;
+	lastPrint = msTicks;
+	lastHeartbeat = msTicks;
 	
 	while (1) {
-		if(error_flag){
-			car_status(msTicks)
-			error_flag = false
+		if (CellScan_Update(msTicks)) {
+			update_cell_stats(CellScan_GetLatest());
+		}
+		while (RingBuffer_Pop(&mbb_rx_buffer, &rx_msg)) {
+			MBBPoll_Receive(&rx_msg, msTicks);
+			MBBPack_Receive(&rx_msg, msTicks);
 		}
-		if(lastPrint < msTicks-6000){
+		MBBPoll_Update(msTicks);
+		Charger_Update(msTicks, Board_CycleCount());
+		if (msTicks - lastSummary >= PACK_SUMMARY_PERIOD_MS) {
+			lastSummary = msTicks;
+			print_pack_summary();
+			update_mbb_balance();
+		}
+
+		if (msTicks - lastHeartbeat >= HEARTBEAT_PERIOD_MS) {
+			lastHeartbeat = msTicks;
 			Board_UART_Println("Sending CAN with ID: 0x7F5");
 			msg_obj.msgobj = 2;
 			msg_obj.mode_id = 0x7F5;
 			msg_obj.dlc = 1;
 			msg_obj.data_16[0] = 1;
-			LPC_CCAN_API->can_transmit(&msg_obj);	
+			Gateway_SendCCAN(&msg_obj);
 		}
-		if(lastPrint < msTicks-1000){
-			lastPrint = msTicks;
-			car_status(lastPrint);
+		warnings = 0;
+		while (RingBuffer_Pop(&can_rx_buffer, &rx_msg)) {
+			if (recording) record_frame(&rx_msg, msTicks);
+			if (store_frame(&rx_msg, msTicks)) {
+				warnings |= Warning_Receive(rx_msg.mode_id);
+			}
+			Fault_Receive(rx_msg.mode_id, rx_msg.data, rx_msg.dlc);
 		}
-		if (send) {
-			if (!RingBuffer_IsEmpty(&can_rx_buffer)) {
-				CCAN_MSG_OBJ_T temp_msg;
-				RingBuffer_Pop(&can_rx_buffer, &temp_msg);
-				if (temp_msg.mode_id== drive_key[0]) {		//driver interface
-					drive_key[2]=temp_msg.data_16[0];
-					drive_status[2]=temp_msg.data_16[1];
-				}
-				else if (temp_msg.mode_id==vel1[0]) {	//velocity1
-					vel1[2] = temp_msg.data_16[0];
-				}
-				else if (temp_msg.mode_id==vel2[0]) {	//velocity2
-					vel2[2] = temp_msg.data_16[0];
-				}
-				else if (temp_msg.mode_id==motor_shut_ok[0]) {	//motor interface 
-					motor_shut_ok[2]= temp_msg.data_16[0];
-					motor_curr[2]= temp_msg.data_16[1];
-					motor_speed[2]= temp_msg.data_16[2];
-					motor_volt[2]= temp_msg.data_16[3];
-					motor_torque[2]= temp_msg.data_16[4];
-				}
-				else if (temp_msg.mode_id==throt_acc[0]) { //throttle interface   
-					throt_acc[2]=temp_msg.data[0];
-					throt_break[2]=temp_msg.data[1];
-				}
-				else if (temp_msg.mode_id==pdm_status[0]) { //pdm    
-					low_voltage_bus_battery_flag[2]=(temp_msg.data[0] && 00000001); 
-					low_voltage_DC-DC_status[2]= (temp_msg.data[0] >> 1) && 00000001; 
-					critical_systems_battery_flag[2]=(temp_msg.data[0] >> 2) && 00000001;
-					critical_systems_DC-DC_status[2]=(temp_msg.data[0] >> 3) && 00000001;
-					pdm_status[2]=(temp_msg.data[0] >> 4) && 0001;
-				}
-//				else if (temp_msg.mode_id==0x6F5) {	//pack charge misbalance
-//					balance_soc[2]=temp_msg.data_16[0];
-//					pack_balance_soc[2]=temp_msg.data_16[1];
-//				}
-				else if (temp_msg.mode_id==contactor_1_error[0]) { //precharge_status
-					contactor_1_error[2]=(temp_msg.data_16[0] && 00000001);
-					contactor_2_error[2]=(temp_msg.data_16[0] >> 1) && 00000001;
-					contactor_1_status[2]=(temp_msg.data_16[0] >> 2) && 00000001;
-					contactor_2_status[2]=(temp_msg.data_16[0] >> 3) && 00000001;
-					21v_contactor_status[2]=(temp_msg.data_16[0] >> 4) && 0001;
-					contactor_3_error[2]=(temp_msg.data_16[0] >> 5) && 0001;
-					contactor_3_status[2]=(temp_msg.data_16[0] >> 6) && 0001;
-					precharge_state[2]=(temp_msg.data_16[0] >> 7);
-				}
-				else if (temp_msg.mode_id==min_cell_temp[0]) {	//cell temps
-					min_cell_temp[2]= temp_msg.data_16[0];
-					max_cell_temp[2]= temp_msg.data_16[1];
-					cmu_with_min_temp[2]= temp_msg.data[2];
-					cmu_with_max_temp[2]= temp_msg.data[3];
-				}
-				else if (temp_msg.mode_id==min_cell_voltage[0]) {//cell voltages
-					min_cell_voltage[2]= temp_msg.data_16[0];
-					max_cell_voltage[2]= temp_msg.data_16[1];
-					cmu_with_min_voltage[2]= temp_msg.data_16[2];
-					cell_with_min_voltage[2]= temp_msg.data_16[3];
-					cmu_with_max_voltage[2]= temp_msg.data[4];
-					cell_with_max_voltage[2]= temp_msg.data[5];
-				}
-				else if (temp_msg.mode_id==throt_acc[0]) { //battery current voltage  
-					battery_voltage[2]=temp_msg.data_16[0];
-					battery_current[2]=temp_msg.data_16[1];
-				}
-
-//				if (error_msg >> 7){ heartbeat?		//temporary --> new error handling framework
-//					error_flag = true
-//					if (n) { //more than 7 possible errors 
-//						error_type = error_msg && 01111111
-//					} 
-//					else { // 7 or less possible errors
-//						if (error_msg && 00000001) {
-//							flag1 = true
-//						}
-//						if ((error_msg && 00000010) >> 1) {
-//							flag2 = true
-//						}
-//						if ((error_msg && 00000100) >> 2) {
-//							flag3 = true
-//						}
-//						if ((error_msg && 00001000) >> 3) {
-//							flag4 = true
-//						}
-//						if ((error_msg && 00010000) >> 4) {
-//							flag5 = true
-//						}
-//						if ((error_msg && 00100000) >> 5) {
-//							flag6 = true
-//						}
-//						if ((error_msg && 01000000) >> 6) {
-//							flag7 = true
-//						}
-//					}
-//				}
-				
-				else {
-					break;
-				}
-			}	
+		dropped = can_rx_dropped;
+		if (dropped != rx_dropped) {
+			if (recording) record_gap(dropped - rx_dropped);
+			rx_dropped = dropped;
+		}
+		if (warnings) {
+			show_warnings(warnings, msTicks);
+		}
+		if ((faults = Fault_TakeChanged()) != 0) {
+			report_faults(faults, msTicks);
+			if (faults & Fault_GetState()) CANCapture_Trigger(CAN_CAPTURE_FAULT);
+		}
+		// A few records per pass, so the C_CAN ring drains between them. Each is
+		// introduced by a zero byte like a recorded frame, so text lines may land
+		// in between; the capture waits while recording to keep the two apart
+		capture_buf[0] = 0;
+		for (records = 0; !recording && records < CAPTURE_RECORDS_PER_PASS &&
+				(len = CANCapture_Pack(capture_buf + 1)) != 0; records++) {
+			Board_UART_SendBlocking(capture_buf, 1 + len);
+		}
+		SignalStore_Update(msTicks);
+		if (send && msTicks - lastPrint >= 1000) {
+			lastPrint = msTicks;
+			Telemetry_Signals(lastPrint);
 		}
 
 		if (can_error_flag) {
@@ -367,6 +809,11 @@ int main(void)
 			Board_UART_Print("CAN Error: 0b");
 			itoa(can_error_info, str, 2);
 			Board_UART_Println(str);
+			// A failing bus repeats the same error, log only changes to spare the flash
+			if (can_error_info != logged_error) {
+				logged_error = can_error_info;
+				EventLog_Write(EVENT_LOG_CAN_ERROR, 0, can_error_info, msTicks);
+			}
 		}
 
 		uint8_t count;
@@ -377,48 +824,77 @@ int main(void)
 				case 'p':
 					Board_UART_Println("Sending CAN with ID: 0x305");
 					msg_obj.msgobj = 2;
-					msg_obj.mode_id = 0x305;
-					msg_obj.dlc = 5;
-					msg_obj.data_16[0] = 0x00;
-					msg_obj.data_16[1] = 0x01;
-					msg_obj.data_16[2] = 0x00;
-					msg_obj.data_16[3] = 0x01;
-					LPC_CCAN_API->can_transmit(&msg_obj);
+					msg_obj.mode_id = CAN_POWER_STATUS;
+					msg_obj.dlc = CAN_POWER_STATUS_DLC;
+					msg_obj.data[0] = 0x0A; 	// Both DC-DCs up, no battery flags
+					Gateway_SendCCAN(&msg_obj);
 					break;
 				case 'm':
 					Board_UART_Println("Sending CAN with ID: 0x705");
 					msg_obj.msgobj = 2;
-					msg_obj.mode_id = 0x705;
-					msg_obj.dlc = 7;
+					msg_obj.mode_id = CAN_MOTOR_STATUS;
+					msg_obj.dlc = CAN_MOTOR_STATUS_DLC;
 					msg_obj.data_16[0] = 0x01;
 					msg_obj.data_16[1] = 0x13;
 					msg_obj.data_16[2] = 0x0111;
 					msg_obj.data_16[3] = 0x65;
-					LPC_CCAN_API->can_transmit(&msg_obj);
+					Gateway_SendCCAN(&msg_obj);
 					break;
 				case 'v':
 					Board_UART_Println("Sending CAN with ID: 0x301");
 					msg_obj.msgobj = 2;
-					msg_obj.mode_id = 0x301;
-					msg_obj.dlc = 3;
-					msg_obj.data_16[0] = 0x31;
-					msg_obj.data_16[1] = 0x00;
-					msg_obj.data_16[2] = 0x00;
-					LPC_CCAN_API->can_transmit(&msg_obj);
+					msg_obj.mode_id = CAN_THROTTLE;
+					msg_obj.dlc = CAN_THROTTLE_DLC;
+					msg_obj.data[0] = 0x31; 	// Accelerator
+					msg_obj.data[1] = 0x00; 	// Brake
+					Gateway_SendCCAN(&msg_obj);
 					break;
 				case 'x':
 					Board_UART_Println("Sending CAN with ID: 0x505");
 					msg_obj.msgobj = 2;
-					msg_obj.mode_id = 0x505;
-					msg_obj.dlc = 4;
+					msg_obj.mode_id = CAN_DRIVER_INPUT;
+					msg_obj.dlc = CAN_DRIVER_INPUT_DLC;
 					msg_obj.data_16[0] = 0x0020;
 					msg_obj.data_16[1] = 0x0F00;
-					LPC_CCAN_API->can_transmit(&msg_obj);
+					Gateway_SendCCAN(&msg_obj);
 					break;
 				case 'g':
 					Board_UART_PrintNum(0xFFF, 16, true);
 					break;
-				case 's':	//receive from RaspberryPi
+				case 'c':
+					print_cell_scan();
+					break;
+				case 'b':
+					print_gateway_stats();
+					break;
+				case 'a':
+					print_mbb_pack();
+					break;
+				case 'h':
+					if (Charger_GetState()->mode == CHARGER_CC || Charger_GetState()->mode == CHARGER_CV) {
+						Charger_Stop();
+					} else {
+						Charger_Start(msTicks);
+					}
+					print_charger();
+					break;
+				case 'n':
+					print_charger();
+					break;
+				case 'r':	// Capture the bus around now
+					CANCapture_Trigger(CAN_CAPTURE_COMMAND);
+					break;
+				case 'l':	// Dump the event log
+					print_event_log();
+					break;
+				case 'f':	// Release latched faults
+					Fault_ClearLatched();
+					break;
+				case 'w':	// Toggle recording every car bus frame
+					recording = !recording;
+					Board_UART_Println(recording ? "Recording" : "Recording stopped");
+					break;
+				case 's':	// Toggle signal telemetry
 					send = !send;
 					break;
 				default:
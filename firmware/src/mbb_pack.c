@@ -0,0 +1,156 @@
+#include "mbb_pack.h"
+
+#define CELL_HIST_BASE 2000 					// mV, 8 bins of 256mV up to 4.05V
+#define CELL_HIST_SHIFT 8
+#define TEMP_HIST_BASE 0 						// -40C, 8 bins of 16C up to 88C
+#define TEMP_HIST_SHIFT 4
+
+static MBB_PACK_T _pack;
+
+static uint8_t popcount16(uint16_t v) {
+	uint8_t n = 0;
+	while (v) {
+		v &= v - 1;
+		n++;
+	}
+	return n;
+}
+
+/**
+ * @return pack index of the frame's module, -1 if it is not in the pack
+ */
+static int8_t module_of(uint32_t mode_id) {
+	uint8_t id = MBB_GetModID(mode_id);
+	if (id < _pack.first_id || id - _pack.first_id >= _pack.num_modules) return -1;
+	return id - _pack.first_id;
+}
+
+static bool receive_std(CCAN_MSG_OBJ_T *msg, uint8_t m, uint32_t msTicks) {
+	MBB_MODULE_T *mod = &_pack.modules[m];
+	MBB_STD_T std;
+	uint8_t flags = 0;
+
+	if (MBB_DecodeStd(&std, msg)) return false;
+
+	if (std.cell_overvolt) flags |= MBB_PACK_OVERVOLT;
+	if (std.cell_undervolt) flags |= MBB_PACK_UNDERVOLT;
+	if (std.voltage_mismatch) flags |= MBB_PACK_MISMATCH;
+
+	mod->min_mV = std.mod_min_mVolts;
+	mod->max_mV = std.mod_max_mVolts;
+	mod->temp_degC = (int8_t)std.temp_degC;
+	mod->temp_chn = std.temp_chn;
+	mod->flags = flags;
+	mod->balance_count = std.balance_c_count;
+	mod->response_id = std.response_id;
+	mod->std_ms = msTicks;
+
+	if (flags & MBB_PACK_OVERVOLT) _pack.overvolt |= 1 << m;
+	else _pack.overvolt &= ~(1 << m);
+	if (flags & MBB_PACK_UNDERVOLT) _pack.undervolt |= 1 << m;
+	else _pack.undervolt &= ~(1 << m);
+
+	PackStats_Update(&_pack.temps, m, (int8_t)std.temp_degC + MBB_PACK_TEMP_OFFSET);
+	return true;
+}
+
+static bool receive_ext(CCAN_MSG_OBJ_T *msg, uint8_t m, uint32_t msTicks) {
+	MBB_MODULE_T *mod = &_pack.modules[m];
+	uint8_t range = MBB_GetExtRange(msg->mode_id);
+	uint16_t cells[4];
+	MBB_EXT_T ext;
+	uint8_t i;
+
+	// MBB_DecodeExt only rewrites this range's four balance bits
+	ext.bal = mod->bal;
+	if (MBB_DecodeExt(&ext, msg)) return false;
+
+	for (i = 0; i < 4; i++) {
+		cells[i] = ext.cell_mVolts[range * 4 + i];
+	}
+	PackStats_UpdateGroup(&_pack.cells, m * MBB_PACK_CELLS + range * 4, cells, 4);
+
+	_pack.balancing += popcount16(ext.bal) - popcount16(mod->bal);
+	mod->bal = ext.bal;
+	mod->ext_ms[range] = msTicks;
+	return true;
+}
+
+void MBBPack_Init(uint8_t first_id, uint8_t num_modules) {
+	uint8_t i, r;
+
+	if (num_modules > MBB_PACK_MAX_MODULES) num_modules = MBB_PACK_MAX_MODULES;
+	_pack.first_id = first_id;
+	_pack.num_modules = num_modules;
+	_pack.balancing = 0;
+	_pack.overvolt = 0;
+	_pack.undervolt = 0;
+	_pack.frames = 0;
+	_pack.rejected = 0;
+
+	for (i = 0; i < MBB_PACK_MAX_MODULES; i++) {
+		MBB_MODULE_T *mod = &_pack.modules[i];
+		mod->std_ms = 0;
+		for (r = 0; r < MBB_PACK_EXT_RANGES; r++) {
+			mod->ext_ms[r] = 0;
+		}
+		mod->min_mV = 0;
+		mod->max_mV = 0;
+		mod->temp_degC = 0;
+		mod->temp_chn = 0;
+		mod->flags = 0;
+		mod->balance_count = 0;
+		mod->bal = 0;
+		mod->response_id = 0;
+	}
+
+	PackStats_Init(&_pack.cells, _pack.cell_mV, num_modules * MBB_PACK_CELLS, CELL_HIST_BASE, CELL_HIST_SHIFT);
+	PackStats_Init(&_pack.temps, _pack.temp, num_modules, TEMP_HIST_BASE, TEMP_HIST_SHIFT);
+}
+
+bool MBBPack_Receive(CCAN_MSG_OBJ_T *msg, uint32_t msTicks) {
+	bool ok;
+	int8_t m;
+
+	if (!MBB_IsStandard(msg->mode_id) && !MBB_IsExtended(msg->mode_id)) return false;
+
+	m = module_of(msg->mode_id);
+	if (m < 0) {
+		_pack.rejected++;
+		return false;
+	}
+
+	ok = MBB_IsStandard(msg->mode_id) ? receive_std(msg, m, msTicks) : receive_ext(msg, m, msTicks);
+	if (!ok) {
+		_pack.rejected++;
+		return false;
+	}
+
+	_pack.frames++;
+	return true;
+}
+
+const MBB_PACK_T *MBBPack_Get(void) {
+	return &_pack;
+}
+
+uint32_t MBBPack_ModuleAge(uint8_t module, uint32_t msTicks) {
+	const MBB_MODULE_T *mod;
+	uint32_t oldest;
+	uint8_t r;
+
+	// A range or standard frame still missing leaves its channel invalid
+	if (module >= _pack.num_modules || _pack.temp[module] == PACK_STATS_INVALID) return MBB_PACK_NEVER;
+	mod = &_pack.modules[module];
+	oldest = mod->std_ms;
+	for (r = 0; r < MBB_PACK_EXT_RANGES; r++) {
+		if (_pack.cell_mV[module * MBB_PACK_CELLS + r * 4] == PACK_STATS_INVALID) return MBB_PACK_NEVER;
+		if (msTicks - mod->ext_ms[r] > msTicks - oldest) oldest = mod->ext_ms[r];
+	}
+	return msTicks - oldest;
+}
+
+void MBBPack_GetSummary(PACK_SUMMARY_T *cells, PACK_SUMMARY_T *temps) {
+	PackStats_GetSummary(&_pack.cells, cells);
+	PackStats_GetSummary(&_pack.temps, temps);
+}
@@ -0,0 +1,233 @@
+#include "mbb_poll.h"
+
+#define REQUEST_IDS 16 							// request_id is 4 bits
+
+typedef struct {
+	uint32_t pending; 							// STD: bit per module, EXT: bit per module and range
+	uint32_t sent_ms;
+	uint8_t id;
+	uint8_t type; 								// BCM_REQUEST_TYPE_STD or BCM_REQUEST_TYPE_EXT
+	bool busy;
+} REQUEST_T;
+
+static REQUEST_T _requests[MBB_POLL_DEPTH];
+static bool (*_send)(const CCAN_MSG_OBJ_T *msg);
+static uint8_t _first_id;
+static uint8_t _num_modules;
+static uint16_t _balance_mV;
+
+static uint8_t _next_id;
+static uint8_t _next_type;
+static uint8_t _ext_count;
+static uint32_t _last_send;
+static uint32_t _last_refresh;
+static bool _refreshed;
+static uint32_t _latency_x4; 					// Average latency, 2 fraction bits
+
+static MBB_POLL_STATS_T _stats;
+
+static uint8_t popcount32(uint32_t v) {
+	uint8_t n = 0;
+	while (v) {
+		v &= v - 1;
+		n++;
+	}
+	return n;
+}
+
+static uint32_t all_pending(uint8_t type) {
+	uint8_t bits = (type == BCM_REQUEST_TYPE_EXT) ? _num_modules * MBB_POLL_EXT_RANGES : _num_modules;
+	return (bits >= 32) ? 0xFFFFFFFF : (1UL << bits) - 1;
+}
+
+static bool ext_in_flight(void) {
+	uint8_t i;
+	for (i = 0; i < MBB_POLL_DEPTH; i++) {
+		if (_requests[i].busy && _requests[i].type == BCM_REQUEST_TYPE_EXT) return true;
+	}
+	return false;
+}
+
+/**
+ * @return a 4-bit ID no request in flight is using
+ */
+static uint8_t take_id(void) {
+	uint8_t i, id;
+
+	for (;;) {
+		bool used = false;
+		id = _next_id;
+		_next_id = (_next_id + 1) % REQUEST_IDS;
+		for (i = 0; i < MBB_POLL_DEPTH; i++) {
+			if (_requests[i].busy && _requests[i].id == id) used = true;
+		}
+		if (!used) return id;
+	}
+}
+
+/**
+ * Spread the average latency over the pipeline, within the configured limits
+ */
+static void adapt_interval(void) {
+	uint32_t interval = (_latency_x4 / 4) / MBB_POLL_DEPTH;
+
+	if (interval < MBB_POLL_MIN_INTERVAL_MS) interval = MBB_POLL_MIN_INTERVAL_MS;
+	if (interval > MBB_POLL_MAX_INTERVAL_MS) interval = MBB_POLL_MAX_INTERVAL_MS;
+	_stats.interval = interval;
+}
+
+static void complete(REQUEST_T *req, uint32_t msTicks) {
+	uint32_t latency = msTicks - req->sent_ms;
+
+	req->busy = false;
+	_stats.completed++;
+	if (latency > _stats.latency_max) _stats.latency_max = latency;
+	_latency_x4 += latency - _latency_x4 / 4; 	// Exponential average, weight 1/4
+	_stats.latency_avg = _latency_x4 / 4;
+	adapt_interval();
+
+	if (req->type == BCM_REQUEST_TYPE_EXT) {
+		if (_refreshed) _stats.refresh_ms = msTicks - _last_refresh;
+		_last_refresh = msTicks;
+		_refreshed = true;
+	}
+}
+
+static void send_next(uint32_t msTicks) {
+	REQUEST_T *req = NULL;
+	CCAN_MSG_OBJ_T msg;
+	MBB_CMD_T cmd;
+	uint8_t i;
+
+	for (i = 0; i < MBB_POLL_DEPTH; i++) {
+		if (!_requests[i].busy) req = &_requests[i];
+	}
+	if (!req) return;
+
+	cmd.request_type = _next_type;
+	if (cmd.request_type == BCM_REQUEST_TYPE_EXT && ext_in_flight()) cmd.request_type = BCM_REQUEST_TYPE_STD;
+
+	// Cells are read unloaded on every MBB_POLL_MEASURE_EVERY'th extended request
+	cmd.balance = _balance_mV != 0;
+	if (cmd.request_type == BCM_REQUEST_TYPE_EXT && _ext_count % MBB_POLL_MEASURE_EVERY == 0) cmd.balance = false;
+	cmd.balance_target_mVolts = _balance_mV;
+
+	cmd.request_id = take_id();
+	MBB_MakeCMD(&cmd, &msg);
+	if (!_send(&msg)) {
+		_next_id = cmd.request_id; 				// Reuse the ID on the retry
+		_stats.send_failed++;
+		return;
+	}
+
+	req->id = cmd.request_id;
+	req->type = cmd.request_type;
+	req->pending = all_pending(cmd.request_type);
+	req->sent_ms = msTicks;
+	req->busy = true;
+
+	if (cmd.request_type == BCM_REQUEST_TYPE_EXT) _ext_count++;
+	_next_type = (cmd.request_type == BCM_REQUEST_TYPE_STD) ? BCM_REQUEST_TYPE_EXT : BCM_REQUEST_TYPE_STD;
+	_last_send = msTicks;
+	_stats.sent++;
+}
+
+void MBBPoll_Init(uint8_t first_id, uint8_t num_modules, bool (*send)(const CCAN_MSG_OBJ_T *msg)) {
+	uint8_t i;
+
+	if (num_modules > MBB_POLL_MAX_MODULES) num_modules = MBB_POLL_MAX_MODULES;
+	_first_id = first_id;
+	_num_modules = num_modules;
+	_send = send;
+	_balance_mV = 0;
+
+	for (i = 0; i < MBB_POLL_DEPTH; i++) {
+		_requests[i].busy = false;
+	}
+	_next_id = 0;
+	_next_type = BCM_REQUEST_TYPE_STD;
+	_ext_count = 0;
+	_last_send = 0;
+	_last_refresh = 0;
+	_refreshed = false;
+	_latency_x4 = MBB_POLL_MIN_TIMEOUT_MS * 4 / MBB_POLL_TIMEOUT_FACTOR;
+
+	_stats.sent = 0;
+	_stats.completed = 0;
+	_stats.timeouts = 0;
+	_stats.missing = 0;
+	_stats.send_failed = 0;
+	_stats.unmatched = 0;
+	_stats.latency_avg = _latency_x4 / 4;
+	_stats.latency_max = 0;
+	_stats.refresh_ms = 0;
+	adapt_interval();
+}
+
+void MBBPoll_SetBalance(uint16_t target_mV) {
+	_balance_mV = target_mV;
+}
+
+void MBBPoll_Update(uint32_t msTicks) {
+	uint32_t timeout = (_latency_x4 / 4) * MBB_POLL_TIMEOUT_FACTOR;
+	uint8_t i;
+
+	if (!_send || _num_modules == 0) return;
+	if (timeout < MBB_POLL_MIN_TIMEOUT_MS) timeout = MBB_POLL_MIN_TIMEOUT_MS;
+
+	for (i = 0; i < MBB_POLL_DEPTH; i++) {
+		REQUEST_T *req = &_requests[i];
+		if (!req->busy || msTicks - req->sent_ms < timeout) continue;
+
+		// Count the silent modules and back off before the next send
+		req->busy = false;
+		_stats.timeouts++;
+		_stats.missing += popcount32(req->pending);
+		_stats.interval *= 2;
+		if (_stats.interval > MBB_POLL_MAX_INTERVAL_MS) _stats.interval = MBB_POLL_MAX_INTERVAL_MS;
+	}
+
+	if (msTicks - _last_send >= _stats.interval) send_next(msTicks);
+}
+
+bool MBBPoll_Receive(CCAN_MSG_OBJ_T *msg, uint32_t msTicks) {
+	REQUEST_T *req = NULL;
+	uint32_t bit;
+	uint8_t module = MBB_GetModID(msg->mode_id) - _first_id;
+	uint8_t i;
+
+	if (module >= _num_modules) return false;
+
+	if (MBB_IsStandard(msg->mode_id)) {
+		MBB_STD_T std;
+		if (MBB_DecodeStd(&std, msg)) return false;
+		for (i = 0; i < MBB_POLL_DEPTH; i++) {
+			if (_requests[i].busy && _requests[i].type == BCM_REQUEST_TYPE_STD && _requests[i].id == std.response_id) {
+				req = &_requests[i];
+			}
+		}
+		bit = 1UL << module;
+	} else if (MBB_IsExtended(msg->mode_id)) {
+		uint8_t range = MBB_GetExtRange(msg->mode_id);
+		if (range >= MBB_POLL_EXT_RANGES) return false;
+		for (i = 0; i < MBB_POLL_DEPTH; i++) {
+			if (_requests[i].busy && _requests[i].type == BCM_REQUEST_TYPE_EXT) req = &_requests[i];
+		}
+		bit = 1UL << (module * MBB_POLL_EXT_RANGES + range);
+	} else {
+		return false;
+	}
+
+	if (!req || !(req->pending & bit)) {
+		_stats.unmatched++;
+		return false;
+	}
+
+	req->pending &= ~bit;
+	if (req->pending == 0) complete(req, msTicks);
+	return true;
+}
+
+const MBB_POLL_STATS_T *MBBPoll_GetStats(void) {
+	return &_stats;
+}
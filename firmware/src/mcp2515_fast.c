@@ -0,0 +1,115 @@
+#include "mcp2515_fast.h"
+#include <string.h>
+
+#define MCP2515_FAST_SSP LPC_SSP0
+#define MCP2515_FAST_FIFO_DEPTH 8
+
+#define INSTR_READ_STATUS 0xA0
+#define INSTR_READ_RX(buf) (0x90 | ((buf) << 2)) 	// Starting at RXBnSIDH
+#define INSTR_LOAD_TX(buf) (0x40 | ((buf) << 1)) 	// Starting at TXBnSIDH
+#define INSTR_RTS(buf) (0x80 | (1 << (buf)))
+
+static uint8_t Tx_Buf[MCP2515_FAST_FRAME_LEN];
+static uint8_t Rx_Buf[MCP2515_FAST_FRAME_LEN];
+
+static uint8_t _cs_gpio;
+static uint8_t _cs_pin;
+static MCP2515_FAST_STATS_T _stats;
+
+/**
+ * One chip select window, keeping the TX FIFO topped up without overrunning RX
+ */
+static void transfer(uint8_t len) {
+	uint8_t tx = 0, rx = 0;
+
+	Chip_GPIO_SetPinState(LPC_GPIO, _cs_gpio, _cs_pin, false);
+	while (rx < len) {
+		while (tx < len && (tx - rx) < MCP2515_FAST_FIFO_DEPTH &&
+			   (MCP2515_FAST_SSP->SR & SSP_STAT_TNF)) {
+			MCP2515_FAST_SSP->DR = Tx_Buf[tx++];
+		}
+		while (MCP2515_FAST_SSP->SR & SSP_STAT_RNE) {
+			Rx_Buf[rx++] = MCP2515_FAST_SSP->DR;
+		}
+	}
+	Chip_GPIO_SetPinState(LPC_GPIO, _cs_gpio, _cs_pin, true);
+
+	_stats.windows++;
+}
+
+void MCP2515Fast_Init(uint8_t cs_gpio, uint8_t cs_pin) {
+	_cs_gpio = cs_gpio;
+	_cs_pin = cs_pin;
+	Chip_GPIO_WriteDirBit(LPC_GPIO, cs_gpio, cs_pin, true);
+	Chip_GPIO_SetPinState(LPC_GPIO, cs_gpio, cs_pin, true);
+	MCP2515Fast_ResetStats();
+}
+
+uint8_t MCP2515Fast_ReadStatus(void) {
+	Tx_Buf[0] = INSTR_READ_STATUS;
+	Tx_Buf[1] = 0;
+	transfer(2);
+	return Rx_Buf[1];
+}
+
+void MCP2515Fast_ReadRx(uint8_t buf, CCAN_MSG_OBJ_T *msg) {
+	memset(Tx_Buf, 0, MCP2515_FAST_FRAME_LEN);
+	Tx_Buf[0] = INSTR_READ_RX(buf);
+	transfer(MCP2515_FAST_FRAME_LEN);
+
+	msg->mode_id = (Rx_Buf[1] << 3) | (Rx_Buf[2] >> 5);
+	msg->dlc = Rx_Buf[5] & 0x0F;
+	if (msg->dlc > 8) msg->dlc = 8;
+	memcpy(msg->data, Rx_Buf + 6, 8);
+
+	_stats.frames_rx++;
+	_stats.bytes_rx += MCP2515_FAST_FRAME_LEN;
+}
+
+uint8_t MCP2515Fast_Receive(CCAN_MSG_OBJ_T *msgs) {
+	uint8_t status = MCP2515Fast_ReadStatus();
+	uint8_t n = 0;
+
+	_stats.bytes_rx += 2;
+	if (status & MCP2515_STATUS_RX0IF) MCP2515Fast_ReadRx(0, &msgs[n++]);
+	if (status & MCP2515_STATUS_RX1IF) MCP2515Fast_ReadRx(1, &msgs[n++]);
+	return n;
+}
+
+bool MCP2515Fast_Send(const CCAN_MSG_OBJ_T *msg) {
+	uint8_t status = MCP2515Fast_ReadStatus();
+	uint8_t buf, dlc = msg->dlc > 8 ? 8 : msg->dlc;
+
+	_stats.bytes_tx += 2;
+	for (buf = 0; buf < 3; buf++) {
+		if (!(status & MCP2515_STATUS_TXREQ(buf))) break;
+	}
+	if (buf == 3) {
+		_stats.tx_full++;
+		return false;
+	}
+
+	Tx_Buf[0] = INSTR_LOAD_TX(buf);
+	Tx_Buf[1] = (msg->mode_id >> 3) & 0xFF;
+	Tx_Buf[2] = (msg->mode_id & 0x7) << 5;
+	Tx_Buf[3] = 0;
+	Tx_Buf[4] = 0;
+	Tx_Buf[5] = dlc;
+	memcpy(Tx_Buf + 6, msg->data, dlc);
+	transfer(6 + dlc);
+
+	Tx_Buf[0] = INSTR_RTS(buf);
+	transfer(1);
+
+	_stats.frames_tx++;
+	_stats.bytes_tx += 6 + dlc + 1;
+	return true;
+}
+
+void MCP2515Fast_GetStats(MCP2515_FAST_STATS_T *stats) {
+	*stats = _stats;
+}
+
+void MCP2515Fast_ResetStats(void) {
+	memset(&_stats, 0, sizeof(_stats));
+}
@@ -0,0 +1,135 @@
+#include "pack_stats.h"
+
+static uint8_t bin_of(const PACK_STATS_T *stats, uint16_t value) {
+	if (value < stats->hist_base) return 0;
+
+	uint16_t bin = (value - stats->hist_base) >> stats->hist_shift;
+	return bin < PACK_STATS_HIST_BINS ? bin : PACK_STATS_HIST_BINS - 1;
+}
+
+static void rescan(PACK_STATS_T *stats) {
+	uint16_t i;
+	bool first = true;
+
+	for (i = 0; i < stats->num_channels; i++) {
+		uint16_t v = stats->values[i];
+		if (v == PACK_STATS_INVALID) continue;
+
+		if (first || v < stats->min) {
+			stats->min = v;
+			stats->argmin = i;
+		}
+		if (first || v > stats->max) {
+			stats->max = v;
+			stats->argmax = i;
+		}
+		first = false;
+	}
+
+	stats->min_dirty = false;
+	stats->max_dirty = false;
+	stats->rescans++;
+}
+
+void PackStats_Init(PACK_STATS_T *stats, uint16_t *values, uint16_t num_channels, uint16_t hist_base, uint8_t hist_shift) {
+	uint16_t i;
+
+	stats->values = values;
+	stats->num_channels = num_channels;
+	stats->count = 0;
+	stats->sum = 0;
+	stats->min = 0;
+	stats->max = 0;
+	stats->argmin = 0;
+	stats->argmax = 0;
+	stats->min_dirty = false;
+	stats->max_dirty = false;
+	stats->hist_base = hist_base;
+	stats->hist_shift = hist_shift;
+	stats->rescans = 0;
+
+	for (i = 0; i < PACK_STATS_HIST_BINS; i++) {
+		stats->hist[i] = 0;
+	}
+	for (i = 0; i < num_channels; i++) {
+		values[i] = PACK_STATS_INVALID;
+	}
+}
+
+void PackStats_Update(PACK_STATS_T *stats, uint16_t channel, uint16_t value) {
+	uint16_t old = stats->values[channel];
+
+	if (old == value) return;
+	stats->values[channel] = value;
+
+	if (old != PACK_STATS_INVALID) {
+		stats->count--;
+		stats->sum -= old;
+		stats->hist[bin_of(stats, old)]--;
+	}
+
+	if (value == PACK_STATS_INVALID) {
+		// Losing the extreme channel means the next one is unknown
+		if (channel == stats->argmin) stats->min_dirty = true;
+		if (channel == stats->argmax) stats->max_dirty = true;
+		return;
+	}
+
+	stats->count++;
+	stats->sum += value;
+	stats->hist[bin_of(stats, value)]++;
+
+	if (stats->count == 1) {
+		// First valid channel seeds both extremes
+		stats->min = stats->max = value;
+		stats->argmin = stats->argmax = channel;
+		stats->min_dirty = stats->max_dirty = false;
+		return;
+	}
+
+	if (!stats->min_dirty) {
+		if (value <= stats->min) {
+			stats->min = value;
+			stats->argmin = channel;
+		} else if (channel == stats->argmin) {
+			stats->min_dirty = true;
+		}
+	}
+
+	if (!stats->max_dirty) {
+		if (value >= stats->max) {
+			stats->max = value;
+			stats->argmax = channel;
+		} else if (channel == stats->argmax) {
+			stats->max_dirty = true;
+		}
+	}
+}
+
+void PackStats_UpdateGroup(PACK_STATS_T *stats, uint16_t first, const uint16_t *values, uint8_t n) {
+	uint8_t i;
+	for (i = 0; i < n; i++) {
+		PackStats_Update(stats, first + i, values[i]);
+	}
+}
+
+void PackStats_GetSummary(PACK_STATS_T *stats, PACK_SUMMARY_T *summary) {
+	if (stats->count == 0) {
+		summary->count = 0;
+		summary->min = summary->argmin = 0;
+		summary->max = summary->argmax = 0;
+		summary->mean = 0;
+		summary->spread = 0;
+		return;
+	}
+
+	if (stats->min_dirty || stats->max_dirty) rescan(stats);
+
+	summary->count = stats->count;
+	summary->min = stats->min;
+	summary->argmin = stats->argmin;
+	summary->max = stats->max;
+	summary->argmax = stats->argmax;
+	summary->mean = (stats->sum + stats->count / 2) / stats->count;
+	summary->spread = stats->max - stats->min;
+}
@@ -0,0 +1,134 @@
+#include "signal_store.h"
+#include <string.h>
+
+#define NONE 0xFF 								// End of a list, or a message with no timeout
+
+typedef struct {
+	uint32_t timeout_ms;
+	uint8_t head; 								// Oldest arrival, the next to expire
+	uint8_t tail;
+} TIMEOUT_LIST_T;
+
+static CAN_STORE_T _values;
+static SIGNAL_STORE_STATS_T _stats;
+
+static uint32_t _last_ms[CAN_MSGS_COUNT];
+static uint8_t _next[CAN_MSGS_COUNT];
+static uint8_t _prev[CAN_MSGS_COUNT];
+static uint8_t _list_of[CAN_MSGS_COUNT];
+static uint8_t _fresh[(CAN_MSGS_COUNT + 7) / 8];
+static TIMEOUT_LIST_T _lists[CAN_MSGS_COUNT];
+static uint8_t _num_lists;
+
+static void list_remove(uint8_t msg) {
+	TIMEOUT_LIST_T *list = &_lists[_list_of[msg]];
+
+	if (_prev[msg] == NONE) list->head = _next[msg];
+	else _next[_prev[msg]] = _next[msg];
+	if (_next[msg] == NONE) list->tail = _prev[msg];
+	else _prev[_next[msg]] = _prev[msg];
+}
+
+static void list_append(uint8_t msg) {
+	TIMEOUT_LIST_T *list = &_lists[_list_of[msg]];
+
+	_prev[msg] = list->tail;
+	_next[msg] = NONE;
+	if (list->tail == NONE) list->head = msg;
+	else _next[list->tail] = msg;
+	list->tail = msg;
+}
+
+/**
+ * @return the list for a timeout, shared by every message with that timeout
+ */
+static uint8_t list_for(uint32_t timeout_ms) {
+	uint8_t i;
+
+	for (i = 0; i < _num_lists; i++) {
+		if (_lists[i].timeout_ms == timeout_ms) return i;
+	}
+	_lists[i].timeout_ms = timeout_ms;
+	_lists[i].head = NONE;
+	_lists[i].tail = NONE;
+	_num_lists++;
+	return i;
+}
+
+void SignalStore_Init(void) {
+	uint8_t i;
+
+	memset(&_values, 0, sizeof(_values));
+	memset(_fresh, 0, sizeof(_fresh));
+	_stats.stored = 0;
+	_stats.bad_dlc = 0;
+	_stats.unknown = 0;
+	_stats.expired = 0;
+
+	_num_lists = 0;
+	for (i = 0; i < CAN_MSGS_COUNT; i++) {
+		uint16_t period = CANMsgs_Messages[i].period_ms;
+		_list_of[i] = period ? list_for((uint32_t)period * SIGNAL_STORE_TIMEOUT_PERIODS) : NONE;
+	}
+}
+
+bool SignalStore_Receive(uint16_t id, const uint8_t *data, uint8_t dlc, uint32_t msTicks) {
+	const CAN_MSG_DESC_T *desc = CANMsgs_Find(id);
+	uint8_t msg;
+
+	if (!desc) {
+		_stats.unknown++;
+		return false;
+	}
+	if (CANMsgs_Store(&_values, id, data, dlc)) {
+		_stats.bad_dlc++;
+		return false;
+	}
+	_stats.stored++;
+
+	msg = desc - CANMsgs_Messages;
+	_last_ms[msg] = msTicks;
+	if (_list_of[msg] != NONE) {
+		if (SignalStore_IsFresh(msg)) list_remove(msg);
+		list_append(msg);
+	}
+	_fresh[msg >> 3] |= 1 << (msg & 7);
+	return true;
+}
+
+void SignalStore_Update(uint32_t msTicks) {
+	uint8_t i;
+
+	for (i = 0; i < _num_lists; i++) {
+		TIMEOUT_LIST_T *list = &_lists[i];
+		while (list->head != NONE && msTicks - _last_ms[list->head] >= list->timeout_ms) {
+			uint8_t msg = list->head;
+			list_remove(msg);
+			_fresh[msg >> 3] &= ~(1 << (msg & 7));
+			_stats.expired++;
+		}
+	}
+}
+
+bool SignalStore_IsFresh(uint8_t msg) {
+	return (_fresh[msg >> 3] >> (msg & 7)) & 1;
+}
+
+const CAN_STORE_T *SignalStore_Values(void) {
+	return &_values;
+}
+
+int32_t SignalStore_GetIndex(uint8_t index) {
+	const CAN_SIGNAL_META_T *meta = &CANMsgs_Signals[index];
+	const CAN_SIGNAL_DESC_T *desc = &CANMsgs_Messages[meta->msg].signals[meta->signal];
+	uint32_t raw = CANMsgs_Get(&_values, meta->sig);
+	uint32_t sign;
+
+	if (!(desc->flags & CAN_SIGNAL_SIGNED) || desc->length == 32) return (int32_t)raw;
+	sign = 1UL << (desc->length - 1);
+	return (int32_t)(raw ^ sign) - (int32_t)sign;
+}
+
+const SIGNAL_STORE_STATS_T *SignalStore_GetStats(void) {
+	return &_stats;
+}
@@ -0,0 +1,137 @@
+#include "ssp_async.h"
+
+static LPC_SSP_T *_ssp;
+static IRQn_Type _irq;
+
+static SSP_ASYNC_XFER_T *_queue[SSP_ASYNC_QUEUE_SIZE];
+static volatile uint8_t _head; 					// Active transfer
+static volatile uint8_t _count; 				// Active plus queued transfers
+static volatile bool _active; 					// Head transfer is on the wire
+
+/**
+ * Push frames into the TX FIFO, never more than the RX FIFO can hold unread
+ */
+static void fill_tx(SSP_ASYNC_XFER_T *xfer) {
+	while ((_ssp->SR & SSP_STAT_TNF) &&
+		   xfer->tx_cnt < xfer->length &&
+		   (xfer->tx_cnt - xfer->rx_cnt) < SSP_ASYNC_FIFO_DEPTH) {
+		uint8_t frame = SSP_ASYNC_FILL;
+		if (xfer->tx_data && xfer->tx_cnt < xfer->tx_length) {
+			frame = xfer->tx_data[xfer->tx_cnt];
+		}
+		_ssp->DR = frame;
+		xfer->tx_cnt++;
+	}
+}
+
+static void drain_rx(SSP_ASYNC_XFER_T *xfer) {
+	while (_ssp->SR & SSP_STAT_RNE) {
+		uint8_t frame = _ssp->DR;
+		if (xfer->rx_data && xfer->rx_cnt < xfer->length) {
+			xfer->rx_data[xfer->rx_cnt] = frame;
+		}
+		xfer->rx_cnt++;
+	}
+}
+
+static void start(SSP_ASYNC_XFER_T *xfer) {
+	xfer->tx_cnt = 0;
+	xfer->rx_cnt = 0;
+	_active = true;
+	Chip_GPIO_SetPinState(LPC_GPIO, xfer->cs_port, xfer->cs_pin, false);
+	fill_tx(xfer);
+	// RX half full keeps the FIFO moving, RX timeout catches the tail
+	_ssp->IMSC = SSP_RXIM | SSP_RTIM;
+}
+
+void SSP_Async_Init(LPC_SSP_T *ssp, IRQn_Type irq) {
+	_ssp = ssp;
+	_irq = irq;
+	_head = 0;
+	_count = 0;
+	_active = false;
+
+	// Discard anything left in the RX FIFO
+	while (_ssp->SR & SSP_STAT_RNE) {
+		(void)_ssp->DR;
+	}
+	_ssp->IMSC = 0;
+	_ssp->ICR = SSP_ICR_BITMASK;
+	NVIC_EnableIRQ(_irq);
+}
+
+/**
+ * @return true if xfer is active or waiting, call with the interrupt off
+ */
+static bool queued(const SSP_ASYNC_XFER_T *xfer) {
+	uint8_t i;
+
+	for (i = 0; i < _count; i++) {
+		if (_queue[(_head + i) % SSP_ASYNC_QUEUE_SIZE] == xfer) return true;
+	}
+	return false;
+}
+
+bool SSP_Async_Submit(SSP_ASYNC_XFER_T *xfer) {
+	bool ok = true;
+
+	NVIC_DisableIRQ(_irq);
+	// A descriptor left alone keeps its done flag and repeat count
+	if (_count == SSP_ASYNC_QUEUE_SIZE || queued(xfer)) {
+		ok = false;
+	} else {
+		xfer->done = false;
+		xfer->repeat_left = xfer->repeat;
+		_queue[(_head + _count) % SSP_ASYNC_QUEUE_SIZE] = xfer;
+		_count++;
+		// Idle with transfers queued when a completion callback submits, the
+		// oldest goes first
+		if (!_active) start(_queue[_head]);
+	}
+	NVIC_EnableIRQ(_irq);
+
+	return ok;
+}
+
+bool SSP_Async_IsIdle(void) {
+	return _count == 0;
+}
+
+void SSP_Async_IRQHandler(void) {
+	SSP_ASYNC_XFER_T *xfer;
+
+	_ssp->ICR = SSP_ICR_BITMASK;
+	if (_count == 0) {
+		_ssp->IMSC = 0;
+		return;
+	}
+
+	xfer = _queue[_head];
+	drain_rx(xfer);
+	if (xfer->rx_cnt < xfer->length) {
+		fill_tx(xfer);
+		return;
+	}
+
+	// Window complete, every frame has been clocked back in
+	Chip_GPIO_SetPinState(LPC_GPIO, xfer->cs_port, xfer->cs_pin, true);
+	if (xfer->repeat_left) {
+		xfer->repeat_left--;
+		start(xfer);
+		return;
+	}
+
+	_head = (_head + 1) % SSP_ASYNC_QUEUE_SIZE;
+	_count--;
+	_active = false;
+	xfer->done = true;
+	if (xfer->callback) xfer->callback(xfer);
+
+	// A callback that queued more work has already had Submit start the head
+	if (_active) return;
+	if (_count) {
+		start(_queue[_head]);
+	} else {
+		_ssp->IMSC = 0;
+	}
+}
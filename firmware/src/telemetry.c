@@ -0,0 +1,60 @@
+#include "telemetry.h"
+#include "util.h"
+
+static void (*_print)(const char *str);
+
+static void print_num(int32_t num, uint8_t base, bool crlf) {
+	char str[12];
+
+	itoa(num, str, base);
+	_print(str);
+	if (crlf) _print("\r\n");
+}
+
+void Telemetry_Init(void (*print)(const char *str)) {
+	_print = print;
+}
+
+void Telemetry_Signals(uint32_t timestamp) {
+	uint8_t i;
+
+	for (i = 0; i < CAN_SIGNALS_COUNT; i++) {
+		const CAN_SIGNAL_META_T *meta = &CANMsgs_Signals[i];
+		print_num(CANMsgs_Messages[meta->msg].id, 16, false);
+		_print(",");
+		print_num(meta->signal, 10, false);
+		_print(",");
+		print_num(SignalStore_GetIndex(i), 10, false);
+		_print(",");
+		print_num(timestamp, 10, false);
+		_print(SignalStore_IsFresh(meta->msg) ? ",1\r\n" : ",0\r\n");
+	}
+}
+
+void Telemetry_Faults(FAULT_SET_T changed, uint32_t timestamp) {
+	FAULT_SET_T state = Fault_GetState();
+	uint8_t i;
+
+	for (i = 0; i < FAULT_COUNT; i++) {
+		if (!(changed & FAULT_BIT(i))) continue;
+		_print("F,");
+		_print(Fault_Sources[i].name);
+		_print((state & FAULT_BIT(i)) ? ",1," : ",0,");
+		_print(Fault_Sources[i].severity == FAULT_CRITICAL ? "crit," : "warn,");
+		print_num(timestamp, 10, true);
+	}
+}
+
+void Telemetry_Warnings(WARNING_SET_T changed, uint32_t timestamp) {
+	uint8_t i;
+
+	for (i = 0; i < WARNING_COUNT; i++) {
+		if (!(changed & WARNING_BIT(i))) continue;
+		_print("W,");
+		_print(Warning_Rules[i].name);
+		_print((Warning_GetActive() & WARNING_BIT(i)) ? ",1," : ",0,");
+		print_num(Warning_GetValue(i), 10, false);
+		_print(",");
+		print_num(timestamp, 10, true);
+	}
+}
@@ -0,0 +1,74 @@
+#include "warning.h"
+
+#define NONE 0xFF 								// End of a message's rule list
+
+const WARNING_RULE_T Warning_Rules[WARNING_COUNT] = {
+	// The BMS reports 0 once the pack is connected
+	{"precharge", CAN_SIG_CONTACTORS_PRECHARGE_STATE, 1, 0, WARNING_LED0},
+	{"cell_low", CAN_SIG_CELL_VOLTAGES_MIN_CELL_MV, 2800, 3000, WARNING_LED1},
+	{"cell_hot", CAN_SIG_CELL_TEMPS_MAX_TEMP_DC, 550, 500, WARNING_LED1},
+};
+
+static WARNING_SET_T _active;
+static int32_t _value[WARNING_COUNT];
+static uint8_t _signal[WARNING_COUNT]; 			// Index into CANMsgs_Signals
+static uint8_t _next[WARNING_COUNT];
+static uint8_t _head[CAN_MSGS_COUNT];
+
+void Warning_Init(void) {
+	uint8_t i, j;
+
+	_active = 0;
+	for (i = 0; i < CAN_MSGS_COUNT; i++) {
+		_head[i] = NONE;
+	}
+	for (i = 0; i < WARNING_COUNT; i++) {
+		_value[i] = 0;
+		for (j = 0; j < CAN_SIGNALS_COUNT; j++) {
+			if (CANMsgs_Signals[j].sig == Warning_Rules[i].sig) break;
+		}
+		_signal[i] = j;
+		_next[i] = _head[CANMsgs_Signals[j].msg];
+		_head[CANMsgs_Signals[j].msg] = i;
+	}
+}
+
+WARNING_SET_T Warning_Receive(uint16_t id) {
+	const CAN_MSG_DESC_T *desc = CANMsgs_Find(id);
+	WARNING_SET_T before = _active;
+	uint8_t i;
+
+	if (!desc) return 0;
+
+	for (i = _head[desc - CANMsgs_Messages]; i != NONE; i = _next[i]) {
+		const WARNING_RULE_T *rule = &Warning_Rules[i];
+		int32_t value = SignalStore_GetIndex(_signal[i]);
+		bool high = rule->set > rule->clear;
+
+		_value[i] = value;
+		if (high ? value >= rule->set : value <= rule->set) {
+			_active |= WARNING_BIT(i);
+		} else if (high ? value <= rule->clear : value >= rule->clear) {
+			_active &= ~WARNING_BIT(i);
+		}
+	}
+	return _active ^ before;
+}
+
+WARNING_SET_T Warning_GetActive(void) {
+	return _active;
+}
+
+uint8_t Warning_GetLeds(void) {
+	uint8_t leds = 0;
+	uint8_t i;
+
+	for (i = 0; i < WARNING_COUNT; i++) {
+		if (_active & WARNING_BIT(i)) leds |= Warning_Rules[i].leds;
+	}
+	return leds;
+}
+
+int32_t Warning_GetValue(WARNING_T warning) {
+	return _value[warning];
+}
@@ -2,6 +2,16 @@
 
 static void RunAllTests(void) {
   RUN_TEST_GROUP(Util_Test);
+  RUN_TEST_GROUP(PEC15_Test);
+  RUN_TEST_GROUP(PackStats_Test);
+  RUN_TEST_GROUP(CANTiming_Test);
+  RUN_TEST_GROUP(CANMsgs_Test);
+  RUN_TEST_GROUP(SignalStore_Test);
+  RUN_TEST_GROUP(Fault_Test);
+  RUN_TEST_GROUP(Warning_Test);
+  RUN_TEST_GROUP(CANCapture_Test);
+  RUN_TEST_GROUP(EventLog_Test);
+  RUN_TEST_GROUP(Telemetry_Test);
 }
 
 int main(int argc, char * argv[]) {
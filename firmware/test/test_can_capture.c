@@ -0,0 +1,114 @@
+#include "can_capture.h"
+#include "unity.h"
+#include "unity_fixture.h"
+
+TEST_GROUP(CANCapture_Test);
+
+TEST_SETUP(CANCapture_Test) {
+	CANCapture_Arm();
+}
+
+TEST_TEAR_DOWN(CANCapture_Test) {
+
+}
+
+/**
+ * Record n frames numbered from first, the number in the ID and first byte
+ */
+static void record(uint16_t first, uint16_t n) {
+	uint8_t data[2];
+	uint16_t i;
+
+	for (i = first; i < first + n; i++) {
+		data[0] = i;
+		data[1] = 0xA5;
+		CANCapture_Record(0x100 + i, data, 2, 1000 * i);
+	}
+}
+
+TEST(CANCapture_Test, test_trigger) {
+	uint8_t buf[CAN_CAPTURE_RECORD_MAX];
+	uint16_t i;
+
+	record(0, 100);
+	TEST_ASSERT_EQUAL_INT(CAN_CAPTURE_ARMED, CANCapture_GetState());
+	TEST_ASSERT_EQUAL_UINT8(0, CANCapture_Pack(buf));
+
+	CANCapture_Trigger(CAN_CAPTURE_COMMAND);
+	record(100, CAN_CAPTURE_POST - 1);
+	TEST_ASSERT_EQUAL_INT(CAN_CAPTURE_TRIGGERED, CANCapture_GetState());
+	record(100 + CAN_CAPTURE_POST - 1, 1);
+	TEST_ASSERT_EQUAL_INT(CAN_CAPTURE_FROZEN, CANCapture_GetState());
+
+	// Frozen: later frames and triggers are dropped
+	record(500, 10);
+	CANCapture_Trigger(CAN_CAPTURE_FAULT);
+
+	TEST_ASSERT_EQUAL_UINT8(CAN_CAPTURE_HEADER_SIZE, CANCapture_Pack(buf));
+	TEST_ASSERT_EQUAL_UINT8('C', buf[0]);
+	TEST_ASSERT_EQUAL_UINT8('P', buf[1]);
+	TEST_ASSERT_EQUAL_UINT8(CAN_CAPTURE_VERSION, buf[2]);
+	TEST_ASSERT_EQUAL_UINT8(CAN_CAPTURE_COMMAND, buf[3]);
+	TEST_ASSERT_EQUAL_UINT8(CAN_CAPTURE_DEPTH, buf[4]);
+	TEST_ASSERT_EQUAL_UINT8(CAN_CAPTURE_DEPTH - CAN_CAPTURE_POST, buf[5]);
+
+	// Oldest first, ending with the last post-trigger frame
+	for (i = 100 + CAN_CAPTURE_POST - CAN_CAPTURE_DEPTH; i < 100 + CAN_CAPTURE_POST; i++) {
+		uint32_t us = 1000 * i;
+		TEST_ASSERT_EQUAL_UINT8(8, CANCapture_Pack(buf));
+		TEST_ASSERT_EQUAL_UINT8(us & 0xFF, buf[0]);
+		TEST_ASSERT_EQUAL_UINT8((us >> 8) & 0xFF, buf[1]);
+		TEST_ASSERT_EQUAL_UINT8((us >> 16) & 0xFF, buf[2]);
+		TEST_ASSERT_EQUAL_UINT8(0, buf[3]);
+		TEST_ASSERT_EQUAL_UINT16((0x100 + i) | (2 << 11), buf[4] | (buf[5] << 8));
+		TEST_ASSERT_EQUAL_UINT8(i & 0xFF, buf[6]);
+		TEST_ASSERT_EQUAL_UINT8(0xA5, buf[7]);
+	}
+
+	// Re-armed once the last frame is out
+	TEST_ASSERT_EQUAL_INT(CAN_CAPTURE_ARMED, CANCapture_GetState());
+	TEST_ASSERT_EQUAL_UINT8(0, CANCapture_Pack(buf));
+}
+
+/**
+ * A trigger before the ring fills keeps only what was seen
+ */
+TEST(CANCapture_Test, test_short) {
+	uint8_t buf[CAN_CAPTURE_RECORD_MAX];
+	uint8_t i;
+
+	record(0, 3);
+	CANCapture_Trigger(CAN_CAPTURE_CAN_ERROR);
+	record(3, CAN_CAPTURE_POST);
+
+	TEST_ASSERT_EQUAL_UINT8(CAN_CAPTURE_HEADER_SIZE, CANCapture_Pack(buf));
+	TEST_ASSERT_EQUAL_UINT8(3 + CAN_CAPTURE_POST, buf[4]);
+	TEST_ASSERT_EQUAL_UINT8(3, buf[5]);
+	for (i = 0; i < 3 + CAN_CAPTURE_POST; i++) {
+		TEST_ASSERT_EQUAL_UINT8(8, CANCapture_Pack(buf));
+		TEST_ASSERT_EQUAL_UINT8(i, buf[6]);
+	}
+	TEST_ASSERT_EQUAL_UINT8(0, CANCapture_Pack(buf));
+}
+
+TEST(CANCapture_Test, test_dlc) {
+	uint8_t buf[CAN_CAPTURE_RECORD_MAX];
+	uint8_t data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+	CANCapture_Record(0x7FF, data, 8, 0);
+	CANCapture_Record(0x001, data, 0, 0);
+	CANCapture_Trigger(CAN_CAPTURE_FAULT);
+	record(0, CAN_CAPTURE_POST);
+
+	CANCapture_Pack(buf);
+	TEST_ASSERT_EQUAL_UINT8(CAN_CAPTURE_RECORD_MAX, CANCapture_Pack(buf));
+	TEST_ASSERT_EQUAL_UINT16(0x7FF | (8 << 11), buf[4] | (buf[5] << 8));
+	TEST_ASSERT_EQUAL_UINT8(8, buf[13]);
+	TEST_ASSERT_EQUAL_UINT8(6, CANCapture_Pack(buf));
+}
+
+TEST_GROUP_RUNNER(CANCapture_Test) {
+	RUN_TEST_CASE(CANCapture_Test, test_trigger);
+	RUN_TEST_CASE(CANCapture_Test, test_short);
+	RUN_TEST_CASE(CANCapture_Test, test_dlc);
+}
@@ -0,0 +1,419 @@
+// Generated by tools/dbcgen.py from can/bcm.dbc, do not edit.
+// Run make codegen after changing the description.
+
+#include "can_msgs.h"
+#include "unity.h"
+#include "unity_fixture.h"
+
+TEST_GROUP(CANMsgs_Test);
+
+TEST_SETUP(CANMsgs_Test) {
+
+}
+
+TEST_TEAR_DOWN(CANMsgs_Test) {
+
+}
+
+/**
+ * Bytes computed from the DBC bit positions, then a round trip
+ */
+TEST(CANMsgs_Test, test_throttle) {
+	static const uint8_t expected[CAN_THROTTLE_DLC] = {0x86, 0xB7};
+	CAN_THROTTLE_T msg, decoded;
+	uint8_t data[8];
+
+	msg.accel_pct = 134;
+	msg.brake_pct = 183;
+
+	TEST_ASSERT_EQUAL_UINT8(CAN_THROTTLE_DLC, CANMsgs_EncodeThrottle(&msg, data));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, CAN_THROTTLE_DLC);
+	TEST_ASSERT_EQUAL_INT8(-1, CANMsgs_DecodeThrottle(&decoded, data, CAN_THROTTLE_DLC - 1));
+	TEST_ASSERT_EQUAL_INT8(0, CANMsgs_DecodeThrottle(&decoded, data, CAN_THROTTLE_DLC));
+	TEST_ASSERT_TRUE(msg.accel_pct == decoded.accel_pct);
+	TEST_ASSERT_TRUE(msg.brake_pct == decoded.brake_pct);
+	TEST_ASSERT_EQUAL_UINT16(CAN_THROTTLE, CANMsgs_Find(CAN_THROTTLE)->id);
+}
+
+/**
+ * Bytes computed from the DBC bit positions, then a round trip
+ */
+TEST(CANMsgs_Test, test_power_status) {
+	static const uint8_t expected[CAN_POWER_STATUS_DLC] = {0x1F};
+	CAN_POWER_STATUS_T msg, decoded;
+	uint8_t data[8];
+
+	msg.lv_battery_flag = true;
+	msg.lv_dcdc_status = true;
+	msg.critical_battery_flag = true;
+	msg.critical_dcdc_status = true;
+	msg.pdm_status = true;
+
+	TEST_ASSERT_EQUAL_UINT8(CAN_POWER_STATUS_DLC, CANMsgs_EncodePowerStatus(&msg, data));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, CAN_POWER_STATUS_DLC);
+	TEST_ASSERT_EQUAL_INT8(-1, CANMsgs_DecodePowerStatus(&decoded, data, CAN_POWER_STATUS_DLC - 1));
+	TEST_ASSERT_EQUAL_INT8(0, CANMsgs_DecodePowerStatus(&decoded, data, CAN_POWER_STATUS_DLC));
+	TEST_ASSERT_TRUE(msg.lv_battery_flag == decoded.lv_battery_flag);
+	TEST_ASSERT_TRUE(msg.lv_dcdc_status == decoded.lv_dcdc_status);
+	TEST_ASSERT_TRUE(msg.critical_battery_flag == decoded.critical_battery_flag);
+	TEST_ASSERT_TRUE(msg.critical_dcdc_status == decoded.critical_dcdc_status);
+	TEST_ASSERT_TRUE(msg.pdm_status == decoded.pdm_status);
+	TEST_ASSERT_EQUAL_UINT16(CAN_POWER_STATUS, CANMsgs_Find(CAN_POWER_STATUS)->id);
+}
+
+/**
+ * Bytes computed from the DBC bit positions, then a round trip
+ */
+TEST(CANMsgs_Test, test_driver_input) {
+	static const uint8_t expected[CAN_DRIVER_INPUT_DLC] = {0x1B, 0x3E, 0x0D, 0x1F};
+	CAN_DRIVER_INPUT_T msg, decoded;
+	uint8_t data[8];
+
+	msg.key_state = 15899;
+	msg.drive_status = 7949;
+
+	TEST_ASSERT_EQUAL_UINT8(CAN_DRIVER_INPUT_DLC, CANMsgs_EncodeDriverInput(&msg, data));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, CAN_DRIVER_INPUT_DLC);
+	TEST_ASSERT_EQUAL_INT8(-1, CANMsgs_DecodeDriverInput(&decoded, data, CAN_DRIVER_INPUT_DLC - 1));
+	TEST_ASSERT_EQUAL_INT8(0, CANMsgs_DecodeDriverInput(&decoded, data, CAN_DRIVER_INPUT_DLC));
+	TEST_ASSERT_TRUE(msg.key_state == decoded.key_state);
+	TEST_ASSERT_TRUE(msg.drive_status == decoded.drive_status);
+	TEST_ASSERT_EQUAL_UINT16(CAN_DRIVER_INPUT, CANMsgs_Find(CAN_DRIVER_INPUT)->id);
+}
+
+/**
+ * Bytes computed from the DBC bit positions, then a round trip
+ */
+TEST(CANMsgs_Test, test_contactors) {
+	static const uint8_t expected[CAN_CONTACTORS_DLC] = {0xFF, 0x86};
+	CAN_CONTACTORS_T msg, decoded;
+	uint8_t data[8];
+
+	msg.contactor_1_error = true;
+	msg.contactor_2_error = true;
+	msg.contactor_1_status = true;
+	msg.contactor_2_status = true;
+	msg.lv_contactor_status = true;
+	msg.contactor_3_error = true;
+	msg.contactor_3_status = true;
+	msg.precharge_state = 269;
+
+	TEST_ASSERT_EQUAL_UINT8(CAN_CONTACTORS_DLC, CANMsgs_EncodeContactors(&msg, data));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, CAN_CONTACTORS_DLC);
+	TEST_ASSERT_EQUAL_INT8(-1, CANMsgs_DecodeContactors(&decoded, data, CAN_CONTACTORS_DLC - 1));
+	TEST_ASSERT_EQUAL_INT8(0, CANMsgs_DecodeContactors(&decoded, data, CAN_CONTACTORS_DLC));
+	TEST_ASSERT_TRUE(msg.contactor_1_error == decoded.contactor_1_error);
+	TEST_ASSERT_TRUE(msg.contactor_2_error == decoded.contactor_2_error);
+	TEST_ASSERT_TRUE(msg.contactor_1_status == decoded.contactor_1_status);
+	TEST_ASSERT_TRUE(msg.contactor_2_status == decoded.contactor_2_status);
+	TEST_ASSERT_TRUE(msg.lv_contactor_status == decoded.lv_contactor_status);
+	TEST_ASSERT_TRUE(msg.contactor_3_error == decoded.contactor_3_error);
+	TEST_ASSERT_TRUE(msg.contactor_3_status == decoded.contactor_3_status);
+	TEST_ASSERT_TRUE(msg.precharge_state == decoded.precharge_state);
+	TEST_ASSERT_EQUAL_UINT16(CAN_CONTACTORS, CANMsgs_Find(CAN_CONTACTORS)->id);
+}
+
+/**
+ * Bytes computed from the DBC bit positions, then a round trip
+ */
+TEST(CANMsgs_Test, test_cell_voltages) {
+	static const uint8_t expected[CAN_CELL_VOLTAGES_DLC] = {0x86, 0x0F, 0xB7, 0xE1, 0xDB, 0x6D, 0x36, 0x1B};
+	CAN_CELL_VOLTAGES_T msg, decoded;
+	uint8_t data[8];
+
+	msg.min_cell_mV = 3974;
+	msg.max_cell_mV = 57783;
+	msg.min_cell_cmu = 219;
+	msg.min_cell_index = 109;
+	msg.max_cell_cmu = 54;
+	msg.max_cell_index = 27;
+
+	TEST_ASSERT_EQUAL_UINT8(CAN_CELL_VOLTAGES_DLC, CANMsgs_EncodeCellVoltages(&msg, data));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, CAN_CELL_VOLTAGES_DLC);
+	TEST_ASSERT_EQUAL_INT8(-1, CANMsgs_DecodeCellVoltages(&decoded, data, CAN_CELL_VOLTAGES_DLC - 1));
+	TEST_ASSERT_EQUAL_INT8(0, CANMsgs_DecodeCellVoltages(&decoded, data, CAN_CELL_VOLTAGES_DLC));
+	TEST_ASSERT_TRUE(msg.min_cell_mV == decoded.min_cell_mV);
+	TEST_ASSERT_TRUE(msg.max_cell_mV == decoded.max_cell_mV);
+	TEST_ASSERT_TRUE(msg.min_cell_cmu == decoded.min_cell_cmu);
+	TEST_ASSERT_TRUE(msg.min_cell_index == decoded.min_cell_index);
+	TEST_ASSERT_TRUE(msg.max_cell_cmu == decoded.max_cell_cmu);
+	TEST_ASSERT_TRUE(msg.max_cell_index == decoded.max_cell_index);
+	TEST_ASSERT_EQUAL_UINT16(CAN_CELL_VOLTAGES, CANMsgs_Find(CAN_CELL_VOLTAGES)->id);
+}
+
+/**
+ * Bytes computed from the DBC bit positions, then a round trip
+ */
+TEST(CANMsgs_Test, test_cell_temps) {
+	static const uint8_t expected[CAN_CELL_TEMPS_DLC] = {0xB7, 0xE1, 0xDB, 0xF0, 0x6D, 0x36};
+	CAN_CELL_TEMPS_T msg, decoded;
+	uint8_t data[8];
+
+	msg.min_temp_dC = -7753;
+	msg.max_temp_dC = -3877;
+	msg.min_temp_cmu = 109;
+	msg.max_temp_cmu = 54;
+
+	TEST_ASSERT_EQUAL_UINT8(CAN_CELL_TEMPS_DLC, CANMsgs_EncodeCellTemps(&msg, data));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, CAN_CELL_TEMPS_DLC);
+	TEST_ASSERT_EQUAL_INT8(-1, CANMsgs_DecodeCellTemps(&decoded, data, CAN_CELL_TEMPS_DLC - 1));
+	TEST_ASSERT_EQUAL_INT8(0, CANMsgs_DecodeCellTemps(&decoded, data, CAN_CELL_TEMPS_DLC));
+	TEST_ASSERT_TRUE(msg.min_temp_dC == decoded.min_temp_dC);
+	TEST_ASSERT_TRUE(msg.max_temp_dC == decoded.max_temp_dC);
+	TEST_ASSERT_TRUE(msg.min_temp_cmu == decoded.min_temp_cmu);
+	TEST_ASSERT_TRUE(msg.max_temp_cmu == decoded.max_temp_cmu);
+	TEST_ASSERT_EQUAL_UINT16(CAN_CELL_TEMPS, CANMsgs_Find(CAN_CELL_TEMPS)->id);
+}
+
+/**
+ * Bytes computed from the DBC bit positions, then a round trip
+ */
+TEST(CANMsgs_Test, test_battery) {
+	static const uint8_t expected[CAN_BATTERY_DLC] = {0xDB, 0xF0, 0x6D, 0xF8};
+	CAN_BATTERY_T msg, decoded;
+	uint8_t data[8];
+
+	msg.voltage_dV = 61659;
+	msg.current_dA = -1939;
+
+	TEST_ASSERT_EQUAL_UINT8(CAN_BATTERY_DLC, CANMsgs_EncodeBattery(&msg, data));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, CAN_BATTERY_DLC);
+	TEST_ASSERT_EQUAL_INT8(-1, CANMsgs_DecodeBattery(&decoded, data, CAN_BATTERY_DLC - 1));
+	TEST_ASSERT_EQUAL_INT8(0, CANMsgs_DecodeBattery(&decoded, data, CAN_BATTERY_DLC));
+	TEST_ASSERT_TRUE(msg.voltage_dV == decoded.voltage_dV);
+	TEST_ASSERT_TRUE(msg.current_dA == decoded.current_dA);
+	TEST_ASSERT_EQUAL_UINT16(CAN_BATTERY, CANMsgs_Find(CAN_BATTERY)->id);
+}
+
+/**
+ * Bytes computed from the DBC bit positions, then a round trip
+ */
+TEST(CANMsgs_Test, test_velocity1) {
+	static const uint8_t expected[CAN_VELOCITY1_DLC] = {0x36, 0x7C};
+	CAN_VELOCITY1_T msg, decoded;
+	uint8_t data[8];
+
+	msg.speed_rpm = 31798;
+
+	TEST_ASSERT_EQUAL_UINT8(CAN_VELOCITY1_DLC, CANMsgs_EncodeVelocity1(&msg, data));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, CAN_VELOCITY1_DLC);
+	TEST_ASSERT_EQUAL_INT8(-1, CANMsgs_DecodeVelocity1(&decoded, data, CAN_VELOCITY1_DLC - 1));
+	TEST_ASSERT_EQUAL_INT8(0, CANMsgs_DecodeVelocity1(&decoded, data, CAN_VELOCITY1_DLC));
+	TEST_ASSERT_TRUE(msg.speed_rpm == decoded.speed_rpm);
+	TEST_ASSERT_EQUAL_UINT16(CAN_VELOCITY1, CANMsgs_Find(CAN_VELOCITY1)->id);
+}
+
+/**
+ * Bytes computed from the DBC bit positions, then a round trip
+ */
+TEST(CANMsgs_Test, test_velocity2) {
+	static const uint8_t expected[CAN_VELOCITY2_DLC] = {0x1B, 0x3E};
+	CAN_VELOCITY2_T msg, decoded;
+	uint8_t data[8];
+
+	msg.speed_rpm = 15899;
+
+	TEST_ASSERT_EQUAL_UINT8(CAN_VELOCITY2_DLC, CANMsgs_EncodeVelocity2(&msg, data));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, CAN_VELOCITY2_DLC);
+	TEST_ASSERT_EQUAL_INT8(-1, CANMsgs_DecodeVelocity2(&decoded, data, CAN_VELOCITY2_DLC - 1));
+	TEST_ASSERT_EQUAL_INT8(0, CANMsgs_DecodeVelocity2(&decoded, data, CAN_VELOCITY2_DLC));
+	TEST_ASSERT_TRUE(msg.speed_rpm == decoded.speed_rpm);
+	TEST_ASSERT_EQUAL_UINT16(CAN_VELOCITY2, CANMsgs_Find(CAN_VELOCITY2)->id);
+}
+
+/**
+ * Bytes computed from the DBC bit positions, then a round trip
+ */
+TEST(CANMsgs_Test, test_motor_status) {
+	static const uint8_t expected[CAN_MOTOR_STATUS_DLC] = {0x0D, 0x1F, 0x86, 0x0F, 0xB7, 0xE1, 0xDB, 0xF0};
+	CAN_MOTOR_STATUS_T msg, decoded;
+	uint8_t data[8];
+
+	msg.shutdown_ok = 7949;
+	msg.current_dA = 3974;
+	msg.speed_rpm = -7753;
+	msg.voltage_dV = 61659;
+
+	TEST_ASSERT_EQUAL_UINT8(CAN_MOTOR_STATUS_DLC, CANMsgs_EncodeMotorStatus(&msg, data));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, CAN_MOTOR_STATUS_DLC);
+	TEST_ASSERT_EQUAL_INT8(-1, CANMsgs_DecodeMotorStatus(&decoded, data, CAN_MOTOR_STATUS_DLC - 1));
+	TEST_ASSERT_EQUAL_INT8(0, CANMsgs_DecodeMotorStatus(&decoded, data, CAN_MOTOR_STATUS_DLC));
+	TEST_ASSERT_TRUE(msg.shutdown_ok == decoded.shutdown_ok);
+	TEST_ASSERT_TRUE(msg.current_dA == decoded.current_dA);
+	TEST_ASSERT_TRUE(msg.speed_rpm == decoded.speed_rpm);
+	TEST_ASSERT_TRUE(msg.voltage_dV == decoded.voltage_dV);
+	TEST_ASSERT_EQUAL_UINT16(CAN_MOTOR_STATUS, CANMsgs_Find(CAN_MOTOR_STATUS)->id);
+}
+
+/**
+ * Bytes computed from the DBC bit positions, then a round trip
+ */
+TEST(CANMsgs_Test, test_nlg5_status) {
+	static const uint8_t expected[CAN_NLG5_STATUS_DLC] = {0xFB, 0xDF, 0x0D, 0x00};
+	CAN_NLG5_STATUS_T msg, decoded;
+	uint8_t data[8];
+
+	msg.power_enabled = true;
+	msg.error_latch = true;
+	msg.limit_warning = true;
+	msg.fan_active = true;
+	msg.mains_type = 5;
+	msg.pilot_detected = true;
+	msg.bypass_detection = 3;
+	msg.limitation = 7949;
+
+	TEST_ASSERT_EQUAL_UINT8(CAN_NLG5_STATUS_DLC, CANMsgs_EncodeNLG5Status(&msg, data));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, CAN_NLG5_STATUS_DLC);
+	TEST_ASSERT_EQUAL_INT8(-1, CANMsgs_DecodeNLG5Status(&decoded, data, CAN_NLG5_STATUS_DLC - 1));
+	TEST_ASSERT_EQUAL_INT8(0, CANMsgs_DecodeNLG5Status(&decoded, data, CAN_NLG5_STATUS_DLC));
+	TEST_ASSERT_TRUE(msg.power_enabled == decoded.power_enabled);
+	TEST_ASSERT_TRUE(msg.error_latch == decoded.error_latch);
+	TEST_ASSERT_TRUE(msg.limit_warning == decoded.limit_warning);
+	TEST_ASSERT_TRUE(msg.fan_active == decoded.fan_active);
+	TEST_ASSERT_TRUE(msg.mains_type == decoded.mains_type);
+	TEST_ASSERT_TRUE(msg.pilot_detected == decoded.pilot_detected);
+	TEST_ASSERT_TRUE(msg.bypass_detection == decoded.bypass_detection);
+	TEST_ASSERT_TRUE(msg.limitation == decoded.limitation);
+	TEST_ASSERT_EQUAL_UINT16(CAN_NLG5_STATUS, CANMsgs_Find(CAN_NLG5_STATUS)->id);
+}
+
+/**
+ * Bytes computed from the DBC bit positions, then a round trip
+ */
+TEST(CANMsgs_Test, test_nlg5_act_i) {
+	static const uint8_t expected[CAN_NLG5_ACT_I_DLC] = {0x0F, 0x86, 0xE1, 0xB7, 0xF0, 0xDB, 0xF8, 0x6D};
+	CAN_NLG5_ACT_I_T msg, decoded;
+	uint8_t data[8];
+
+	msg.mains_cA = 3974;
+	msg.mains_dV = 57783;
+	msg.output_dV = 61659;
+	msg.output_cA = 63597;
+
+	TEST_ASSERT_EQUAL_UINT8(CAN_NLG5_ACT_I_DLC, CANMsgs_EncodeNLG5ActI(&msg, data));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, CAN_NLG5_ACT_I_DLC);
+	TEST_ASSERT_EQUAL_INT8(-1, CANMsgs_DecodeNLG5ActI(&decoded, data, CAN_NLG5_ACT_I_DLC - 1));
+	TEST_ASSERT_EQUAL_INT8(0, CANMsgs_DecodeNLG5ActI(&decoded, data, CAN_NLG5_ACT_I_DLC));
+	TEST_ASSERT_TRUE(msg.mains_cA == decoded.mains_cA);
+	TEST_ASSERT_TRUE(msg.mains_dV == decoded.mains_dV);
+	TEST_ASSERT_TRUE(msg.output_dV == decoded.output_dV);
+	TEST_ASSERT_TRUE(msg.output_cA == decoded.output_cA);
+	TEST_ASSERT_EQUAL_UINT16(CAN_NLG5_ACT_I, CANMsgs_Find(CAN_NLG5_ACT_I)->id);
+}
+
+/**
+ * Bytes computed from the DBC bit positions, then a round trip
+ */
+TEST(CANMsgs_Test, test_nlg5_act_ii) {
+	static const uint8_t expected[CAN_NLG5_ACT_II_DLC] = {0xE1, 0xB7, 0xDB, 0x6D, 0x7C, 0x36, 0x3E, 0x1B};
+	CAN_NLG5_ACT_II_T msg, decoded;
+	uint8_t data[8];
+
+	msg.mains_max_pilot_dA = 57783;
+	msg.mains_max_power_ind_dA = 219;
+	msg.aux_battery_dV = 109;
+	msg.ext_shunt_cAh = 31798;
+	msg.booster_output_cA = 15899;
+
+	TEST_ASSERT_EQUAL_UINT8(CAN_NLG5_ACT_II_DLC, CANMsgs_EncodeNLG5ActII(&msg, data));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, CAN_NLG5_ACT_II_DLC);
+	TEST_ASSERT_EQUAL_INT8(-1, CANMsgs_DecodeNLG5ActII(&decoded, data, CAN_NLG5_ACT_II_DLC - 1));
+	TEST_ASSERT_EQUAL_INT8(0, CANMsgs_DecodeNLG5ActII(&decoded, data, CAN_NLG5_ACT_II_DLC));
+	TEST_ASSERT_TRUE(msg.mains_max_pilot_dA == decoded.mains_max_pilot_dA);
+	TEST_ASSERT_TRUE(msg.mains_max_power_ind_dA == decoded.mains_max_power_ind_dA);
+	TEST_ASSERT_TRUE(msg.aux_battery_dV == decoded.aux_battery_dV);
+	TEST_ASSERT_TRUE(msg.ext_shunt_cAh == decoded.ext_shunt_cAh);
+	TEST_ASSERT_TRUE(msg.booster_output_cA == decoded.booster_output_cA);
+	TEST_ASSERT_EQUAL_UINT16(CAN_NLG5_ACT_II, CANMsgs_Find(CAN_NLG5_ACT_II)->id);
+}
+
+/**
+ * Bytes computed from the DBC bit positions, then a round trip
+ */
+TEST(CANMsgs_Test, test_nlg5_temp) {
+	static const uint8_t expected[CAN_NLG5_TEMP_DLC] = {0xF0, 0xDB, 0xF8, 0x6D, 0x7C, 0x36, 0x3E, 0x1B};
+	CAN_NLG5_TEMP_T msg, decoded;
+	uint8_t data[8];
+
+	msg.power_temp_dC = -3877;
+	msg.temp_1_dC = -1939;
+	msg.temp_2_dC = 31798;
+	msg.temp_3_dC = 15899;
+
+	TEST_ASSERT_EQUAL_UINT8(CAN_NLG5_TEMP_DLC, CANMsgs_EncodeNLG5Temp(&msg, data));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, CAN_NLG5_TEMP_DLC);
+	TEST_ASSERT_EQUAL_INT8(-1, CANMsgs_DecodeNLG5Temp(&decoded, data, CAN_NLG5_TEMP_DLC - 1));
+	TEST_ASSERT_EQUAL_INT8(0, CANMsgs_DecodeNLG5Temp(&decoded, data, CAN_NLG5_TEMP_DLC));
+	TEST_ASSERT_TRUE(msg.power_temp_dC == decoded.power_temp_dC);
+	TEST_ASSERT_TRUE(msg.temp_1_dC == decoded.temp_1_dC);
+	TEST_ASSERT_TRUE(msg.temp_2_dC == decoded.temp_2_dC);
+	TEST_ASSERT_TRUE(msg.temp_3_dC == decoded.temp_3_dC);
+	TEST_ASSERT_EQUAL_UINT16(CAN_NLG5_TEMP, CANMsgs_Find(CAN_NLG5_TEMP)->id);
+}
+
+/**
+ * Bytes computed from the DBC bit positions, then a round trip
+ */
+TEST(CANMsgs_Test, test_nlg5_err) {
+	static const uint8_t expected[CAN_NLG5_ERR_DLC] = {0x6D, 0xF8, 0x70, 0x29, 0x36};
+	CAN_NLG5_ERR_T msg, decoded;
+	uint8_t data[8];
+
+	msg.errors = 695269485;
+	msg.warnings = 54;
+
+	TEST_ASSERT_EQUAL_UINT8(CAN_NLG5_ERR_DLC, CANMsgs_EncodeNLG5Err(&msg, data));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, CAN_NLG5_ERR_DLC);
+	TEST_ASSERT_EQUAL_INT8(-1, CANMsgs_DecodeNLG5Err(&decoded, data, CAN_NLG5_ERR_DLC - 1));
+	TEST_ASSERT_EQUAL_INT8(0, CANMsgs_DecodeNLG5Err(&decoded, data, CAN_NLG5_ERR_DLC));
+	TEST_ASSERT_TRUE(msg.errors == decoded.errors);
+	TEST_ASSERT_TRUE(msg.warnings == decoded.warnings);
+	TEST_ASSERT_EQUAL_UINT16(CAN_NLG5_ERR, CANMsgs_Find(CAN_NLG5_ERR)->id);
+}
+
+/**
+ * Bytes computed from the DBC bit positions, then a round trip
+ */
+TEST(CANMsgs_Test, test_nlg5_ctl) {
+	static const uint8_t expected[CAN_NLG5_CTL_DLC] = {0xE0, 0xF8, 0x6D, 0x7C, 0x36, 0x3E, 0x1B};
+	CAN_NLG5_CTL_T msg, decoded;
+	uint8_t data[8];
+
+	msg.enable = true;
+	msg.clear_error = true;
+	msg.ventilation_request = true;
+	msg.max_mains_dA = 63597;
+	msg.output_dV = 31798;
+	msg.output_dA = 15899;
+
+	TEST_ASSERT_EQUAL_UINT8(CAN_NLG5_CTL_DLC, CANMsgs_EncodeNLG5Ctl(&msg, data));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, CAN_NLG5_CTL_DLC);
+	TEST_ASSERT_EQUAL_INT8(-1, CANMsgs_DecodeNLG5Ctl(&decoded, data, CAN_NLG5_CTL_DLC - 1));
+	TEST_ASSERT_EQUAL_INT8(0, CANMsgs_DecodeNLG5Ctl(&decoded, data, CAN_NLG5_CTL_DLC));
+	TEST_ASSERT_TRUE(msg.enable == decoded.enable);
+	TEST_ASSERT_TRUE(msg.clear_error == decoded.clear_error);
+	TEST_ASSERT_TRUE(msg.ventilation_request == decoded.ventilation_request);
+	TEST_ASSERT_TRUE(msg.max_mains_dA == decoded.max_mains_dA);
+	TEST_ASSERT_TRUE(msg.output_dV == decoded.output_dV);
+	TEST_ASSERT_TRUE(msg.output_dA == decoded.output_dA);
+	TEST_ASSERT_EQUAL_UINT16(CAN_NLG5_CTL, CANMsgs_Find(CAN_NLG5_CTL)->id);
+}
+
+TEST_GROUP_RUNNER(CANMsgs_Test) {
+	RUN_TEST_CASE(CANMsgs_Test, test_throttle);
+	RUN_TEST_CASE(CANMsgs_Test, test_power_status);
+	RUN_TEST_CASE(CANMsgs_Test, test_driver_input);
+	RUN_TEST_CASE(CANMsgs_Test, test_contactors);
+	RUN_TEST_CASE(CANMsgs_Test, test_cell_voltages);
+	RUN_TEST_CASE(CANMsgs_Test, test_cell_temps);
+	RUN_TEST_CASE(CANMsgs_Test, test_battery);
+	RUN_TEST_CASE(CANMsgs_Test, test_velocity1);
+	RUN_TEST_CASE(CANMsgs_Test, test_velocity2);
+	RUN_TEST_CASE(CANMsgs_Test, test_motor_status);
+	RUN_TEST_CASE(CANMsgs_Test, test_nlg5_status);
+	RUN_TEST_CASE(CANMsgs_Test, test_nlg5_act_i);
+	RUN_TEST_CASE(CANMsgs_Test, test_nlg5_act_ii);
+	RUN_TEST_CASE(CANMsgs_Test, test_nlg5_temp);
+	RUN_TEST_CASE(CANMsgs_Test, test_nlg5_err);
+	RUN_TEST_CASE(CANMsgs_Test, test_nlg5_ctl);
+}
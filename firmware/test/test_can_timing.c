@@ -0,0 +1,118 @@
+#include "can_timing.h"
+#include "unity.h"
+#include "unity_fixture.h"
+#include <stdlib.h>
+
+TEST_GROUP(CANTiming_Test);
+
+TEST_SETUP(CANTiming_Test) {
+
+}
+
+TEST_TEAR_DOWN(CANTiming_Test) {
+
+}
+
+/**
+ * A solved timing must reproduce the bit rate and respect every limit
+ */
+static void check_timing(uint32_t clock, uint32_t baud, const CAN_TIMING_LIMITS_T *limits, const CAN_TIMING_T *t) {
+	uint8_t tq = CANTiming_Quanta(t);
+
+	TEST_ASSERT_TRUE(t->brp >= 1 && t->brp <= limits->brp_max);
+	TEST_ASSERT_TRUE(t->tseg1 >= limits->tseg1_min && t->tseg1 <= limits->tseg1_max);
+	TEST_ASSERT_TRUE(t->tseg2 >= limits->tseg2_min && t->tseg2 <= limits->tseg2_max);
+	TEST_ASSERT_TRUE(t->sjw >= 1 && t->sjw <= limits->sjw_max);
+	TEST_ASSERT_TRUE(t->sjw + limits->sjw_margin <= t->tseg2);
+	TEST_ASSERT_TRUE(t->rate_err_ppm <= CAN_TIMING_MAX_RATE_ERR_PPM);
+	TEST_ASSERT_UINT32_WITHIN(baud / 200 + 1, baud, clock / (t->brp * tq));
+	TEST_ASSERT_EQUAL_UINT16((1000 * (1 + t->tseg1) + tq / 2) / tq, t->sample_point);
+}
+
+TEST(CANTiming_Test, test_ccan_500k) {
+	CAN_TIMING_T t;
+
+	TEST_ASSERT_TRUE(CANTiming_Solve(48000000, 500000, CAN_TIMING_SAMPLE_POINT, &CANTiming_CCAN, &t));
+	check_timing(48000000, 500000, &CANTiming_CCAN, &t);
+	TEST_ASSERT_EQUAL_UINT16(6, t.brp);
+	TEST_ASSERT_EQUAL_UINT8(13, t.tseg1);
+	TEST_ASSERT_EQUAL_UINT8(2, t.tseg2);
+	TEST_ASSERT_EQUAL_INT16(0, t.sp_error);
+	TEST_ASSERT_EQUAL_UINT16(0, t.rate_err_ppm);
+	TEST_ASSERT_EQUAL_HEX32(0x1C45, CAN_TIMING_CCAN_BTR(&t));
+}
+
+TEST(CANTiming_Test, test_mcp2515_500k) {
+	CAN_TIMING_T t;
+
+	// 16MHz oscillator, quanta are two oscillator periods per prescaler step
+	TEST_ASSERT_TRUE(CANTiming_Solve(8000000, 500000, CAN_TIMING_SAMPLE_POINT, &CANTiming_MCP2515, &t));
+	check_timing(8000000, 500000, &CANTiming_MCP2515, &t);
+	TEST_ASSERT_EQUAL_UINT16(1, t.brp);
+	TEST_ASSERT_EQUAL_UINT16(875, t.sample_point);
+	TEST_ASSERT_EQUAL_UINT8(1, t.sjw);
+	TEST_ASSERT_EQUAL_HEX8(0x00, CAN_TIMING_MCP2515_CNF1(&t));
+	TEST_ASSERT_EQUAL_HEX8(0xAE, CAN_TIMING_MCP2515_CNF2(&t));
+	TEST_ASSERT_EQUAL_HEX8(0x01, CAN_TIMING_MCP2515_CNF3(&t));
+}
+
+TEST(CANTiming_Test, test_best_sample_point) {
+	CAN_TIMING_T t;
+	uint32_t solved_err;
+	uint8_t tq, tseg1;
+
+	// 1Mbit/s at 8MHz only fits 8 or 4 quanta, 7/8 is exact with 8
+	TEST_ASSERT_TRUE(CANTiming_Solve(8000000, 1000000, 875, &CANTiming_CCAN, &t));
+	TEST_ASSERT_EQUAL_UINT8(8, CANTiming_Quanta(&t));
+	TEST_ASSERT_EQUAL_INT16(0, t.sp_error);
+
+	// No exact split of any exact quanta count may sample closer to 80%
+	TEST_ASSERT_TRUE(CANTiming_Solve(48000000, 250000, 800, &CANTiming_CCAN, &t));
+	solved_err = abs(1000 * (1 + t.tseg1) - 800 * CANTiming_Quanta(&t));
+	for (tq = 4; tq <= 25; tq++) {
+		if (48000000 % (250000 * tq) || 48000000 / (250000 * tq) > 64) continue;
+		for (tseg1 = 2; tseg1 <= 16; tseg1++) {
+			uint32_t err;
+			if (tq < tseg1 + 2 || tq - 1 - tseg1 > 8) continue;
+			err = abs(1000 * (1 + tseg1) - 800 * tq);
+			TEST_ASSERT_TRUE(solved_err * tq <= err * CANTiming_Quanta(&t));
+		}
+	}
+}
+
+TEST(CANTiming_Test, test_inexact_rates) {
+	CAN_TIMING_T t;
+
+	// 95kbit/s needs 505.3 clocks per bit at 48MHz, 506 is closest. Of 22 x 23,
+	// 23 x 22 and 46 x 11, only 11 quanta can sample near 87.5% with TSEG1 <= 16.
+	TEST_ASSERT_TRUE(CANTiming_Solve(48000000, 95000, CAN_TIMING_SAMPLE_POINT, &CANTiming_CCAN, &t));
+	check_timing(48000000, 95000, &CANTiming_CCAN, &t);
+	TEST_ASSERT_EQUAL_UINT16(1458, t.rate_err_ppm);
+	TEST_ASSERT_EQUAL_UINT8(11, CANTiming_Quanta(&t));
+	TEST_ASSERT_EQUAL_UINT16(46, t.brp);
+
+	// Out of reach: too fast for the clock, and too slow for the prescaler
+	TEST_ASSERT_FALSE(CANTiming_Solve(8000000, 3000000, CAN_TIMING_SAMPLE_POINT, &CANTiming_CCAN, &t));
+	TEST_ASSERT_FALSE(CANTiming_Solve(48000000, 10000, CAN_TIMING_SAMPLE_POINT, &CANTiming_CCAN, &t));
+	TEST_ASSERT_FALSE(CANTiming_Solve(48000000, 0, CAN_TIMING_SAMPLE_POINT, &CANTiming_CCAN, &t));
+}
+
+TEST(CANTiming_Test, test_constant_form) {
+	static const CAN_TIMING_T fixed = CAN_TIMING_INIT(48000000, 500000, 16, 875, 2);
+	CAN_TIMING_T t;
+
+	TEST_ASSERT_TRUE(CANTiming_Solve(48000000, 500000, 875, &CANTiming_CCAN, &t));
+	TEST_ASSERT_EQUAL_UINT16(t.brp, fixed.brp);
+	TEST_ASSERT_EQUAL_UINT8(t.tseg1, fixed.tseg1);
+	TEST_ASSERT_EQUAL_UINT8(t.tseg2, fixed.tseg2);
+	TEST_ASSERT_EQUAL_UINT16(t.sample_point, fixed.sample_point);
+	TEST_ASSERT_EQUAL_INT16(t.sp_error, fixed.sp_error);
+}
+
+TEST_GROUP_RUNNER(CANTiming_Test) {
+	RUN_TEST_CASE(CANTiming_Test, test_ccan_500k);
+	RUN_TEST_CASE(CANTiming_Test, test_mcp2515_500k);
+	RUN_TEST_CASE(CANTiming_Test, test_best_sample_point);
+	RUN_TEST_CASE(CANTiming_Test, test_inexact_rates);
+	RUN_TEST_CASE(CANTiming_Test, test_constant_form);
+}
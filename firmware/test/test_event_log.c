@@ -0,0 +1,171 @@
+#include "event_log.h"
+#include <string.h>
+#include "unity.h"
+#include "unity_fixture.h"
+
+TEST_GROUP(EventLog_Test);
+
+static uint8_t flash[EVENT_LOG_SECTORS * EVENT_LOG_SECTOR_SIZE];
+static uint32_t erases[EVENT_LOG_SECTORS];
+static uint32_t dumped, last_seq;
+static bool ordered;
+
+static bool erase(uint8_t sector) {
+	memset(flash + sector * EVENT_LOG_SECTOR_SIZE, 0xFF, EVENT_LOG_SECTOR_SIZE);
+	erases[sector]++;
+	return true;
+}
+
+/**
+ * Programming can only clear bits, like the real flash
+ */
+static bool program(uint32_t offset, const uint32_t *page) {
+	const uint8_t *src = (const uint8_t *)page;
+	uint16_t i;
+
+	for (i = 0; i < EVENT_LOG_PAGE_SIZE; i++) {
+		flash[offset + i] &= src[i];
+	}
+	return true;
+}
+
+static void emit(const EVENT_LOG_RECORD_T *record) {
+	if (dumped && record->seq != last_seq + 1) ordered = false;
+	TEST_ASSERT_EQUAL_UINT32(record->seq * 10, record->timestamp);
+	last_seq = record->seq;
+	dumped++;
+}
+
+static uint32_t dump(void) {
+	dumped = 0;
+	ordered = true;
+	return EventLog_Dump(emit);
+}
+
+/**
+ * Write n records timestamped ten times their expected sequence number
+ */
+static void write_from(uint32_t seq, uint32_t n) {
+	while (n--) {
+		EventLog_Write(EVENT_LOG_FAULT, 1, seq, seq * 10);
+		seq++;
+	}
+}
+
+TEST_SETUP(EventLog_Test) {
+	memset(flash, 0xFF, sizeof(flash));
+	memset(erases, 0, sizeof(erases));
+	EventLog_Init(flash, erase, program);
+}
+
+TEST_TEAR_DOWN(EventLog_Test) {
+
+}
+
+TEST(EventLog_Test, test_staged) {
+	write_from(0, EVENT_LOG_RECORDS - 1);
+	TEST_ASSERT_EQUAL_UINT32(0, EventLog_GetStats()->pages);
+	TEST_ASSERT_EQUAL_UINT32(0, dump());
+	TEST_ASSERT_EQUAL_UINT32(EVENT_LOG_RECORDS - 1, dumped);
+
+	// The page is programmed when it fills, erasing the fresh sector first
+	write_from(EVENT_LOG_RECORDS - 1, 1);
+	TEST_ASSERT_EQUAL_UINT32(1, EventLog_GetStats()->pages);
+	TEST_ASSERT_EQUAL_UINT32(1, erases[0]);
+	dump();
+	TEST_ASSERT_EQUAL_UINT32(EVENT_LOG_RECORDS, dumped);
+	TEST_ASSERT_TRUE(ordered);
+}
+
+TEST(EventLog_Test, test_recover) {
+	uint32_t written = 3 * EVENT_LOG_RECORDS + 5;
+
+	write_from(0, written);
+
+	// Staged records are lost on reset, the sequence picks up after the last page
+	EventLog_Init(flash, erase, program);
+	write_from(3 * EVENT_LOG_RECORDS, EVENT_LOG_RECORDS);
+	dump();
+	TEST_ASSERT_EQUAL_UINT32(4 * EVENT_LOG_RECORDS, dumped);
+	TEST_ASSERT_EQUAL_UINT32(4 * EVENT_LOG_RECORDS - 1, last_seq);
+	TEST_ASSERT_TRUE(ordered);
+	TEST_ASSERT_EQUAL_UINT32(1, erases[0]);
+}
+
+TEST(EventLog_Test, test_flush) {
+	write_from(0, 2);
+	EventLog_Flush();
+	EventLog_Flush();
+	TEST_ASSERT_EQUAL_UINT32(1, EventLog_GetStats()->pages);
+
+	EventLog_Init(flash, erase, program);
+	write_from(2, 1);
+	EventLog_Flush();
+	dump();
+	TEST_ASSERT_EQUAL_UINT32(3, dumped);
+	TEST_ASSERT_TRUE(ordered);
+}
+
+/**
+ * Writing past the end of the log rotates through the sectors, dropping the
+ * oldest one, and recovery still finds the newest
+ */
+TEST(EventLog_Test, test_rotate) {
+	uint32_t sector_records = EVENT_LOG_PAGES * EVENT_LOG_RECORDS;
+	uint32_t written = EVENT_LOG_SECTORS * sector_records + 2 * EVENT_LOG_RECORDS;
+	uint8_t i;
+
+	write_from(0, written);
+	TEST_ASSERT_EQUAL_UINT32(2, erases[0]);
+	for (i = 1; i < EVENT_LOG_SECTORS; i++) {
+		TEST_ASSERT_EQUAL_UINT32(1, erases[i]);
+	}
+	dump();
+	TEST_ASSERT_TRUE(ordered);
+	TEST_ASSERT_EQUAL_UINT32(written - 1, last_seq);
+	TEST_ASSERT_EQUAL_UINT32((EVENT_LOG_SECTORS - 1) * sector_records + 2 * EVENT_LOG_RECORDS, dumped);
+
+	EventLog_Init(flash, erase, program);
+	write_from(written, 1);
+	dump();
+	TEST_ASSERT_TRUE(ordered);
+	TEST_ASSERT_EQUAL_UINT32(written, last_seq);
+}
+
+/**
+ * A full last sector sends the next page to the following sector, or back
+ * to the start of the only one
+ */
+TEST(EventLog_Test, test_recover_full_sector) {
+	uint32_t sector_records = EVENT_LOG_PAGES * EVENT_LOG_RECORDS;
+
+	write_from(0, sector_records);
+	EventLog_Init(flash, erase, program);
+	write_from(sector_records, EVENT_LOG_RECORDS);
+	dump();
+	TEST_ASSERT_TRUE(ordered);
+#if EVENT_LOG_SECTORS > 1
+	TEST_ASSERT_EQUAL_UINT32(1, erases[1]);
+	TEST_ASSERT_EQUAL_UINT32(sector_records + EVENT_LOG_RECORDS, dumped);
+#else
+	// The only sector is erased again, the log starts over
+	TEST_ASSERT_EQUAL_UINT32(2, erases[0]);
+	TEST_ASSERT_EQUAL_UINT32(EVENT_LOG_RECORDS, dumped);
+#endif
+}
+
+TEST(EventLog_Test, test_crc) {
+	write_from(0, EVENT_LOG_RECORDS);
+	flash[sizeof(EVENT_LOG_RECORD_T) + 8] ^= 0x01;
+	TEST_ASSERT_EQUAL_UINT32(1, dump());
+	TEST_ASSERT_EQUAL_UINT32(EVENT_LOG_RECORDS - 1, dumped);
+}
+
+TEST_GROUP_RUNNER(EventLog_Test) {
+	RUN_TEST_CASE(EventLog_Test, test_staged);
+	RUN_TEST_CASE(EventLog_Test, test_recover);
+	RUN_TEST_CASE(EventLog_Test, test_flush);
+	RUN_TEST_CASE(EventLog_Test, test_rotate);
+	RUN_TEST_CASE(EventLog_Test, test_recover_full_sector);
+	RUN_TEST_CASE(EventLog_Test, test_crc);
+}
@@ -0,0 +1,163 @@
+#include "fault.h"
+#include "can_msgs.h"
+#include <string.h>
+#include "unity.h"
+#include "unity_fixture.h"
+
+TEST_GROUP(Fault_Test);
+
+TEST_SETUP(Fault_Test) {
+	Fault_Init();
+}
+
+TEST_TEAR_DOWN(Fault_Test) {
+
+}
+
+static FAULT_SET_T contactors(uint8_t bits) {
+	uint8_t data[CAN_CONTACTORS_DLC] = {0};
+	data[0] = bits;
+	return Fault_Receive(CAN_CONTACTORS, data, CAN_CONTACTORS_DLC);
+}
+
+static FAULT_SET_T power(uint8_t bits) {
+	return Fault_Receive(CAN_POWER_STATUS, &bits, CAN_POWER_STATUS_DLC);
+}
+
+/**
+ * The source's byte and mask must be exactly the bits the DBC encoder sets
+ * for its flag alone
+ */
+static void assert_source(FAULT_T fault, const uint8_t *data, uint8_t dlc) {
+	const FAULT_SOURCE_T *src = &Fault_Sources[fault];
+	uint8_t i;
+
+	for (i = 0; i < dlc; i++) {
+		TEST_ASSERT_EQUAL_HEX8(i == src->byte ? src->mask : 0, data[i]);
+	}
+}
+
+TEST(Fault_Test, test_debounce) {
+	uint8_t i;
+
+	// A single glitch frame is filtered
+	TEST_ASSERT_EQUAL_UINT32(0, power(0x01));
+	TEST_ASSERT_EQUAL_UINT32(0, power(0x00));
+	for (i = 1; i < Fault_Sources[FAULT_LV_BATTERY].debounce; i++) {
+		TEST_ASSERT_EQUAL_UINT32(0, power(0x01));
+	}
+	TEST_ASSERT_EQUAL_UINT32(FAULT_BIT(FAULT_LV_BATTERY), power(0x01));
+	TEST_ASSERT_EQUAL_UINT32(FAULT_BIT(FAULT_LV_BATTERY), Fault_GetActive());
+
+	// Holding the fault is not another edge, clearing is debounced the same way
+	TEST_ASSERT_EQUAL_UINT32(0, power(0x01));
+	for (i = 1; i < Fault_Sources[FAULT_LV_BATTERY].debounce; i++) {
+		TEST_ASSERT_EQUAL_UINT32(0, power(0x00));
+	}
+	TEST_ASSERT_EQUAL_UINT32(FAULT_BIT(FAULT_LV_BATTERY), power(0x00));
+	TEST_ASSERT_EQUAL_UINT32(0, Fault_GetState());
+	TEST_ASSERT_EQUAL_UINT32(0, Fault_GetLatched());
+}
+
+TEST(Fault_Test, test_latch) {
+	FAULT_SET_T both = FAULT_BIT(FAULT_CONTACTOR_1) | FAULT_BIT(FAULT_CONTACTOR_3);
+
+	TEST_ASSERT_EQUAL_UINT32(0, contactors(0x21));
+	TEST_ASSERT_EQUAL_UINT32(both, contactors(0x21));
+	TEST_ASSERT_EQUAL_UINT32(both, Fault_GetLatched());
+
+	// The bus clearing leaves the latch, and no edge, until it is released
+	contactors(0x00);
+	TEST_ASSERT_EQUAL_UINT32(0, contactors(0x00));
+	TEST_ASSERT_EQUAL_UINT32(0, Fault_GetActive());
+	TEST_ASSERT_EQUAL_UINT32(both, Fault_GetState());
+
+	TEST_ASSERT_EQUAL_UINT32(both, Fault_TakeChanged());
+	Fault_ClearLatched();
+	TEST_ASSERT_EQUAL_UINT32(0, Fault_GetState());
+	TEST_ASSERT_EQUAL_UINT32(both, Fault_TakeChanged());
+	TEST_ASSERT_EQUAL_UINT32(0, Fault_TakeChanged());
+}
+
+TEST(Fault_Test, test_latch_held) {
+	contactors(0x02);
+	contactors(0x02);
+	Fault_TakeChanged();
+
+	// Releasing a fault still on the bus changes nothing
+	Fault_ClearLatched();
+	TEST_ASSERT_EQUAL_UINT32(FAULT_BIT(FAULT_CONTACTOR_2), Fault_GetState());
+	TEST_ASSERT_EQUAL_UINT32(0, Fault_TakeChanged());
+}
+
+TEST(Fault_Test, test_active_low) {
+	uint8_t data[CAN_MOTOR_STATUS_DLC] = {0};
+
+	Fault_Receive(CAN_MOTOR_STATUS, data, CAN_MOTOR_STATUS_DLC);
+	Fault_Receive(CAN_MOTOR_STATUS, data, CAN_MOTOR_STATUS_DLC);
+	TEST_ASSERT_EQUAL_UINT32(FAULT_BIT(FAULT_MOTOR_SHUTDOWN), Fault_GetActive());
+
+	data[0] = 0x01;
+	Fault_Receive(CAN_MOTOR_STATUS, data, CAN_MOTOR_STATUS_DLC);
+	Fault_Receive(CAN_MOTOR_STATUS, data, CAN_MOTOR_STATUS_DLC);
+	TEST_ASSERT_EQUAL_UINT32(0, Fault_GetActive());
+}
+
+/**
+ * Other IDs and frames too short to hold the byte leave the debounce alone
+ */
+TEST(Fault_Test, test_other_frames) {
+	uint8_t data[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+	contactors(0x01);
+	TEST_ASSERT_EQUAL_UINT32(0, Fault_Receive(CAN_BATTERY, data, CAN_BATTERY_DLC));
+	TEST_ASSERT_EQUAL_UINT32(0, Fault_Receive(CAN_CONTACTORS, data, 0));
+	TEST_ASSERT_EQUAL_UINT32(FAULT_BIT(FAULT_CONTACTOR_1), contactors(0x01));
+}
+
+/**
+ * Fault_Sources is written by hand, pin every entry to can/bcm.dbc
+ */
+TEST(Fault_Test, test_sources_match_dbc) {
+	CAN_CONTACTORS_T contactors;
+	CAN_POWER_STATUS_T power;
+	CAN_MOTOR_STATUS_T motor;
+	uint8_t data[8];
+
+	memset(&contactors, 0, sizeof(contactors));
+	contactors.contactor_1_error = true;
+	assert_source(FAULT_CONTACTOR_1, data, CANMsgs_EncodeContactors(&contactors, data));
+	memset(&contactors, 0, sizeof(contactors));
+	contactors.contactor_2_error = true;
+	assert_source(FAULT_CONTACTOR_2, data, CANMsgs_EncodeContactors(&contactors, data));
+	memset(&contactors, 0, sizeof(contactors));
+	contactors.contactor_3_error = true;
+	assert_source(FAULT_CONTACTOR_3, data, CANMsgs_EncodeContactors(&contactors, data));
+
+	memset(&power, 0, sizeof(power));
+	power.lv_battery_flag = true;
+	assert_source(FAULT_LV_BATTERY, data, CANMsgs_EncodePowerStatus(&power, data));
+	memset(&power, 0, sizeof(power));
+	power.critical_battery_flag = true;
+	assert_source(FAULT_CRITICAL_BATTERY, data, CANMsgs_EncodePowerStatus(&power, data));
+
+	memset(&motor, 0, sizeof(motor));
+	motor.shutdown_ok = true;
+	assert_source(FAULT_MOTOR_SHUTDOWN, data, CANMsgs_EncodeMotorStatus(&motor, data));
+
+	TEST_ASSERT_EQUAL_UINT16(CAN_CONTACTORS, Fault_Sources[FAULT_CONTACTOR_1].id);
+	TEST_ASSERT_EQUAL_UINT16(CAN_CONTACTORS, Fault_Sources[FAULT_CONTACTOR_2].id);
+	TEST_ASSERT_EQUAL_UINT16(CAN_CONTACTORS, Fault_Sources[FAULT_CONTACTOR_3].id);
+	TEST_ASSERT_EQUAL_UINT16(CAN_POWER_STATUS, Fault_Sources[FAULT_LV_BATTERY].id);
+	TEST_ASSERT_EQUAL_UINT16(CAN_POWER_STATUS, Fault_Sources[FAULT_CRITICAL_BATTERY].id);
+	TEST_ASSERT_EQUAL_UINT16(CAN_MOTOR_STATUS, Fault_Sources[FAULT_MOTOR_SHUTDOWN].id);
+}
+
+TEST_GROUP_RUNNER(Fault_Test) {
+	RUN_TEST_CASE(Fault_Test, test_debounce);
+	RUN_TEST_CASE(Fault_Test, test_latch);
+	RUN_TEST_CASE(Fault_Test, test_latch_held);
+	RUN_TEST_CASE(Fault_Test, test_active_low);
+	RUN_TEST_CASE(Fault_Test, test_other_frames);
+	RUN_TEST_CASE(Fault_Test, test_sources_match_dbc);
+}
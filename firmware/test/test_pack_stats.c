@@ -0,0 +1,124 @@
+#include "pack_stats.h"
+#include "unity.h"
+#include "unity_fixture.h"
+#include <stdlib.h>
+
+#define NUM_CHANNELS 48
+#define RANDOM_UPDATES 20000
+
+static PACK_STATS_T stats;
+static uint16_t values[NUM_CHANNELS];
+
+TEST_GROUP(PackStats_Test);
+
+TEST_SETUP(PackStats_Test) {
+	srand(6804);
+	// 3.0V base, 0.1mV LTC6804 units, 51.2mV bins
+	PackStats_Init(&stats, values, NUM_CHANNELS, 30000, 9);
+}
+
+TEST_TEAR_DOWN(PackStats_Test) {
+
+}
+
+/**
+ * Full rescan reference for the incremental statistics
+ */
+static void check_against_rescan(void) {
+	PACK_SUMMARY_T summary;
+	uint16_t hist[PACK_STATS_HIST_BINS] = {0};
+	uint32_t sum = 0;
+	uint16_t count = 0, min = 0xFFFF, max = 0;
+	uint16_t i;
+
+	for (i = 0; i < NUM_CHANNELS; i++) {
+		uint16_t v = values[i];
+		if (v == PACK_STATS_INVALID) continue;
+		count++;
+		sum += v;
+		if (v < min) min = v;
+		if (v > max) max = v;
+
+		int32_t bin = v < 30000 ? 0 : (v - 30000) >> 9;
+		if (bin >= PACK_STATS_HIST_BINS) bin = PACK_STATS_HIST_BINS - 1;
+		hist[bin]++;
+	}
+
+	PackStats_GetSummary(&stats, &summary);
+	TEST_ASSERT_EQUAL_UINT16(count, summary.count);
+	TEST_ASSERT_EQUAL_UINT16_ARRAY(hist, stats.hist, PACK_STATS_HIST_BINS);
+	if (count == 0) return;
+
+	TEST_ASSERT_EQUAL_UINT16(min, summary.min);
+	TEST_ASSERT_EQUAL_UINT16(max, summary.max);
+	TEST_ASSERT_EQUAL_UINT16(min, values[summary.argmin]);
+	TEST_ASSERT_EQUAL_UINT16(max, values[summary.argmax]);
+	TEST_ASSERT_EQUAL_UINT16((sum + count / 2) / count, summary.mean);
+	TEST_ASSERT_EQUAL_UINT16(max - min, summary.spread);
+}
+
+TEST(PackStats_Test, test_empty) {
+	PACK_SUMMARY_T summary;
+
+	PackStats_GetSummary(&stats, &summary);
+	TEST_ASSERT_EQUAL_UINT16(0, summary.count);
+	TEST_ASSERT_EQUAL_UINT16(0, summary.spread);
+}
+
+TEST(PackStats_Test, test_group_update) {
+	const uint16_t group_a[3] = {36000, 35500, 36500};
+	const uint16_t group_b[3] = {34000, 37000, 36000};
+	PACK_SUMMARY_T summary;
+
+	PackStats_UpdateGroup(&stats, 0, group_a, 3);
+	PackStats_UpdateGroup(&stats, 3, group_b, 3);
+	PackStats_GetSummary(&stats, &summary);
+
+	TEST_ASSERT_EQUAL_UINT16(6, summary.count);
+	TEST_ASSERT_EQUAL_UINT16(34000, summary.min);
+	TEST_ASSERT_EQUAL_UINT16(3, summary.argmin);
+	TEST_ASSERT_EQUAL_UINT16(37000, summary.max);
+	TEST_ASSERT_EQUAL_UINT16(4, summary.argmax);
+	TEST_ASSERT_EQUAL_UINT16(35833, summary.mean);
+	TEST_ASSERT_EQUAL_UINT16(3000, summary.spread);
+	check_against_rescan();
+}
+
+TEST(PackStats_Test, test_extreme_moves_away) {
+	const uint16_t group[3] = {35000, 36000, 37000};
+	PACK_SUMMARY_T summary;
+
+	PackStats_UpdateGroup(&stats, 0, group, 3);
+	PackStats_Update(&stats, 0, 36500);
+	PackStats_Update(&stats, 2, PACK_STATS_INVALID);
+	PackStats_GetSummary(&stats, &summary);
+
+	TEST_ASSERT_EQUAL_UINT16(2, summary.count);
+	TEST_ASSERT_EQUAL_UINT16(36000, summary.min);
+	TEST_ASSERT_EQUAL_UINT16(1, summary.argmin);
+	TEST_ASSERT_EQUAL_UINT16(36500, summary.max);
+	TEST_ASSERT_EQUAL_UINT16(0, summary.argmax);
+	TEST_ASSERT_EQUAL_UINT32(1, stats.rescans);
+}
+
+TEST(PackStats_Test, test_random_regression) {
+	uint32_t n;
+
+	for (n = 0; n < RANDOM_UPDATES; n++) {
+		uint16_t channel = rand() % NUM_CHANNELS;
+		uint16_t value = (rand() % 16 == 0) ? PACK_STATS_INVALID : 28000 + rand() % 8000;
+
+		PackStats_Update(&stats, channel, value);
+		if (n % 7 == 0) check_against_rescan();
+	}
+
+	// Only a fraction of updates should have forced a rescan
+	TEST_ASSERT_TRUE(stats.rescans < RANDOM_UPDATES / 7);
+}
+
+TEST_GROUP_RUNNER(PackStats_Test) {
+	RUN_TEST_CASE(PackStats_Test, test_empty);
+	RUN_TEST_CASE(PackStats_Test, test_group_update);
+	RUN_TEST_CASE(PackStats_Test, test_extreme_moves_away);
+	RUN_TEST_CASE(PackStats_Test, test_random_regression);
+}
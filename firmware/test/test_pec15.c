@@ -0,0 +1,148 @@
+#include "pec15.h"
+#include "unity.h"
+#include "unity_fixture.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define RANDOM_VECTORS 10000
+#define BENCH_ROUNDS 200000
+
+TEST_GROUP(PEC15_Test);
+
+TEST_SETUP(PEC15_Test) {
+	srand(6804);
+}
+
+TEST_TEAR_DOWN(PEC15_Test) {
+
+}
+
+/**
+ * Bitwise PEC15 as implemented by LTC6804_CalculatePEC in evt_lib
+ */
+static uint16_t pec15_bitwise(const uint8_t *data, uint8_t len) {
+	int i, j;
+	uint16_t pec = 0x0010;
+
+	for (i = 0; i < len; i++) {
+		for (j = 0; j < 8; j++) {
+			uint16_t din = data[i] >> (7-j) & 1;
+			uint16_t in0 = din ^ (pec >> 14 & 1);
+			uint16_t in3 = ((in0 << 2) ^ (pec & 0x0004)) << 1;
+			uint16_t in4 = ((in0 << 3) ^ (pec & 0x0008)) << 1;
+			uint16_t in7 = ((in0 << 6) ^ (pec & 0x0040)) << 1;
+			uint16_t in8 = ((in0 << 7) ^ (pec & 0x0080)) << 1;
+			uint16_t in10 = ((in0 << 9) ^ (pec & 0x0200)) << 1;
+			uint16_t in14 = ((in0 << 13) ^ (pec & 0x2000)) << 1;
+
+			pec = (pec & ~0x4000) + in14;
+			pec = (pec & ~0x2000) + ((pec & 0x1000) << 1);
+			pec = (pec & ~0x1000) + ((pec & 0x0800) << 1);
+			pec = (pec & ~0x0800) + ((pec & 0x0400) << 1);
+			pec = (pec & ~0x0400) + in10;
+			pec = (pec & ~0x0200) + ((pec & 0x0100) << 1);
+			pec = (pec & ~0x0100) + in8;
+			pec = (pec & ~0x0080) + in7;
+			pec = (pec & ~0x0040) + ((pec & 0x0020) << 1);
+			pec = (pec & ~0x0020) + ((pec & 0x0010) << 1);
+			pec = (pec & ~0x0010) + in4;
+			pec = (pec & ~0x0008) + in3;
+			pec = (pec & ~0x0004) + ((pec & 0x0002) << 1);
+			pec = (pec & ~0x0002) + ((pec & 0x0001) << 1);
+			pec = (pec & ~0x0001) + in0;
+		}
+	}
+
+	return pec << 1;
+}
+
+static void random_bytes(uint8_t *data, uint8_t len) {
+	uint8_t i;
+	for (i = 0; i < len; i++) {
+		data[i] = rand() & 0xFF;
+	}
+}
+
+TEST(PEC15_Test, test_known_commands) {
+	// Datasheet example: RDCVA (0x0004) has PEC 0x07C2
+	uint8_t rdcva[2] = {0x00, 0x04};
+	uint8_t wrcfg[2] = {0x00, 0x01};
+
+	TEST_ASSERT_EQUAL_HEX16(0x07C2, PEC15_CalculateByte(rdcva, 2));
+	TEST_ASSERT_EQUAL_HEX16(0x07C2, PEC15_CalculateNibble(rdcva, 2));
+	TEST_ASSERT_EQUAL_HEX16(pec15_bitwise(wrcfg, 2), PEC15_CalculateByte(wrcfg, 2));
+	TEST_ASSERT_EQUAL_HEX16(PEC15_SEED << 1, PEC15_CalculateByte(wrcfg, 0));
+}
+
+TEST(PEC15_Test, test_random_regression) {
+	uint8_t data[32];
+	uint32_t n;
+
+	for (n = 0; n < RANDOM_VECTORS; n++) {
+		uint8_t len = 1 + rand() % sizeof(data);
+		random_bytes(data, len);
+
+		uint16_t expected = pec15_bitwise(data, len);
+		TEST_ASSERT_EQUAL_HEX16(expected, PEC15_CalculateByte(data, len));
+		TEST_ASSERT_EQUAL_HEX16(expected, PEC15_CalculateNibble(data, len));
+	}
+}
+
+TEST(PEC15_Test, test_check_group) {
+	uint8_t group[6 + PEC15_LENGTH];
+	uint8_t bit;
+
+	random_bytes(group, 6);
+	PEC15_Append(group, 6);
+	TEST_ASSERT_TRUE(PEC15_Check(group, 6));
+
+	// Every single bit error in data or PEC is caught
+	for (bit = 0; bit < 8 * sizeof(group); bit++) {
+		group[bit / 8] ^= 1 << (bit % 8);
+		TEST_ASSERT_FALSE(PEC15_Check(group, 6));
+		group[bit / 8] ^= 1 << (bit % 8);
+	}
+}
+
+TEST(PEC15_Test, test_benchmark) {
+	uint8_t group[6];
+	uint32_t n;
+	volatile uint16_t sink = 0;
+	clock_t start;
+	double bitwise, byte, nibble;
+
+	random_bytes(group, sizeof(group));
+
+	start = clock();
+	for (n = 0; n < BENCH_ROUNDS; n++) {
+		group[0] = n;
+		sink ^= pec15_bitwise(group, sizeof(group));
+	}
+	bitwise = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	start = clock();
+	for (n = 0; n < BENCH_ROUNDS; n++) {
+		group[0] = n;
+		sink ^= PEC15_CalculateByte(group, sizeof(group));
+	}
+	byte = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	start = clock();
+	for (n = 0; n < BENCH_ROUNDS; n++) {
+		group[0] = n;
+		sink ^= PEC15_CalculateNibble(group, sizeof(group));
+	}
+	nibble = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	printf("\nPEC15 over %d 6-byte groups: bitwise %.3fs, byte table %.3fs, nibble table %.3fs\n",
+		BENCH_ROUNDS, bitwise, byte, nibble);
+	(void)sink;
+}
+
+TEST_GROUP_RUNNER(PEC15_Test) {
+	RUN_TEST_CASE(PEC15_Test, test_known_commands);
+	RUN_TEST_CASE(PEC15_Test, test_random_regression);
+	RUN_TEST_CASE(PEC15_Test, test_check_group);
+	RUN_TEST_CASE(PEC15_Test, test_benchmark);
+}
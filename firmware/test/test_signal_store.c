@@ -0,0 +1,177 @@
+#include "signal_store.h"
+#include "unity.h"
+#include "unity_fixture.h"
+
+TEST_GROUP(SignalStore_Test);
+
+TEST_SETUP(SignalStore_Test) {
+	SignalStore_Init();
+}
+
+TEST_TEAR_DOWN(SignalStore_Test) {
+
+}
+
+/**
+ * @return index of sig in CANMsgs_Signals
+ */
+static uint8_t index_of(uint16_t sig) {
+	uint8_t i;
+	for (i = 0; i < CAN_SIGNALS_COUNT; i++) {
+		if (CANMsgs_Signals[i].sig == sig) return i;
+	}
+	TEST_FAIL_MESSAGE("signal not in CANMsgs_Signals");
+	return 0;
+}
+
+TEST(SignalStore_Test, test_motor_status) {
+	CAN_MOTOR_STATUS_T msg;
+	uint8_t data[8];
+
+	msg.shutdown_ok = true;
+	msg.current_dA = -1234;
+	msg.speed_rpm = 4500;
+	msg.voltage_dV = 3105;
+	CANMsgs_EncodeMotorStatus(&msg, data);
+
+	TEST_ASSERT_TRUE(SignalStore_Receive(CAN_MOTOR_STATUS, data, CAN_MOTOR_STATUS_DLC, 0));
+	TEST_ASSERT_EQUAL_UINT32(1, SignalStore_Get(CAN_SIG_MOTOR_STATUS_SHUTDOWN_OK));
+	TEST_ASSERT_EQUAL_UINT32((uint16_t)-1234, SignalStore_Get(CAN_SIG_MOTOR_STATUS_CURRENT_DA));
+	TEST_ASSERT_EQUAL_UINT32(4500, SignalStore_Get(CAN_SIG_MOTOR_STATUS_SPEED_RPM));
+	TEST_ASSERT_EQUAL_UINT32(3105, SignalStore_Get(CAN_SIG_MOTOR_STATUS_VOLTAGE_DV));
+
+	// Telemetry sees signed signals sign extended
+	TEST_ASSERT_EQUAL_INT32(-1234, SignalStore_GetIndex(index_of(CAN_SIG_MOTOR_STATUS_CURRENT_DA)));
+	TEST_ASSERT_EQUAL_INT32(3105, SignalStore_GetIndex(index_of(CAN_SIG_MOTOR_STATUS_VOLTAGE_DV)));
+	TEST_ASSERT_EQUAL_UINT32(1, SignalStore_GetStats()->stored);
+}
+
+/**
+ * Neighbouring flags share store bytes, each frame may only touch its own
+ */
+TEST(SignalStore_Test, test_bits_independent) {
+	uint8_t power = 0x15, contactors[2] = {0x00, 0x00};
+
+	TEST_ASSERT_TRUE(SignalStore_Receive(CAN_POWER_STATUS, &power, CAN_POWER_STATUS_DLC, 0));
+	TEST_ASSERT_TRUE(SignalStore_Receive(CAN_CONTACTORS, contactors, CAN_CONTACTORS_DLC, 0));
+	TEST_ASSERT_EQUAL_UINT32(1, SignalStore_Get(CAN_SIG_POWER_STATUS_LV_BATTERY_FLAG));
+	TEST_ASSERT_EQUAL_UINT32(0, SignalStore_Get(CAN_SIG_POWER_STATUS_LV_DCDC_STATUS));
+	TEST_ASSERT_EQUAL_UINT32(1, SignalStore_Get(CAN_SIG_POWER_STATUS_CRITICAL_BATTERY_FLAG));
+	TEST_ASSERT_EQUAL_UINT32(1, SignalStore_Get(CAN_SIG_POWER_STATUS_PDM_STATUS));
+
+	contactors[0] = 0xFF;
+	contactors[1] = 0x03;
+	power = 0;
+	TEST_ASSERT_TRUE(SignalStore_Receive(CAN_CONTACTORS, contactors, CAN_CONTACTORS_DLC, 0));
+	TEST_ASSERT_TRUE(SignalStore_Receive(CAN_POWER_STATUS, &power, CAN_POWER_STATUS_DLC, 0));
+	TEST_ASSERT_EQUAL_UINT32(0, SignalStore_Get(CAN_SIG_POWER_STATUS_PDM_STATUS));
+	TEST_ASSERT_EQUAL_UINT32(1, SignalStore_Get(CAN_SIG_CONTACTORS_CONTACTOR_1_ERROR));
+	TEST_ASSERT_EQUAL_UINT32(1, SignalStore_Get(CAN_SIG_CONTACTORS_CONTACTOR_3_STATUS));
+	TEST_ASSERT_EQUAL_UINT32(7, SignalStore_Get(CAN_SIG_CONTACTORS_PRECHARGE_STATE));
+}
+
+TEST(SignalStore_Test, test_rejects) {
+	uint8_t data[8] = {0};
+
+	TEST_ASSERT_FALSE(SignalStore_Receive(CAN_BATTERY, data, CAN_BATTERY_DLC - 1, 0));
+	TEST_ASSERT_FALSE(SignalStore_Receive(0x7FF, data, 8, 0));
+	TEST_ASSERT_EQUAL_UINT32(0, SignalStore_GetStats()->stored);
+	TEST_ASSERT_EQUAL_UINT32(1, SignalStore_GetStats()->bad_dlc);
+	TEST_ASSERT_EQUAL_UINT32(1, SignalStore_GetStats()->unknown);
+}
+
+static uint8_t msg_index(uint16_t id) {
+	return CANMsgs_Find(id) - CANMsgs_Messages;
+}
+
+TEST(SignalStore_Test, test_fresh) {
+	uint8_t data[8] = {0};
+	uint8_t motor = msg_index(CAN_MOTOR_STATUS);
+	uint8_t temps = msg_index(CAN_CELL_TEMPS);
+	uint32_t motor_timeout = CANMsgs_Messages[motor].period_ms * SIGNAL_STORE_TIMEOUT_PERIODS;
+
+	// Nothing counts as fresh before its first frame
+	SignalStore_Update(0);
+	TEST_ASSERT_FALSE(SignalStore_IsFresh(motor));
+	TEST_ASSERT_FALSE(SignalStore_IsFresh(temps));
+
+	TEST_ASSERT_TRUE(SignalStore_Receive(CAN_MOTOR_STATUS, data, CAN_MOTOR_STATUS_DLC, 1000));
+	TEST_ASSERT_TRUE(SignalStore_Receive(CAN_CELL_TEMPS, data, CAN_CELL_TEMPS_DLC, 1000));
+	SignalStore_Update(1000 + motor_timeout - 1);
+	TEST_ASSERT_TRUE(SignalStore_IsFresh(motor));
+
+	// The slow message outlives the fast one
+	SignalStore_Update(1000 + motor_timeout);
+	TEST_ASSERT_FALSE(SignalStore_IsFresh(motor));
+	TEST_ASSERT_TRUE(SignalStore_IsFresh(temps));
+	TEST_ASSERT_EQUAL_UINT32(1, SignalStore_GetStats()->expired);
+
+	// A new frame revives a stale message
+	TEST_ASSERT_TRUE(SignalStore_Receive(CAN_MOTOR_STATUS, data, CAN_MOTOR_STATUS_DLC, 3900));
+	TEST_ASSERT_TRUE(SignalStore_IsFresh(motor));
+	SignalStore_Update(1000 + CANMsgs_Messages[temps].period_ms * SIGNAL_STORE_TIMEOUT_PERIODS);
+	TEST_ASSERT_FALSE(SignalStore_IsFresh(temps));
+	TEST_ASSERT_TRUE(SignalStore_IsFresh(motor));
+}
+
+/**
+ * A frame moves its message behind the others sharing its timeout, expiry
+ * from the head must still see the messages that arrived before it
+ */
+TEST(SignalStore_Test, test_fresh_order) {
+	uint8_t data[8] = {0};
+	uint8_t v1 = msg_index(CAN_VELOCITY1);
+	uint8_t v2 = msg_index(CAN_VELOCITY2);
+	uint8_t motor = msg_index(CAN_MOTOR_STATUS);
+	uint32_t timeout = CANMsgs_Messages[v1].period_ms * SIGNAL_STORE_TIMEOUT_PERIODS;
+
+	TEST_ASSERT_EQUAL_UINT16(CANMsgs_Messages[v1].period_ms, CANMsgs_Messages[v2].period_ms);
+	TEST_ASSERT_EQUAL_UINT16(CANMsgs_Messages[v1].period_ms, CANMsgs_Messages[motor].period_ms);
+
+	SignalStore_Receive(CAN_VELOCITY1, data, CAN_VELOCITY1_DLC, 0);
+	SignalStore_Receive(CAN_VELOCITY2, data, CAN_VELOCITY2_DLC, 10);
+	SignalStore_Receive(CAN_MOTOR_STATUS, data, CAN_MOTOR_STATUS_DLC, 20);
+	SignalStore_Receive(CAN_VELOCITY1, data, CAN_VELOCITY1_DLC, 30);
+	SignalStore_Receive(CAN_VELOCITY2, data, CAN_VELOCITY2_DLC, 40);
+
+	SignalStore_Update(20 + timeout);
+	TEST_ASSERT_FALSE(SignalStore_IsFresh(motor));
+	TEST_ASSERT_TRUE(SignalStore_IsFresh(v1));
+	TEST_ASSERT_TRUE(SignalStore_IsFresh(v2));
+
+	SignalStore_Update(30 + timeout);
+	TEST_ASSERT_FALSE(SignalStore_IsFresh(v1));
+	TEST_ASSERT_TRUE(SignalStore_IsFresh(v2));
+
+	SignalStore_Update(40 + timeout);
+	TEST_ASSERT_FALSE(SignalStore_IsFresh(v2));
+	TEST_ASSERT_EQUAL_UINT32(3, SignalStore_GetStats()->expired);
+}
+
+/**
+ * Every signal has its own slot and the meta table agrees with the descriptors
+ */
+TEST(SignalStore_Test, test_layout) {
+	uint8_t i, j;
+
+	for (i = 0; i < CAN_SIGNALS_COUNT; i++) {
+		const CAN_SIGNAL_META_T *meta = &CANMsgs_Signals[i];
+		const CAN_MSG_DESC_T *msg = &CANMsgs_Messages[meta->msg];
+		TEST_ASSERT_TRUE(meta->signal < msg->num_signals);
+		TEST_ASSERT_EQUAL_UINT8(msg->signals[meta->signal].length == 1, CAN_SIG_STORE(meta->sig) == CAN_STORE_BIT);
+		for (j = 0; j < i; j++) {
+			TEST_ASSERT_TRUE(CANMsgs_Signals[j].sig != meta->sig);
+		}
+	}
+	// Raw values only: at most 4 bytes per signal, against 12 for an {id, index, value} triplet
+	TEST_ASSERT_TRUE(sizeof(CAN_STORE_T) <= CAN_SIGNALS_COUNT * 2);
+}
+
+TEST_GROUP_RUNNER(SignalStore_Test) {
+	RUN_TEST_CASE(SignalStore_Test, test_motor_status);
+	RUN_TEST_CASE(SignalStore_Test, test_bits_independent);
+	RUN_TEST_CASE(SignalStore_Test, test_rejects);
+	RUN_TEST_CASE(SignalStore_Test, test_fresh);
+	RUN_TEST_CASE(SignalStore_Test, test_fresh_order);
+	RUN_TEST_CASE(SignalStore_Test, test_layout);
+}
@@ -0,0 +1,63 @@
+#include "telemetry.h"
+#include <string.h>
+#include "unity.h"
+#include "unity_fixture.h"
+
+TEST_GROUP(Telemetry_Test);
+
+static char output[4096];
+
+static void print(const char *str) {
+	strcat(output, str);
+}
+
+TEST_SETUP(Telemetry_Test) {
+	output[0] = '\0';
+	SignalStore_Init();
+	Fault_Init();
+	Warning_Init();
+	Telemetry_Init(print);
+}
+
+TEST_TEAR_DOWN(Telemetry_Test) {
+
+}
+
+TEST(Telemetry_Test, test_signals) {
+	CAN_MOTOR_STATUS_T msg = {0};
+	uint8_t data[8];
+	uint8_t lines = 0;
+	char *c;
+
+	msg.current_dA = -25;
+	CANMsgs_EncodeMotorStatus(&msg, data);
+	SignalStore_Receive(CAN_MOTOR_STATUS, data, CAN_MOTOR_STATUS_DLC, 900);
+	Telemetry_Signals(1000);
+
+	// One line per signal, stale unless its message arrived in time
+	for (c = output; *c; c++) {
+		if (*c == '\n') lines++;
+	}
+	TEST_ASSERT_EQUAL_UINT8(CAN_SIGNALS_COUNT, lines);
+	TEST_ASSERT_EQUAL_PTR(output, strstr(output, "301,0,0,1000,0\r\n"));
+	TEST_ASSERT_NOT_NULL(strstr(output, "\n705,1,-25,1000,1\r\n"));
+}
+
+TEST(Telemetry_Test, test_changes) {
+	uint8_t contactors[CAN_CONTACTORS_DLC] = {0x02, 0};
+
+	Fault_Receive(CAN_CONTACTORS, contactors, CAN_CONTACTORS_DLC);
+	Telemetry_Faults(Fault_Receive(CAN_CONTACTORS, contactors, CAN_CONTACTORS_DLC), 42);
+	TEST_ASSERT_EQUAL_STRING("F,contactor_2,1,crit,42\r\n", output);
+
+	output[0] = '\0';
+	contactors[0] = 0x80;
+	SignalStore_Receive(CAN_CONTACTORS, contactors, CAN_CONTACTORS_DLC, 0);
+	Telemetry_Warnings(Warning_Receive(CAN_CONTACTORS), 7);
+	TEST_ASSERT_EQUAL_STRING("W,precharge,1,1,7\r\n", output);
+}
+
+TEST_GROUP_RUNNER(Telemetry_Test) {
+	RUN_TEST_CASE(Telemetry_Test, test_signals);
+	RUN_TEST_CASE(Telemetry_Test, test_changes);
+}
@@ -0,0 +1,108 @@
+#include "warning.h"
+#include "unity.h"
+#include "unity_fixture.h"
+
+TEST_GROUP(Warning_Test);
+
+TEST_SETUP(Warning_Test) {
+	SignalStore_Init();
+	Warning_Init();
+}
+
+TEST_TEAR_DOWN(Warning_Test) {
+
+}
+
+static WARNING_SET_T temps(int16_t max_temp_dC) {
+	CAN_CELL_TEMPS_T msg = {0};
+	uint8_t data[8];
+
+	msg.max_temp_dC = max_temp_dC;
+	CANMsgs_EncodeCellTemps(&msg, data);
+	SignalStore_Receive(CAN_CELL_TEMPS, data, CAN_CELL_TEMPS_DLC, 0);
+	return Warning_Receive(CAN_CELL_TEMPS);
+}
+
+static WARNING_SET_T cells(uint16_t min_cell_mV) {
+	CAN_CELL_VOLTAGES_T msg = {0};
+	uint8_t data[8];
+
+	msg.min_cell_mV = min_cell_mV;
+	msg.max_cell_mV = 3300;
+	CANMsgs_EncodeCellVoltages(&msg, data);
+	SignalStore_Receive(CAN_CELL_VOLTAGES, data, CAN_CELL_VOLTAGES_DLC, 0);
+	return Warning_Receive(CAN_CELL_VOLTAGES);
+}
+
+TEST(Warning_Test, test_high_limit) {
+	const WARNING_RULE_T *rule = &Warning_Rules[WARNING_CELL_HOT];
+
+	TEST_ASSERT_EQUAL_UINT8(0, temps(rule->set - 1));
+	TEST_ASSERT_EQUAL_UINT8(WARNING_BIT(WARNING_CELL_HOT), temps(rule->set));
+	TEST_ASSERT_EQUAL_INT32(rule->set, Warning_GetValue(WARNING_CELL_HOT));
+
+	// Inside the hysteresis band the warning holds
+	TEST_ASSERT_EQUAL_UINT8(0, temps(rule->clear + 1));
+	TEST_ASSERT_EQUAL_UINT8(WARNING_BIT(WARNING_CELL_HOT), Warning_GetActive());
+	TEST_ASSERT_EQUAL_UINT8(WARNING_BIT(WARNING_CELL_HOT), temps(rule->clear));
+	TEST_ASSERT_EQUAL_UINT8(0, Warning_GetActive());
+}
+
+TEST(Warning_Test, test_low_limit) {
+	const WARNING_RULE_T *rule = &Warning_Rules[WARNING_CELL_LOW];
+
+	TEST_ASSERT_EQUAL_UINT8(0, cells(rule->clear));
+	TEST_ASSERT_EQUAL_UINT8(WARNING_BIT(WARNING_CELL_LOW), cells(rule->set));
+	TEST_ASSERT_EQUAL_UINT8(0, cells(rule->clear - 1));
+	TEST_ASSERT_EQUAL_UINT8(WARNING_BIT(WARNING_CELL_LOW), cells(rule->clear));
+}
+
+/**
+ * Signed signals compare sign extended, a freezing pack is not a hot one
+ */
+TEST(Warning_Test, test_signed) {
+	TEST_ASSERT_EQUAL_UINT8(0, temps(-200));
+	TEST_ASSERT_EQUAL_INT32(-200, Warning_GetValue(WARNING_CELL_HOT));
+}
+
+/**
+ * A frame only evaluates the rules on its own signals
+ */
+TEST(Warning_Test, test_indexed) {
+	uint8_t contactors[CAN_CONTACTORS_DLC] = {0x80, 0};
+
+	cells(Warning_Rules[WARNING_CELL_LOW].set);
+	TEST_ASSERT_EQUAL_UINT8(0, Warning_Receive(CAN_CELL_TEMPS));
+	TEST_ASSERT_EQUAL_INT32(0, Warning_GetValue(WARNING_CELL_HOT));
+
+	SignalStore_Receive(CAN_CONTACTORS, contactors, CAN_CONTACTORS_DLC, 0);
+	TEST_ASSERT_EQUAL_UINT8(WARNING_BIT(WARNING_PRECHARGE), Warning_Receive(CAN_CONTACTORS));
+	TEST_ASSERT_EQUAL_UINT8(WARNING_LED0 | WARNING_LED1, Warning_GetLeds());
+	// lv_battery is a fault source, not a warning
+	TEST_ASSERT_EQUAL_UINT8(0, Warning_Receive(CAN_POWER_STATUS));
+	TEST_ASSERT_EQUAL_UINT8(0, Warning_Receive(CAN_BATTERY));
+	TEST_ASSERT_EQUAL_UINT8(0, Warning_Receive(0x7FF));
+}
+
+/**
+ * Every rule names a signal in the store
+ */
+TEST(Warning_Test, test_rules) {
+	uint8_t i, j;
+
+	for (i = 0; i < WARNING_COUNT; i++) {
+		for (j = 0; j < CAN_SIGNALS_COUNT; j++) {
+			if (CANMsgs_Signals[j].sig == Warning_Rules[i].sig) break;
+		}
+		TEST_ASSERT_TRUE(j < CAN_SIGNALS_COUNT);
+		TEST_ASSERT_TRUE(Warning_Rules[i].set != Warning_Rules[i].clear);
+	}
+}
+
+TEST_GROUP_RUNNER(Warning_Test) {
+	RUN_TEST_CASE(Warning_Test, test_high_limit);
+	RUN_TEST_CASE(Warning_Test, test_low_limit);
+	RUN_TEST_CASE(Warning_Test, test_signed);
+	RUN_TEST_CASE(Warning_Test, test_indexed);
+	RUN_TEST_CASE(Warning_Test, test_rules);
+}
@@ -0,0 +1,555 @@
+#!/usr/bin/env python3
+"""Generate CAN message decoders and encoders from a DBC file.
+
+Usage: dbcgen.py <file.dbc> <header> <source> <test>
+
+Every message becomes a struct of raw signal values and a pair of straight
+line functions built from constant shifts and masks, so the firmware never
+walks a layout table at run time. Const descriptor tables carry names, units
+and scaling for telemetry. The test file gets one Unity test per message that
+checks the generated bit positions against the ones computed here.
+
+Every signal also gets a slot in a store packed by width: one bit, u8, u16
+or u32. Its CAN_SIG_ constant encodes the width and slot, so reads with a
+constant signal fold to a single load.
+
+Only the subset of DBC the BCM needs is accepted: standard IDs, unsigned or
+signed signals up to 32 bits in either byte order, no multiplexing, and
+factors and offsets that are exact fractions with integral offsets.
+"""
+
+import os
+import re
+import sys
+from fractions import Fraction
+
+MODULE = 'CANMsgs'
+PREFIX = 'CAN'
+
+BO_RE = re.compile(r'^BO_\s+(\d+)\s+(\w+)\s*:\s*(\d+)\s+(\w+)')
+CYCLE_RE = re.compile(r'^BA_\s+"GenMsgCycleTime"\s+BO_\s+(\d+)\s+(\d+)\s*;')
+SG_RE = re.compile(r'^SG_\s+(\w+)\s*(\S+)?\s*:\s*(\d+)\|(\d+)@([01])([+-])\s*'
+	r'\(([^,]+),([^)]+)\)\s*\[([^|]*)\|([^\]]*)\]\s*"([^"]*)"')
+
+
+class Signal(object):
+	def __init__(self, name, start, length, motorola, signed, factor, offset, unit):
+		self.name = name
+		self.start = start
+		self.length = length
+		self.motorola = motorola
+		self.signed = signed
+		self.factor = factor
+		self.offset = offset
+		self.unit = unit
+
+	def bits(self):
+		"""(byte, bit in byte) of each signal bit, LSB first"""
+		if not self.motorola:
+			return [((self.start + i) // 8, (self.start + i) % 8) for i in range(self.length)]
+		# Motorola start bit is the MSB, counting down a byte then on to the next
+		pos = self.start
+		msb_first = []
+		for i in range(self.length):
+			msb_first.append((pos // 8, pos % 8))
+			pos = pos + 15 if pos % 8 == 0 else pos - 1
+		return list(reversed(msb_first))
+
+	def pieces(self):
+		"""Runs of consecutive bits sharing a byte: (byte, byte_bit, signal_bit, count)"""
+		runs = []
+		for i, (byte, bit) in enumerate(self.bits()):
+			if runs and runs[-1][0] == byte and runs[-1][1] + runs[-1][3] == bit:
+				runs[-1][3] += 1
+			else:
+				runs.append([byte, bit, i, 1])
+		return [tuple(r) for r in runs]
+
+	def ctype(self):
+		if self.length == 1 and not self.signed:
+			return 'bool'
+		for width in (8, 16, 32):
+			if self.length <= width:
+				return ('int%d_t' if self.signed else 'uint%d_t') % width
+		raise ValueError('%s: signals are limited to 32 bits' % self.name)
+
+	def utype(self):
+		return 'uint%d_t' % (8 if self.length <= 8 else 16 if self.length <= 16 else 32)
+
+	def store(self):
+		return 0 if self.length == 1 else 1 if self.length <= 8 else 2 if self.length <= 16 else 3
+
+
+class Message(object):
+	def __init__(self, can_id, name, dlc, sender):
+		self.id = can_id
+		self.name = name
+		self.dlc = dlc
+		self.sender = sender
+		self.period_ms = 0
+		self.signals = []
+
+	def macro(self):
+		return PREFIX + '_' + self.snake().upper()
+
+	def snake(self):
+		return re.sub(r'(?<=[a-z0-9])(?=[A-Z])', '_', self.name).lower()
+
+
+def parse(path):
+	with open(path) as f:
+		text = f.read()
+	text = re.sub(r'CM_\s+(?:\w+\s+)*"(?:[^"\\]|\\.)*"\s*;', '', text, flags=re.S)
+
+	messages = []
+	for number, line in enumerate(text.splitlines(), 1):
+		line = line.strip()
+		where = '%s:%d' % (path, number)
+		if line.startswith('BO_ '):
+			m = BO_RE.match(line)
+			if not m:
+				sys.exit('%s: bad message' % where)
+			can_id, dlc = int(m.group(1)), int(m.group(3))
+			if can_id > 0x7FF or dlc > 8:
+				sys.exit('%s: only standard IDs and classic frames' % where)
+			messages.append(Message(can_id, m.group(2), dlc, m.group(4)))
+		elif line.startswith('SG_ '):
+			m = SG_RE.match(line)
+			if not m or not messages:
+				sys.exit('%s: bad signal' % where)
+			if m.group(2):
+				sys.exit('%s: multiplexed signals are not supported' % where)
+			factor = Fraction(m.group(7).strip()).limit_denominator(1000000)
+			offset = Fraction(m.group(8).strip())
+			if offset.denominator != 1 or float(factor) != float(m.group(7)):
+				sys.exit('%s: factor must be an exact fraction and offset an integer' % where)
+			sig = Signal(m.group(1), int(m.group(3)), int(m.group(4)), m.group(5) == '0',
+				m.group(6) == '-', factor, int(offset), m.group(11))
+			msg = messages[-1]
+			for byte, bit in sig.bits():
+				if byte >= msg.dlc:
+					sys.exit('%s: %s runs past the DLC' % (where, sig.name))
+			sig.ctype()
+			msg.signals.append(sig)
+		elif line.startswith('BA_ '):
+			m = CYCLE_RE.match(line)
+			if not m:
+				continue
+			period = [msg for msg in messages if msg.id == int(m.group(1))]
+			if not period or int(m.group(2)) > 0xFFFF:
+				sys.exit('%s: cycle time for an unknown message' % where)
+			period[0].period_ms = int(m.group(2))
+
+	ids = set()
+	for msg in messages:
+		if msg.id in ids:
+			sys.exit('%s: duplicate ID 0x%X' % (path, msg.id))
+		ids.add(msg.id)
+		used = set()
+		for sig in msg.signals:
+			bits = set(sig.bits())
+			if bits & used:
+				sys.exit('%s: %s overlaps another signal in %s' % (path, sig.name, msg.name))
+			used |= bits
+	return messages
+
+
+STORES = ('BIT', 'U8', 'U16', 'U32')
+
+
+def assign_slots(messages):
+	"""Slots in description file order within each width, returns the counts"""
+	counts = [0] * len(STORES)
+	for msg in messages:
+		for sig in msg.signals:
+			sig.slot = counts[sig.store()]
+			counts[sig.store()] += 1
+	if max(counts) > 256:
+		sys.exit('more than 256 signals of one width')
+	return counts
+
+
+def sig_macro(msg, sig):
+	return '%s_SIG_%s_%s' % (PREFIX, msg.snake().upper(), sig.name.upper())
+
+
+def hexmask(n):
+	return '0x%X' % ((1 << n) - 1)
+
+
+def decode_expr(sig, raw=False):
+	"""Right hand side assembling the value from the data bytes, unsigned if raw"""
+	ut = sig.utype()
+	terms = []
+	for byte, bit, sbit, count in sig.pieces():
+		term = 'data[%d]' % byte
+		if bit:
+			term = '(%s >> %d)' % (term, bit)
+		if bit + count < 8:
+			term = '(%s & %s)' % (term, hexmask(count))
+		if sbit:
+			term = '((%s)%s << %d)' % (ut, term, sbit)
+		terms.append(term)
+	expr = ' | '.join(terms)
+	if len(terms) > 1 or sig.pieces()[0][2]:
+		expr = '(%s)(%s)' % (ut, expr)
+	if raw:
+		return expr
+	if not sig.signed:
+		return '%s != 0' % expr if sig.ctype() == 'bool' else expr
+	if sig.length in (8, 16, 32):
+		return '(%s)%s' % (sig.ctype(), expr)
+	# Sign extend by flipping and subtracting the sign bit
+	return '(%s)((int32_t)(%s ^ 0x%X) - 0x%X)' % (sig.ctype(), expr, 1 << (sig.length - 1), 1 << (sig.length - 1))
+
+
+def encode_lines(sig, field):
+	"""Statements or'ing the value into the data bytes"""
+	raw = '(%s)%s' % (sig.utype(), field)
+	lines = []
+	for byte, bit, sbit, count in sig.pieces():
+		term = raw
+		if sbit:
+			term = '(%s >> %d)' % (term, sbit)
+		# The cast to uint8_t drops anything above the byte, only fields
+		# ending below bit 7 need masking to keep out of their neighbours
+		if bit + count < 8 and sig.ctype() != 'bool':
+			term = '(%s & %s)' % (term, hexmask(count))
+		if bit:
+			term = '(%s << %d)' % (term, bit)
+		term = '(uint8_t)' + (field if term == raw else term)
+		lines.append('data[%d] |= %s;' % (byte, term))
+	return lines
+
+
+def c_string(s):
+	return '"%s"' % s.replace('\\', '\\\\').replace('"', '\\"')
+
+
+def banner(dbc):
+	return ('// Generated by tools/dbcgen.py from %s, do not edit.\n'
+		'// Run make codegen after changing the description.\n' % dbc)
+
+
+def header(messages, dbc, guard):
+	out = [banner(dbc)]
+	out.append('#ifndef %s\n#define %s\n\n#include <stdint.h>\n#include <stdbool.h>\n' % (guard, guard))
+	out.append('''//--------------------------------------------
+// Decoders and encoders for the messages in %s. Structs hold raw signal
+// values; the descriptor tables give names, units and the factor and offset
+// to scale them for telemetry.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Message IDs and lengths
+''' % os.path.basename(dbc))
+	for msg in messages:
+		out.append('#define %s 0x%03X' % (msg.macro(), msg.id))
+		out.append('#define %s_DLC %d' % (msg.macro(), msg.dlc))
+	out.append('\n#define %s_MSGS_COUNT %d\n' % (PREFIX, len(messages)))
+
+	out.append('''// Signal descriptor flags
+#define %s_SIGNAL_SIGNED 0x01
+#define %s_SIGNAL_MOTOROLA 0x02 					// Big endian, start is the MSB
+
+// -------------------------------------------------------------
+// Types
+
+typedef struct _%s_SIGNAL_DESC_T_ {
+	const char *name;
+	const char *unit;
+	uint8_t start; 								// DBC start bit
+	uint8_t length;
+	uint8_t flags;
+	int32_t factor_num; 						// physical = raw * factor_num / factor_den + offset
+	uint32_t factor_den;
+	int32_t offset;
+} %s_SIGNAL_DESC_T;
+
+typedef struct _%s_MSG_DESC_T_ {
+	const char *name;
+	uint16_t id;
+	uint8_t dlc;
+	uint8_t num_signals;
+	uint16_t period_ms; 						// GenMsgCycleTime, 0 if sent on events
+	const %s_SIGNAL_DESC_T *signals;
+} %s_MSG_DESC_T;
+''' % ((PREFIX,) * 7))
+
+	for msg in messages:
+		out.append('typedef struct _%s_T_ {' % msg.macro())
+		for sig in msg.signals:
+			out.append('\t%s %s;' % (sig.ctype(), sig.name))
+		out.append('} %s_T;\n' % msg.macro())
+
+	out.append('''// -------------------------------------------------------------
+// Public Functions
+
+/**
+ * Message descriptors in description file order
+ */
+extern const %s_MSG_DESC_T %s_Messages[%s_MSGS_COUNT];
+
+/**
+ * @param id standard CAN ID
+ * @return the message's descriptor, NULL if it is not described
+ */
+const %s_MSG_DESC_T *%s_Find(uint16_t id);
+''' % (PREFIX, MODULE, PREFIX, PREFIX, MODULE))
+
+	for msg in messages:
+		out.append('''/**
+ * @return 0 on success, -1 if dlc is not %s_DLC
+ */
+int8_t %s_Decode%s(%s_T *msg, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @return %s_DLC, the bytes written to data
+ */
+uint8_t %s_Encode%s(const %s_T *msg, uint8_t *data);
+''' % (msg.macro(), MODULE, msg.name, msg.macro(), msg.macro(), MODULE, msg.name, msg.macro()))
+
+	out.append(store_header(messages))
+	out.append('#endif')
+	return '\n'.join(out) + '\n'
+
+
+def source(messages, dbc, header_name):
+	out = [banner(dbc)]
+	out.append('#include "%s"\n#include <stddef.h>\n' % header_name)
+
+	for msg in messages:
+		out.append('static const %s_SIGNAL_DESC_T %s_signals[] = {' % (PREFIX, msg.snake()))
+		for sig in msg.signals:
+			flags = []
+			if sig.signed:
+				flags.append('%s_SIGNAL_SIGNED' % PREFIX)
+			if sig.motorola:
+				flags.append('%s_SIGNAL_MOTOROLA' % PREFIX)
+			out.append('\t{%s, %s, %d, %d, %s, %d, %d, %d},' % (c_string(sig.name), c_string(sig.unit),
+				sig.start, sig.length, ' | '.join(flags) or '0', sig.factor.numerator,
+				sig.factor.denominator, sig.offset))
+		out.append('};\n')
+
+	out.append('const %s_MSG_DESC_T %s_Messages[%s_MSGS_COUNT] = {' % (PREFIX, MODULE, PREFIX))
+	for msg in messages:
+		out.append('\t{%s, %s, %s_DLC, %d, %d, %s_signals},' % (c_string(msg.name), msg.macro(), msg.macro(),
+			len(msg.signals), msg.period_ms, msg.snake()))
+	out.append('};\n')
+
+	out.append('const %s_MSG_DESC_T *%s_Find(uint16_t id) {\n\tswitch (id) {' % (PREFIX, MODULE))
+	for i, msg in enumerate(messages):
+		out.append('\t\tcase %s: return &%s_Messages[%d];' % (msg.macro(), MODULE, i))
+	out.append('\t\tdefault: return NULL;\n\t}\n}\n')
+
+	for msg in messages:
+		out.append('int8_t %s_Decode%s(%s_T *msg, const uint8_t *data, uint8_t dlc) {' % (MODULE, msg.name,
+			msg.macro()))
+		out.append('\tif (dlc != %s_DLC) return -1;\n' % msg.macro())
+		for sig in msg.signals:
+			out.append('\tmsg->%s = %s;' % (sig.name, decode_expr(sig)))
+		out.append('\treturn 0;\n}\n')
+
+		out.append('uint8_t %s_Encode%s(const %s_T *msg, uint8_t *data) {' % (MODULE, msg.name, msg.macro()))
+		for i in range(msg.dlc):
+			out.append('\tdata[%d] = 0;' % i)
+		out.append('')
+		for sig in msg.signals:
+			for line in encode_lines(sig, 'msg->' + sig.name):
+				out.append('\t' + line)
+		out.append('\treturn %s_DLC;\n}\n' % msg.macro())
+
+	out.append(store_source(messages))
+	return '\n'.join(out)
+
+
+STORE_HEADER = '''// -------------------------------------------------------------
+// Signal store
+
+// Store widths, the top byte of a P_SIG_ constant
+#define P_STORE_BIT 0
+#define P_STORE_U8 1
+#define P_STORE_U16 2
+#define P_STORE_U32 3
+
+#define P_SIG(store, slot) (((store) << 8) | (slot))
+#define P_SIG_STORE(sig) ((sig) >> 8)
+#define P_SIG_SLOT(sig) ((sig) & 0xFF)
+
+%(counts)s
+
+// Message indices into M_Messages
+%(msgs)s
+
+%(signals)s
+
+/**
+ * Where a signal lives: its message and signal descriptors and its slot
+ */
+typedef struct _P_SIGNAL_META_T_ {
+	uint8_t msg; 								// Index into M_Messages
+	uint8_t signal; 							// Index into the message's signals
+	uint16_t sig; 								// P_SIG_ constant
+} P_SIGNAL_META_T;
+
+// Widths without signals keep one unused slot, C has no empty arrays
+typedef struct _P_STORE_T_ {
+	uint32_t u32[%(u32)d];
+	uint16_t u16[%(u16)d];
+	uint8_t u8[%(u8)d];
+	uint8_t bits[%(bits)d];
+} P_STORE_T;
+
+/**
+ * Every signal in description file order
+ */
+extern const P_SIGNAL_META_T M_Signals[P_SIGNALS_COUNT];
+
+/**
+ * Write every signal of a described message into the store
+ *
+ * @return 0 on success, -1 on a wrong DLC, 1 if the ID is not described
+ */
+int8_t M_Store(P_STORE_T *store, uint16_t id, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @param sig P_SIG_ constant
+ * @return the signal's raw value, zero extended
+ */
+static inline uint32_t M_Get(const P_STORE_T *store, uint16_t sig) {
+	switch (P_SIG_STORE(sig)) {
+		case P_STORE_BIT: return (store->bits[P_SIG_SLOT(sig) >> 3] >> (P_SIG_SLOT(sig) & 7)) & 1;
+		case P_STORE_U8: return store->u8[P_SIG_SLOT(sig)];
+		case P_STORE_U16: return store->u16[P_SIG_SLOT(sig)];
+		default: return store->u32[P_SIG_SLOT(sig)];
+	}
+}
+'''
+
+
+def store_header(messages):
+	counts = assign_slots(messages)
+	count_lines = ['#define P_STORE_%sS %d' % (name, count) for name, count in zip(STORES, counts)]
+	count_lines.append('#define P_SIGNALS_COUNT %d' % sum(counts))
+	signal_lines = []
+	for msg in messages:
+		for sig in msg.signals:
+			signal_lines.append('#define %s P_SIG(P_STORE_%s, %d)' % (sig_macro(msg, sig), STORES[sig.store()],
+				sig.slot))
+	msg_lines = ['#define P_MSG_%s %d' % (msg.snake().upper(), m) for m, msg in enumerate(messages)]
+	text = STORE_HEADER % {'counts': '\n'.join(count_lines), 'msgs': '\n'.join(msg_lines),
+		'signals': '\n'.join(signal_lines),
+		'u32': max(counts[3], 1), 'u16': max(counts[2], 1), 'u8': max(counts[1], 1),
+		'bits': max((counts[0] + 7) // 8, 1)}
+	return re.sub(r'\bM_', MODULE + '_', re.sub(r'\bP_', PREFIX + '_', text))
+
+
+def store_source(messages):
+	assign_slots(messages)
+	out = ['const %s_SIGNAL_META_T %s_Signals[%s_SIGNALS_COUNT] = {' % (PREFIX, MODULE, PREFIX)]
+	for m, msg in enumerate(messages):
+		for i, sig in enumerate(msg.signals):
+			out.append('\t{%d, %d, %s},' % (m, i, sig_macro(msg, sig)))
+	out.append('};\n')
+
+	for msg in messages:
+		out.append('static void store_%s(%s_STORE_T *store, const uint8_t *data) {' % (msg.snake(), PREFIX))
+		for sig in msg.signals:
+			if sig.store() == 0:
+				byte, mask = sig.slot >> 3, 1 << (sig.slot & 7)
+				out.append('\tstore->bits[%d] = (store->bits[%d] & ~0x%02X) | (%s ? 0x%02X : 0);' % (byte, byte,
+					mask, decode_expr(sig, True), mask))
+			else:
+				out.append('\tstore->%s[%d] = %s;' % (STORES[sig.store()].lower(), sig.slot,
+					decode_expr(sig, True)))
+		out.append('}\n')
+
+	out.append('int8_t %s_Store(%s_STORE_T *store, uint16_t id, const uint8_t *data, uint8_t dlc) {' % (MODULE,
+		PREFIX))
+	out.append('\tswitch (id) {')
+	for msg in messages:
+		out.append('\t\tcase %s:' % msg.macro())
+		out.append('\t\t\tif (dlc != %s_DLC) return -1;' % msg.macro())
+		out.append('\t\t\tstore_%s(store, data);' % msg.snake())
+		out.append('\t\t\treturn 0;')
+	out.append('\t\tdefault:\n\t\t\treturn 1;\n\t}\n}\n')
+	return '\n'.join(out)
+
+
+def test_value(sig, salt):
+	"""A value exercising every byte of the field, and its raw bit pattern"""
+	raw = (0xA5C3E1B7 >> (salt % 7)) & ((1 << sig.length) - 1)
+	if sig.length == 1:
+		raw = 1
+	value = raw
+	if sig.signed and raw & (1 << (sig.length - 1)):
+		value = raw - (1 << sig.length)
+	return value, raw
+
+
+def test(messages, dbc, header_name):
+	group = MODULE + '_Test'
+	out = [banner(dbc)]
+	out.append('#include "%s"\n#include "unity.h"\n#include "unity_fixture.h"\n' % header_name)
+	out.append('TEST_GROUP(%s);\n\nTEST_SETUP(%s) {\n\n}\n\nTEST_TEAR_DOWN(%s) {\n\n}\n' % (group, group, group))
+
+	for msg in messages:
+		data = [0] * msg.dlc
+		values = []
+		for salt, sig in enumerate(msg.signals):
+			value, raw = test_value(sig, salt + msg.id)
+			values.append(value)
+			for i, (byte, bit) in enumerate(sig.bits()):
+				if raw >> i & 1:
+					data[byte] |= 1 << bit
+
+		out.append('/**\n * Bytes computed from the DBC bit positions, then a round trip\n */')
+		out.append('TEST(%s, test_%s) {' % (group, msg.snake()))
+		out.append('\tstatic const uint8_t expected[%s_DLC] = {%s};' % (msg.macro(),
+			', '.join('0x%02X' % b for b in data)))
+		out.append('\t%s_T msg, decoded;\n\tuint8_t data[8];\n' % msg.macro())
+		for sig, value in zip(msg.signals, values):
+			if sig.ctype() == 'bool':
+				out.append('\tmsg.%s = %s;' % (sig.name, 'true' if value else 'false'))
+			elif value < -0x7FFFFFFF:
+				out.append('\tmsg.%s = %d - 1;' % (sig.name, value + 1))
+			else:
+				out.append('\tmsg.%s = %d%s;' % (sig.name, value, 'u' if value > 0x7FFFFFFF else ''))
+		out.append('')
+		out.append('\tTEST_ASSERT_EQUAL_UINT8(%s_DLC, %s_Encode%s(&msg, data));' % (msg.macro(), MODULE, msg.name))
+		out.append('\tTEST_ASSERT_EQUAL_UINT8_ARRAY(expected, data, %s_DLC);' % msg.macro())
+		out.append('\tTEST_ASSERT_EQUAL_INT8(-1, %s_Decode%s(&decoded, data, %s_DLC - 1));' % (MODULE, msg.name,
+			msg.macro()))
+		out.append('\tTEST_ASSERT_EQUAL_INT8(0, %s_Decode%s(&decoded, data, %s_DLC));' % (MODULE, msg.name,
+			msg.macro()))
+		for sig in msg.signals:
+			out.append('\tTEST_ASSERT_TRUE(msg.%s == decoded.%s);' % (sig.name, sig.name))
+		out.append('\tTEST_ASSERT_EQUAL_UINT16(%s, %s_Find(%s)->id);' % (msg.macro(), MODULE, msg.macro()))
+		out.append('}\n')
+
+	out.append('TEST_GROUP_RUNNER(%s) {' % group)
+	for msg in messages:
+		out.append('\tRUN_TEST_CASE(%s, test_%s);' % (group, msg.snake()))
+	out.append('}')
+	return '\n'.join(out) + '\n'
+
+
+def write(path, text):
+	with open(path, 'w') as f:
+		f.write(text)
+
+
+def main(argv):
+	if len(argv) != 5:
+		sys.exit(__doc__.strip().splitlines()[2])
+	dbc, header_path, source_path, test_path = argv[1:]
+	messages = parse(dbc)
+	header_name = os.path.basename(header_path)
+	guard = '__%s_' % re.sub(r'\W', '_', header_name.rsplit('.', 1)[0]).upper() + 'H_'
+	write(header_path, header(messages, dbc, guard))
+	write(source_path, source(messages, dbc, header_name))
+	write(test_path, test(messages, dbc, header_name))
+
+
+if __name__ == '__main__':
+	main(sys.argv)
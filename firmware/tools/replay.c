@@ -0,0 +1,187 @@
+//--------------------------------------------
+// Replays a car bus recording through the host build of the signal store,
+// warnings, faults and telemetry, in the order main.c runs them, as fast as
+// the PC allows. A recording is the UART output captured while the 'w'
+// command is on: text lines, and frames each introduced by a zero byte and
+// encoded as a CANCapture_PackFrame() record. Text lines are skipped, apart
+// from the "Gap <frames>" lines main.c writes when its receive ring dropped
+// frames, which are reported on stderr since the telemetry after them may
+// not match the car's.
+//
+// Usage: replay <recording> [golden]
+//   Without a golden file the telemetry goes to stdout, which is how golden
+//   files are made. With one, the telemetry is compared line by line and the
+//   first difference reported. Throughput goes to stderr either way.
+//
+// Exit status: 0 match, 1 differences, 2 bad arguments or unreadable files
+//--------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "can_capture.h"
+#include "signal_store.h"
+#include "fault.h"
+#include "warning.h"
+#include "telemetry.h"
+
+#define TELEMETRY_PERIOD_MS 1000 				// main.c's signal telemetry period
+#define LINE_MAX 256
+#define GAP_PREFIX "Gap "
+
+static FILE *_golden;
+static char _line[LINE_MAX];
+static size_t _line_len;
+static unsigned long _line_no;
+static unsigned long _differences;
+
+static void compare_line(void) {
+	char expected[LINE_MAX];
+	bool read;
+
+	_line[_line_len] = '\0';
+	_line_len = 0;
+	_line_no++;
+	read = fgets(expected, sizeof(expected), _golden) != NULL;
+	if (read && strcmp(expected, _line) == 0) return;
+
+	if (!_differences) {
+		fprintf(stderr, "line %lu differs\n  golden: %s  replay: %s", _line_no,
+			read ? expected : "<end of file>\n", _line);
+	}
+	_differences++;
+}
+
+static void print(const char *str) {
+	if (!_golden) {
+		fputs(str, stdout);
+		return;
+	}
+	for (; *str; str++) {
+		if (_line_len < LINE_MAX - 1) _line[_line_len++] = *str;
+		if (*str == '\n') compare_line();
+	}
+}
+
+/**
+ * Skip a text line, whose first character has been read
+ *
+ * @return frames dropped if it is a gap line, otherwise 0
+ */
+static unsigned long read_text(FILE *in, int c) {
+	char text[sizeof(GAP_PREFIX) + 10];
+	size_t len = 0;
+
+	while (c != '\n' && c != EOF) {
+		if (len < sizeof(text) - 1) text[len++] = (char)c;
+		c = fgetc(in);
+	}
+	text[len] = '\0';
+	if (strncmp(text, GAP_PREFIX, sizeof(GAP_PREFIX) - 1) != 0) return 0;
+	return strtoul(text + sizeof(GAP_PREFIX) - 1, NULL, 10);
+}
+
+/**
+ * Read one frame record after its zero byte
+ *
+ * @return false at the end of the recording
+ */
+static bool read_frame(FILE *in, uint16_t *id, uint8_t *data, uint8_t *dlc, uint32_t *us) {
+	uint8_t rec[6];
+
+	if (fread(rec, 1, sizeof(rec), in) != sizeof(rec)) return false;
+	*us = rec[0] | (rec[1] << 8) | (rec[2] << 16) | ((uint32_t)rec[3] << 24);
+	*id = rec[4] | ((rec[5] & 0x07) << 8);
+	*dlc = rec[5] >> 3;
+	if (*dlc > 8) {
+		fprintf(stderr, "bad DLC %u, recording corrupt\n", *dlc);
+		return false;
+	}
+	return fread(data, 1, *dlc, in) == *dlc;
+}
+
+int main(int argc, char *argv[]) {
+	FILE *in;
+	clock_t start;
+	double seconds;
+	unsigned long frames = 0, gaps = 0, dropped = 0, gap;
+	unsigned long long total_us = 0;
+	uint32_t last_us = 0, ms, last_telemetry = 0;
+	uint8_t data[8], dlc;
+	uint16_t id;
+	uint32_t us;
+	int c;
+
+	if (argc < 2 || argc > 3) {
+		fprintf(stderr, "usage: %s <recording> [golden]\n", argv[0]);
+		return 2;
+	}
+	if (!(in = fopen(argv[1], "rb"))) {
+		perror(argv[1]);
+		return 2;
+	}
+	if (argc == 3 && !(_golden = fopen(argv[2], "r"))) {
+		perror(argv[2]);
+		return 2;
+	}
+
+	SignalStore_Init();
+	Fault_Init();
+	Warning_Init();
+	Telemetry_Init(print);
+
+	start = clock();
+	while ((c = fgetc(in)) != EOF) {
+		WARNING_SET_T warnings = 0;
+		FAULT_SET_T faults;
+
+		if (c != 0) {
+			if ((gap = read_text(in, c)) != 0) {
+				fprintf(stderr, "gap of %lu frames after frame %lu (%lu ms)\n", gap, frames,
+					(unsigned long)(total_us / 1000));
+				gaps++;
+				dropped += gap;
+			}
+			continue;
+		}
+		if (!read_frame(in, &id, data, &dlc, &us)) break;
+
+		// Timestamps wrap with the uint32_t microseconds, time keeps counting
+		total_us = frames ? total_us + (uint32_t)(us - last_us) : us;
+		last_us = us;
+		ms = (uint32_t)(total_us / 1000);
+		if (!frames) last_telemetry = ms;
+		frames++;
+
+		if (SignalStore_Receive(id, data, dlc, ms)) {
+			warnings = Warning_Receive(id);
+		}
+		Fault_Receive(id, data, dlc);
+		if (warnings) Telemetry_Warnings(warnings, ms);
+		if ((faults = Fault_TakeChanged()) != 0) Telemetry_Faults(faults, ms);
+		SignalStore_Update(ms);
+		if (ms - last_telemetry >= TELEMETRY_PERIOD_MS) {
+			last_telemetry = ms;
+			Telemetry_Signals(ms);
+		}
+	}
+	seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	fclose(in);
+
+	if (_golden) {
+		char extra[LINE_MAX];
+		if (fgets(extra, sizeof(extra), _golden)) {
+			if (!_differences) fprintf(stderr, "golden continues after line %lu: %s", _line_no, extra);
+			_differences++;
+		}
+		fclose(_golden);
+	}
+
+	fprintf(stderr, "%lu frames in %.3f s", frames, seconds);
+	if (seconds > 0) fprintf(stderr, ", %.0f frames/s", frames / seconds);
+	fprintf(stderr, "\n");
+	if (gaps) fprintf(stderr, "%lu gap%s, %lu frames dropped\n", gaps, gaps == 1 ? "" : "s", dropped);
+	if (_differences) fprintf(stderr, "%lu lines differ\n", _differences);
+	return _differences ? 1 : 0;
+}
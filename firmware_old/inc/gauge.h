@@ -0,0 +1,136 @@
+#ifndef __GAUGE_H_
+#define __GAUGE_H_
+
+#include "chip.h"
+#include "scale.h"
+
+//--------------------------------------------
+// Gauge manager for the VID29 dials. All gauges share a single step tick
+// and their coil outputs are written with one masked GPIO write per port,
+// so adding a dial adds table entries rather than loop iterations in main.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Configuration Macros
+
+#define GAUGE_MAX_GAUGES 5 						// Velocity, throttle, motor current, SOC, cell temp
+#define GAUGE_NUM_PORTS 4 						// GPIO ports 0-3
+#define GAUGE_STEP_PERIOD_MS 2 					// Shared step period of every gauge
+#define GAUGE_INPUT_PERIOD_MS 20 				// Period of the input filter stage
+#define GAUGE_HOME_STEP_PERIOD_MS 1 			// Step period while homing, fastest rate the VID29 still stalls cleanly at
+#define GAUGE_HOME_SWEEP 0 						// Homing sweep in steps, 0 sweeps a full rotation
+
+// -------------------------------------------------------------
+// Types
+
+/**
+ * Input stage applied to a gauge's target before the needle is moved
+ */
+typedef struct _GAUGE_FILTER_T_ {
+	uint8_t ema_shift; 							// Low-pass weight 1/2^ema_shift per sample, 0 disables
+	uint8_t deadband; 							// Ignore target changes of this many steps or fewer
+	uint8_t max_slew; 							// Max target change per input period in steps, 0 disables
+} GAUGE_FILTER_T;
+
+/**
+ * Static description of one gauge. Tables of these live in flash.
+ */
+typedef struct _GAUGE_CONFIG_T_ {
+	uint8_t ports[4]; 							// Coil GPIO ports
+	uint8_t pins[4]; 							// Coil GPIO pins
+	const uint16_t *source; 					// Signal the needle follows
+	SCALE_T scale; 								// Signal value to needle steps
+	GAUGE_FILTER_T filter;
+	int32_t step_per_rotation; 					// 640 for the VID29-02P
+} GAUGE_CONFIG_T;
+
+/**
+ * Step accounting of a gauge. steps / |net| is the churn factor,
+ * 1 means every step issued moved the needle toward where it ended up.
+ */
+typedef struct _GAUGE_STATS_T_ {
+	uint32_t steps; 							// Steps issued
+	uint32_t reversals; 						// Direction changes
+	int32_t start_pos; 							// Position when the stats were reset
+} GAUGE_STATS_T;
+
+typedef struct _GAUGE_T_ {
+	const GAUGE_CONFIG_T *config;
+	int32_t pos;
+	int32_t new_pos;
+	int32_t step_num; 							// Running step count, selects the coil phase
+	int32_t filtered; 							// Low-passed target, Q8 steps
+	int8_t dir; 								// Direction of the last step
+	bool zeroing;
+	GAUGE_STATS_T stats;
+} GAUGE_T;
+
+// -------------------------------------------------------------
+// Public Functions
+
+/**
+ * Initialize the gauge manager with a table of gauge descriptions
+ *
+ * @param configs pointer to the gauge table
+ * @param num_gauges number of entries in the table (at most GAUGE_MAX_GAUGES)
+ */
+void Gauge_Init(const GAUGE_CONFIG_T *configs, uint8_t num_gauges);
+
+/**
+ * Start homing every gauge in parallel against its end stop. The gauges step
+ * together at GAUGE_HOME_STEP_PERIOD_MS and their targets are held until
+ * the sweep completes.
+ *
+ * @param sweep steps to drive backwards, 0 for a full rotation. A shorter
+ *              sweep is enough when the needles are known to be parked low.
+ * @param msTicks current system time
+ */
+void Gauge_ZeroAll(int32_t sweep, uint32_t msTicks);
+
+/**
+ * @return true while a homing sweep is in progress
+ */
+bool Gauge_IsHoming(void);
+
+/**
+ * Run the input stage of every gauge: sample the bound signal, low-pass it,
+ * apply the deadband and slew limit, and retarget the needle. Call as often
+ * as desired, the stage only runs every GAUGE_INPUT_PERIOD_MS.
+ *
+ * @param msTicks current system time
+ */
+void Gauge_Update(uint32_t msTicks);
+
+/**
+ * Advance every moving gauge by one step and write out the coil phases,
+ * batched into one masked write per GPIO port. Call as often as desired,
+ * steps are only issued every GAUGE_STEP_PERIOD_MS.
+ *
+ * @param msTicks current system time
+ * @return true if any gauge is still moving
+ */
+bool Gauge_Tick(uint32_t msTicks);
+
+/**
+ * Get the current needle position of a gauge
+ *
+ * @param gauge index of the gauge in the table
+ * @return position in steps from the zero stop
+ */
+int32_t Gauge_GetPosition(uint8_t gauge);
+
+/**
+ * Get the step accounting of a gauge
+ *
+ * @param gauge index of the gauge in the table
+ * @param stats filled with the counters since the last reset
+ * @return net displacement in steps since the last reset
+ */
+int32_t Gauge_GetStats(uint8_t gauge, GAUGE_STATS_T *stats);
+
+/**
+ * Restart the step accounting of every gauge
+ */
+void Gauge_ResetStats(void);
+
+#endif
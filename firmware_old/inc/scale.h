@@ -0,0 +1,74 @@
+#ifndef __SCALE_H_
+#define __SCALE_H_
+
+#include <stdint.h>
+
+//--------------------------------------------
+// Fixed-point signal scaling. Every scale is a ratio num/den that is folded
+// by the compiler into a Q(shift) multiplier, so applying it at runtime is
+// one 32-bit multiply, a shift and a clamp. No division is ever executed.
+//
+// Inputs are 16-bit CAN fields. SCALE_INIT refuses to compile any scale whose
+// multiplier could overflow a 32-bit product for a 16-bit input.
+//--------------------------------------------
+
+// -------------------------------------------------------------
+// Computed Macros
+
+/**
+ * Q(shift) multiplier for num/den, rounded to nearest. Constant expression.
+ */
+#define SCALE_Q(num, den, shift) \
+	((int32_t)((((int64_t)(num) * (1LL << (shift))) + ((num) < 0 ? -((den) / 2) : ((den) / 2))) / (den)))
+
+/**
+ * Zero if raw * mult plus the rounding term fits in 32 bits for every 16-bit input,
+ * compile error otherwise
+ */
+#define SCALE_CHECK(mult, shift) \
+	((int32_t)(0 * sizeof(char[(((mult) < 0 ? -(int64_t)(mult) : (int64_t)(mult)) * UINT16_MAX + (1 << (shift)) <= INT32_MAX) ? 1 : -1])))
+
+/**
+ * Initializer for a SCALE_T computing out = raw * num / den + offset, clamped to [min, max]
+ *
+ * @param shift fraction bits of the multiplier, pick the largest that SCALE_CHECK accepts
+ */
+#define SCALE_INIT(num, den, shift, offset, min, max) \
+	{ SCALE_Q(num, den, shift) + SCALE_CHECK(SCALE_Q(num, den, shift), shift), (shift), (offset), (min), (max) }
+
+// -------------------------------------------------------------
+// Signal Scales
+
+// Motor RPM to mph: rpm * 60 * (22in wheel * 22/7) / (12 * 5280)
+#define SCALE_RPM_TO_MPH 		SCALE_INIT(60 * 22 * 22, 7 * 12 * 5280, 18, 0, 0, UINT16_MAX)
+
+// Speed (mph) to needle steps, 110 mph at full deflection
+#define SCALE_MPH_TO_STEPS 		SCALE_INIT(640, 110, 12, 0, 0, 640)
+
+// Raw throttle to needle steps, 6535 at full deflection
+#define SCALE_THROTTLE_TO_STEPS SCALE_INIT(640, 6535, 18, 0, 0, 640)
+
+// -------------------------------------------------------------
+// Types
+
+typedef struct _SCALE_T_ {
+	int32_t mult; 								// Q(shift) multiplier
+	uint8_t shift;
+	int32_t offset; 							// Added after scaling, output units
+	int32_t min; 								// Output saturation limits
+	int32_t max;
+} SCALE_T;
+
+// -------------------------------------------------------------
+// Public Functions
+
+/**
+ * Scale a raw 16-bit value
+ *
+ * @param scale scale built with SCALE_INIT
+ * @param raw raw value
+ * @return raw * num / den + offset, rounded to nearest and saturated to [min, max]
+ */
+int32_t Scale_Apply(const SCALE_T *scale, uint16_t raw);
+
+#endif
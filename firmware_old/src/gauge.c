@@ -0,0 +1,183 @@
+#include "chip.h"
+#include "gauge.h"
+
+// Coil states for each of the four phases, bit n drives coil n.
+// Same sequence as Stepper_StepCases.
+static const uint8_t PHASES[4] = {0x9, 0xA, 0x6, 0x5};
+
+static GAUGE_T _gauges[GAUGE_MAX_GAUGES];
+static uint8_t _num_gauges;
+
+static uint32_t _port_mask[GAUGE_NUM_PORTS]; 	// Pins owned by gauges on each port
+static uint32_t _last_tick;
+static uint32_t _last_input;
+static bool _homing;
+static bool _moving; 							// Some gauge is short of its target
+
+void Gauge_Init(const GAUGE_CONFIG_T *configs, uint8_t num_gauges) {
+	uint8_t i, c;
+
+	if (num_gauges > GAUGE_MAX_GAUGES) num_gauges = GAUGE_MAX_GAUGES;
+	_num_gauges = num_gauges;
+
+	for (i = 0; i < GAUGE_NUM_PORTS; i++) {
+		_port_mask[i] = 0;
+	}
+
+	for (i = 0; i < _num_gauges; i++) {
+		GAUGE_T *g = &_gauges[i];
+		g->config = &configs[i];
+		g->pos = 0;
+		g->new_pos = 0;
+		g->step_num = 0;
+		g->filtered = 0;
+		g->dir = 0;
+		g->zeroing = false;
+
+		for (c = 0; c < 4; c++) {
+			Chip_GPIO_WriteDirBit(LPC_GPIO, g->config->ports[c], g->config->pins[c], true);
+			_port_mask[g->config->ports[c]] |= 1 << g->config->pins[c];
+		}
+	}
+
+	_last_tick = 0;
+	_last_input = 0;
+	_homing = false;
+	_moving = false;
+	Gauge_ResetStats();
+}
+
+void Gauge_ZeroAll(int32_t sweep, uint32_t msTicks) {
+	uint8_t i;
+	for (i = 0; i < _num_gauges; i++) {
+		GAUGE_T *g = &_gauges[i];
+		g->new_pos = g->pos - (sweep ? sweep : g->config->step_per_rotation);
+		g->zeroing = true;
+		g->filtered = 0;
+	}
+	_homing = _num_gauges > 0;
+	_moving = _homing;
+	_last_tick = msTicks;
+}
+
+bool Gauge_IsHoming(void) {
+	return _homing;
+}
+
+void Gauge_Update(uint32_t msTicks) {
+	uint8_t i;
+
+	if (msTicks - _last_input < GAUGE_INPUT_PERIOD_MS) return;
+	_last_input = msTicks;
+
+	for (i = 0; i < _num_gauges; i++) {
+		GAUGE_T *g = &_gauges[i];
+		const GAUGE_FILTER_T *f = &g->config->filter;
+
+		if (g->zeroing) continue;
+
+		int32_t sample = Scale_Apply(&g->config->scale, *g->config->source) << 8;
+		if (f->ema_shift) {
+			g->filtered += (sample - g->filtered) >> f->ema_shift;
+		} else {
+			g->filtered = sample;
+		}
+
+		int32_t target = (g->filtered + 0x80) >> 8;
+		int32_t delta = target - g->new_pos;
+
+		// Hysteresis: small wobble around the current target does not retarget
+		if (delta <= f->deadband && delta >= -f->deadband) continue;
+
+		if (f->max_slew) {
+			if (delta > f->max_slew) delta = f->max_slew;
+			if (delta < -f->max_slew) delta = -f->max_slew;
+		}
+
+		target = g->new_pos + delta;
+		if (target > g->config->step_per_rotation) target = g->config->step_per_rotation;
+		if (target < 0) target = 0;
+		g->new_pos = target;
+		_moving |= g->new_pos != g->pos;
+	}
+}
+
+bool Gauge_Tick(uint32_t msTicks) {
+	uint32_t port_val[GAUGE_NUM_PORTS] = {0, 0, 0, 0};
+	bool stepped = false;
+	uint8_t i, c;
+
+	uint32_t period = _homing ? GAUGE_HOME_STEP_PERIOD_MS : GAUGE_STEP_PERIOD_MS;
+
+	if (msTicks - _last_tick < period) return _moving;
+	_last_tick = msTicks;
+	_homing = false;
+	_moving = false;
+
+	for (i = 0; i < _num_gauges; i++) {
+		GAUGE_T *g = &_gauges[i];
+		if (g->new_pos == g->pos) continue;
+
+		int8_t dir = (g->new_pos > g->pos) ? 1 : -1;
+		g->pos += dir;
+		g->step_num += dir;
+
+		// The homing sweep is not churn, stats start from the zeroed dial
+		if (!g->zeroing) {
+			g->stats.steps++;
+			if (dir != g->dir && g->dir != 0) g->stats.reversals++;
+		}
+		g->dir = dir;
+
+		if (g->zeroing && g->pos <= g->new_pos) {
+			g->zeroing = false;
+			g->pos = 0;
+			g->new_pos = 0;
+			g->dir = 0;
+			g->stats.start_pos = 0;
+		}
+		_homing |= g->zeroing;
+		_moving |= g->new_pos != g->pos;
+		stepped = true;
+	}
+
+	if (!stepped) return false;
+
+	// Gauges that did not move re-write their current phase, which keeps
+	// this a single pass with no per-pin read-modify-write
+	for (i = 0; i < _num_gauges; i++) {
+		const GAUGE_CONFIG_T *cfg = _gauges[i].config;
+		uint8_t phase = PHASES[_gauges[i].step_num & 0x3];
+		for (c = 0; c < 4; c++) {
+			if (phase & (1 << c)) {
+				port_val[cfg->ports[c]] |= 1 << cfg->pins[c];
+			}
+		}
+	}
+
+	for (i = 0; i < GAUGE_NUM_PORTS; i++) {
+		if (_port_mask[i]) {
+			LPC_GPIO[i].DATA[_port_mask[i]] = port_val[i];
+		}
+	}
+
+	return _moving;
+}
+
+int32_t Gauge_GetPosition(uint8_t gauge) {
+	return _gauges[gauge].pos;
+}
+
+int32_t Gauge_GetStats(uint8_t gauge, GAUGE_STATS_T *stats) {
+	*stats = _gauges[gauge].stats;
+	return _gauges[gauge].pos - stats->start_pos;
+}
+
+void Gauge_ResetStats(void) {
+	uint8_t i;
+	for (i = 0; i < _num_gauges; i++) {
+		_gauges[i].stats.steps = 0;
+		_gauges[i].stats.reversals = 0;
+		_gauges[i].stats.start_pos = _gauges[i].pos;
+	}
+}
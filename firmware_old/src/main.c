@@ -1,5 +1,5 @@
 #include "board.h"
-#include "stepperMotor.h"
+#include "gauge.h"
 
 // -------------------------------------------------------------
 // Macro Definitions
@@ -24,6 +24,21 @@ static uint8_t uart_rx_buffer[BUFFER_SIZE]; 	// UART received message buffer
 static bool can_error_flag;
 static uint32_t can_error_info;
 
+static uint16_t vel1; 							// Motor speed from 0x703 (rpm)
+static uint16_t vel2; 							// Motor speed from 0x704 (rpm)
+static uint16_t velocity; 						// Average speed (mph)
+static uint16_t throttle; 						// Raw throttle from 0x301
+
+static const SCALE_T rpm_to_mph = SCALE_RPM_TO_MPH;
+
+static const GAUGE_CONFIG_T gauge_table[] = {
+	// ports        pins            source      scale                      ema, deadband, slew  steps
+	{{2, 3, 2, 2}, {2, 0, 7, 8}, 	&velocity, 	SCALE_MPH_TO_STEPS, 		{3, 2, 16}, 		640},
+	{{2, 1, 3, 1}, {11, 5, 2, 10}, 	&throttle, 	SCALE_THROTTLE_TO_STEPS, 	{2, 1, 32}, 		640},
+};
+
+#define NUM_GAUGES (sizeof(gauge_table) / sizeof(gauge_table[0]))
+
 // -------------------------------------------------------------
 // Helper Functions
 
@@ -36,6 +51,25 @@ void _delay(uint32_t ms) {
 	while ((msTicks - curTicks) < ms);
 }
 
+/**
+ * Print the step accounting of every gauge as "gauge,steps,reversals,net"
+ */
+static void print_gauge_stats(void) {
+	GAUGE_STATS_T stats;
+	uint8_t i;
+
+	for (i = 0; i < NUM_GAUGES; i++) {
+		int32_t net = Gauge_GetStats(i, &stats);
+		Board_UART_PrintNum(i, 10, false);
+		Board_UART_Print(",");
+		Board_UART_PrintNum(stats.steps, 10, false);
+		Board_UART_Print(",");
+		Board_UART_PrintNum(stats.reversals, 10, false);
+		Board_UART_Print(",");
+		Board_UART_PrintNum(net < 0 ? -net : net, 10, true);
+	}
+}
+
 // -------------------------------------------------------------
 // CAN Driver Callback Functions
 
@@ -157,62 +191,30 @@ int main(void)
 
 	Board_UART_Print("Initializing\r\n");
 	
-	STEPPER_MOTOR_T vgauge;
-	vgauge.ports[0] = 2;
-	vgauge.ports[1] = 3;
-	vgauge.ports[2] = 2;
-	vgauge.ports[3] = 2;
-	vgauge.pins[0] = 2;
-	vgauge.pins[1] = 0;
-	vgauge.pins[2] = 7;
-	vgauge.pins[3] = 8;
-	vgauge.step_per_rotation = 640;
-	vgauge.step_delay = 2;
-	Stepper_Init(&vgauge);
-	Stepper_ZeroPosition(&vgauge, msTicks);	
-
 	Chip_IOCON_PinMuxSet(LPC_IOCON, IOCON_PIO1_10, IOCON_DIGMODE_EN);
-	STEPPER_MOTOR_T tgauge;
-	tgauge.ports[0] = 2;
-	tgauge.ports[1] = 1;
-	tgauge.ports[2] = 3;
-	tgauge.ports[3] = 1;
-	tgauge.pins[0] = 11;
-	tgauge.pins[1] = 5;
-	tgauge.pins[2] = 2;
-	tgauge.pins[3] = 10;
-	tgauge.step_per_rotation = 640;
-	tgauge.step_delay = 2;
-	Stepper_Init(&tgauge);
-	Stepper_ZeroPosition(&tgauge, msTicks);
-	
-	Stepper_Step(&vgauge, msTicks);
-	Stepper_Step(&tgauge, msTicks);
+	Gauge_Init(gauge_table, NUM_GAUGES);
+	Gauge_ZeroAll(GAUGE_HOME_SWEEP, msTicks);
+
+	bool homed = false; 						// Homing sweep finished
+	bool have_reading = false; 					// A gauge signal has been received
+	bool reported = false; 						// Time to first valid reading printed
 
-	int vel1 = 0;
-	int vel2 = 0;
 	while (1) {
 		if (!RingBuffer_IsEmpty(&can_rx_buffer)) {
 			CCAN_MSG_OBJ_T temp_msg;
 			RingBuffer_Pop(&can_rx_buffer, &temp_msg);
 			
-			if (temp_msg.mode_id==0x703){
-				vel1 = (temp_msg.data_16[0]*60*22*22)/(7*12*5280);
-			}
-			if (temp_msg.mode_id==0x704) {
-				vel2 = (temp_msg.data_16[0]*60*22*22)/(7*12*5280);
-			}
-			vel = (vel1+vel2)/2			
-			int vpospercent = vel*100/110;
-			Stepper_SetPosition(&vgauge, vpospercent, msTicks); 
-			
-			if (temp_msg.mode_id==0x301){
-				int throt = temp_msg.data_16[0];
-				int tpospercent = throt*640/6535;
-				Stepper_SetPosition(&tgauge, tpospercent, msTicks);	
+			if (temp_msg.mode_id == 0x703) {
+				vel1 = temp_msg.data_16[0];
+				velocity = Scale_Apply(&rpm_to_mph, (vel1 + vel2) >> 1);
+			} else if (temp_msg.mode_id == 0x704) {
+				vel2 = temp_msg.data_16[0];
+				velocity = Scale_Apply(&rpm_to_mph, (vel1 + vel2) >> 1);
+			} else if (temp_msg.mode_id == 0x301) {
+				throttle = temp_msg.data_16[0];
 			}
-
-		}	
+			have_reading |= (temp_msg.mode_id == 0x703 || temp_msg.mode_id == 0x704 || temp_msg.mode_id == 0x301);
+		}
 
 		if (can_error_flag) {
 			can_error_flag = false;
@@ -221,10 +223,35 @@ int main(void)
 			Board_UART_Println(str);
 		}
 
-		Stepper_Step(&vgauge, msTicks);
-		
-		Stepper_Step(&tgauge, msTicks);
-		
-	
+		if (Board_UART_Read(uart_rx_buffer, BUFFER_SIZE) != 0) {
+			switch (uart_rx_buffer[0]) {
+				case 'g':
+					print_gauge_stats();
+					break;
+				case 'r':
+					Gauge_ResetStats();
+					break;
+				default:
+					break;
+			}
 		}
-}	
+
+		Gauge_Update(msTicks);
+		Gauge_Tick(msTicks);
+
+		if (!homed && !Gauge_IsHoming()) {
+			homed = true;
+			Board_UART_Print("Gauges homed: ");
+			Board_UART_PrintNum(msTicks, 10, false);
+			Board_UART_Println(" ms");
+		}
+
+		// Boot to the first moment a needle can show live data
+		if (homed && have_reading && !reported) {
+			reported = true;
+			Board_UART_Print("First reading: ");
+			Board_UART_PrintNum(msTicks, 10, false);
+			Board_UART_Println(" ms");
+		}
+	}
+}
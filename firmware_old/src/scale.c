@@ -0,0 +1,15 @@
+#include "scale.h"
+
+int32_t Scale_Apply(const SCALE_T *scale, uint16_t raw) {
+	int32_t out = (int32_t)raw * scale->mult;
+
+	// Round to nearest before dropping the fraction bits
+	if (scale->shift) {
+		out = (out + (1 << (scale->shift - 1))) >> scale->shift;
+	}
+	out += scale->offset;
+
+	if (out > scale->max) return scale->max;
+	if (out < scale->min) return scale->min;
+	return out;
+}
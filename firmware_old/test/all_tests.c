@@ -2,6 +2,7 @@
 
 static void RunAllTests(void) {
   RUN_TEST_GROUP(Util_Test);
+  RUN_TEST_GROUP(Scale_Test);
 }
 
 int main(int argc, char * argv[]) {
@@ -0,0 +1,83 @@
+#include "scale.h"
+#include "unity.h"
+#include "unity_fixture.h"
+
+TEST_GROUP(Scale_Test);
+
+TEST_SETUP(Scale_Test) {
+
+}
+
+TEST_TEAR_DOWN(Scale_Test) {
+
+}
+
+/**
+ * Largest absolute difference between Scale_Apply and a double precision
+ * reference over every 16-bit input
+ */
+static double max_error(const SCALE_T *scale, double num, double den, double offset) {
+	double worst = 0;
+	uint32_t raw;
+
+	for (raw = 0; raw <= UINT16_MAX; raw++) {
+		double ref = raw * num / den + offset;
+		if (ref > scale->max) ref = scale->max;
+		if (ref < scale->min) ref = scale->min;
+
+		double err = Scale_Apply(scale, raw) - ref;
+		if (err < 0) err = -err;
+		if (err > worst) worst = err;
+	}
+
+	return worst;
+}
+
+TEST(Scale_Test, test_rpm_to_mph) {
+	const SCALE_T scale = SCALE_RPM_TO_MPH;
+
+	TEST_ASSERT_TRUE(max_error(&scale, 60 * 22 * 22, 7 * 12 * 5280, 0) <= 1.0);
+	// Old formula at a low and a mid-range speed
+	TEST_ASSERT_EQUAL_INT((1000*60*22*22)/(7*12*5280), Scale_Apply(&scale, 1000));
+	TEST_ASSERT_INT_WITHIN(1, (30000*60*22*22)/(7*12*5280), Scale_Apply(&scale, 30000));
+}
+
+TEST(Scale_Test, test_mph_to_steps) {
+	const SCALE_T scale = SCALE_MPH_TO_STEPS;
+
+	TEST_ASSERT_TRUE(max_error(&scale, 640, 110, 0) <= 1.0);
+	TEST_ASSERT_EQUAL_INT(0, Scale_Apply(&scale, 0));
+	TEST_ASSERT_EQUAL_INT(640, Scale_Apply(&scale, 110));
+}
+
+TEST(Scale_Test, test_throttle_to_steps) {
+	const SCALE_T scale = SCALE_THROTTLE_TO_STEPS;
+
+	TEST_ASSERT_TRUE(max_error(&scale, 640, 6535, 0) <= 1.0);
+	TEST_ASSERT_EQUAL_INT(640, Scale_Apply(&scale, 6535));
+}
+
+TEST(Scale_Test, test_offset_and_saturation) {
+	// Temperature style signal: 0.5 degC per bit, -40 degC offset, clamped to [-20, 100]
+	const SCALE_T scale = SCALE_INIT(1, 2, 15, -40, -20, 100);
+
+	TEST_ASSERT_TRUE(max_error(&scale, 1, 2, -40) <= 1.0);
+	TEST_ASSERT_EQUAL_INT(-20, Scale_Apply(&scale, 0));
+	TEST_ASSERT_EQUAL_INT(10, Scale_Apply(&scale, 100));
+	TEST_ASSERT_EQUAL_INT(100, Scale_Apply(&scale, UINT16_MAX));
+}
+
+TEST(Scale_Test, test_negative_gain) {
+	const SCALE_T scale = SCALE_INIT(-3, 10, 16, 1000, -30000, 30000);
+
+	TEST_ASSERT_TRUE(max_error(&scale, -3, 10, 1000) <= 1.0);
+	TEST_ASSERT_EQUAL_INT(700, Scale_Apply(&scale, 1000));
+}
+
+TEST_GROUP_RUNNER(Scale_Test) {
+	RUN_TEST_CASE(Scale_Test, test_rpm_to_mph);
+	RUN_TEST_CASE(Scale_Test, test_mph_to_steps);
+	RUN_TEST_CASE(Scale_Test, test_throttle_to_steps);
+	RUN_TEST_CASE(Scale_Test, test_offset_and_saturation);
+	RUN_TEST_CASE(Scale_Test, test_negative_gain);
+}